@@ -4,14 +4,20 @@
  * 
  * @section features_sec Características Principales
  * - Registro de componentes con validación de entrada
- * - Almacenamiento persistente en archivos de texto
+ * - Almacenamiento persistente en archivos de texto o en formato binario columnar
  * - Búsqueda multicriterio
+ * - Borrado y modificación de componentes con lápidas y compactación automática
  * - Interfaz de menú intuitiva
  * 
  * @section usage_sec Modo de Uso
  * 1. Ejecutar el programa
  * 2. Seleccionar opciones del menú
  * 3. Los datos se guardan en archivos .txt
+ * 4. Los archivos grandes pueden convertirse a formato binario (opción 6) para cargarlos más rápido
+ * 5. Opciones no interactivas: ejecutar con --ayuda para ver la lista
+ * 
+ * Compilación: g++ -std=c++17 -O2 -pthread registroDeComponentes.cpp -o registroDeComponentes
+ * (añadir -march=native para que los filtros numéricos usen AVX2 cuando el procesador lo admita)
  * 
  * @author Sergio Felipe Gonzalez Cruz
  * @date Febrero 2025
@@ -25,6 +31,48 @@
 #include<limits>
 #include<cctype>
 #include<algorithm>
+#include<cstdint>
+#include<cstring>
+#include<string_view>
+#include<charconv>
+#include<iterator>
+#include<chrono>
+#include<cstdio>
+#include<thread>
+#include<map>
+#include<unordered_map>
+#include<filesystem>
+#include<cmath>
+#include<type_traits>
+#include<memory_resource>
+#include<atomic>
+#include<cstdlib>
+#include<new>
+#include<sstream>
+#include<cerrno>
+#include<optional>
+#include<mutex>
+#include<csignal>
+#include<ctime>
+
+#if defined(__SSE2__)
+#include<emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include<immintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SISTEMA_POSIX 1
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<sys/file.h>
+#include<sys/socket.h>
+#include<sys/un.h>
+#include<poll.h>
+#include<unistd.h>
+#endif
 
 /**
  * @struct componente
@@ -47,6 +95,216 @@ struct componente
     std::string estado; ///< Ej: "Nuevo", "Usado", "Dañado"
 };
 
+/**
+ * @brief Indica si se recogen estadísticas de las operaciones (--stats o la opción 8 del menú)
+ * 
+ * Con el indicador apagado, cada cronometroDeEtapa y cada contarEstadistica()
+ * se reduce a leer este bool; no se consulta ningún reloj ni se toca ningún
+ * contador atómico.
+ */
+bool estadisticasActivas = false;
+
+/**
+ * @brief Indica si compararAsignaciones() está midiendo
+ * 
+ * El operator new/delete global solo cuenta las reservas con este indicador o
+ * con estadisticasActivas encendido; en otro caso no toca ningún atómico.
+ */
+bool midiendoReservas = false;
+
+extern std::atomic<uint64_t> reservasDinamicas; ///< Definido junto al operator new global
+
+/**
+ * @enum etapaMedida
+ * @brief Etapas en las que se reparte el tiempo de una operación
+ * 
+ * - lectura: abrir y mapear o leer el archivo
+ * - interpretacion: convertir el texto o el binario en registros
+ * - filtrado: evaluar criterios y consultas sobre los registros
+ * - presentacion: formatear y escribir los resultados
+ * - escritura: guardar registros en disco
+ */
+enum class etapaMedida { lectura, interpretacion, filtrado, presentacion, escritura, cantidad };
+
+/**
+ * @enum contadorMedido
+ * @brief Contadores que acompañan a los tiempos de cada operación
+ */
+enum class contadorMedido { bytesLeidos, registrosInterpretados, registrosRecorridos, registrosCoincidentes, bytesEscritos, cantidad };
+
+/**
+ * @struct estadisticasDeOperacion
+ * @brief Acumuladores de tiempos y contadores de la operación en curso
+ * 
+ * Los acumuladores son atómicos relajados porque consultarParticionado() y
+ * cargarDesdeArchivoParalelo() cronometran también desde sus hilos; con
+ * varios hilos la suma de las etapas puede superar el tiempo total.
+ */
+struct estadisticasDeOperacion
+{
+    std::atomic<uint64_t> nanosegundos[static_cast<size_t>(etapaMedida::cantidad)]{};
+    std::atomic<uint64_t> llamadas[static_cast<size_t>(etapaMedida::cantidad)]{};
+    std::atomic<uint64_t> contadores[static_cast<size_t>(contadorMedido::cantidad)]{};
+    std::chrono::steady_clock::time_point inicio; ///< Comienzo de la operación
+    double segundosDeCpuAlInicio{0}; ///< Tiempo de CPU del proceso al comenzar
+    uint64_t reservasAlInicio{0}; ///< reservasDinamicas al comenzar
+};
+
+estadisticasDeOperacion estadisticas; ///< Única instancia; la reinicia iniciarEstadisticas()
+
+/**
+ * @brief Suma @p cantidad al contador indicado si las estadísticas están activas
+ * 
+ * Los bucles calientes acumulan en una variable local y llaman una sola vez
+ * al terminar, para no pagar un incremento atómico por registro.
+ */
+inline void contarEstadistica(contadorMedido contador, uint64_t cantidad){
+    if (estadisticasActivas) estadisticas.contadores[static_cast<size_t>(contador)].fetch_add(cantidad, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Tiempo de CPU consumido por todo el proceso (todos los hilos), en segundos
+ */
+double segundosDeCpuDelProceso(){
+#if defined(SISTEMA_POSIX)
+    timespec momento{};
+    ::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &momento);
+    return static_cast<double>(momento.tv_sec) + static_cast<double>(momento.tv_nsec) / 1e9;
+#else
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * @class cronometroDeEtapa
+ * @brief Cronómetro RAII que atribuye el tiempo de su ámbito a una etapa
+ * 
+ * @details
+ * Los tiempos son exclusivos: mientras un cronómetro anidado está vivo (por
+ * ejemplo el de presentación dentro del de filtrado), el exterior se detiene,
+ * así que en cada hilo las etapas no se cuentan dos veces. Cada cronómetro
+ * recuerda el tramo que estaba en marcha en su hilo y lo reanuda al destruirse.
+ * 
+ * Solo usa std::chrono::steady_clock (una lectura por transición); el tiempo
+ * de CPU se mide para la operación completa en mostrarEstadisticas(), porque
+ * el reloj de CPU por hilo es una llamada al sistema y encarecería los
+ * cronómetros de grano fino.
+ * 
+ * @par Ejemplo de uso:
+ * @code
+ * cronometroDeEtapa cronometro(etapaMedida::filtrado);
+ * // ... el tiempo hasta el final del ámbito cuenta como filtrado
+ * @endcode
+ */
+class cronometroDeEtapa
+{
+public:
+    explicit cronometroDeEtapa(etapaMedida etapa) : activo(estadisticasActivas) {
+        if (!activo) return;
+        const auto ahora = std::chrono::steady_clock::now();
+        anterior = enCurso;
+        if (anterior.activa) acumular(anterior.etapa, anterior.desde, ahora);
+        enCurso = {etapa, ahora, true};
+    }
+    ~cronometroDeEtapa() {
+        if (!activo) return;
+        const auto ahora = std::chrono::steady_clock::now();
+        acumular(enCurso.etapa, enCurso.desde, ahora);
+        estadisticas.llamadas[static_cast<size_t>(enCurso.etapa)].fetch_add(1, std::memory_order_relaxed);
+        enCurso = {anterior.etapa, ahora, anterior.activa};
+    }
+    cronometroDeEtapa(const cronometroDeEtapa&) = delete;
+    cronometroDeEtapa& operator=(const cronometroDeEtapa&) = delete;
+
+private:
+    /**
+     * @struct tramo
+     * @brief Etapa que se está cronometrando en un hilo y desde cuándo
+     */
+    struct tramo
+    {
+        etapaMedida etapa{etapaMedida::lectura};
+        std::chrono::steady_clock::time_point desde;
+        bool activa{false};
+    };
+
+    static void acumular(etapaMedida etapa, std::chrono::steady_clock::time_point desde, std::chrono::steady_clock::time_point hasta) {
+        const auto transcurrido = std::chrono::duration_cast<std::chrono::nanoseconds>(hasta - desde).count();
+        estadisticas.nanosegundos[static_cast<size_t>(etapa)].fetch_add(static_cast<uint64_t>(transcurrido), std::memory_order_relaxed);
+    }
+
+    bool activo; ///< Copia del indicador al construirse, para no desequilibrar la pila si cambia
+    tramo anterior; ///< Tramo del cronómetro exterior, que se reanuda al destruir este
+    static thread_local tramo enCurso; ///< Tramo en marcha en este hilo
+};
+
+thread_local cronometroDeEtapa::tramo cronometroDeEtapa::enCurso;
+
+/**
+ * @brief Pone a cero los acumuladores y marca el comienzo de una operación
+ */
+void iniciarEstadisticas(){
+    for (auto& valor : estadisticas.nanosegundos) valor.store(0, std::memory_order_relaxed);
+    for (auto& valor : estadisticas.llamadas) valor.store(0, std::memory_order_relaxed);
+    for (auto& valor : estadisticas.contadores) valor.store(0, std::memory_order_relaxed);
+    estadisticas.inicio = std::chrono::steady_clock::now();
+    estadisticas.segundosDeCpuAlInicio = segundosDeCpuDelProceso();
+    estadisticas.reservasAlInicio = reservasDinamicas.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Muestra los tiempos y contadores de la operación iniciada con iniciarEstadisticas()
+ * 
+ * @param salida Flujo de destino (std::cerr, para no mezclarse con los resultados)
+ * @param operacion Nombre de la operación que encabeza el informe
+ * 
+ * @details
+ * El informe indica el tiempo real y de CPU de toda la operación, el tiempo
+ * exclusivo y las llamadas de cada etapa, los bytes leídos y escritos, los
+ * registros interpretados, recorridos por los filtros y coincidentes, y las
+ * reservas de memoria dinámica. El resto hasta el total es lo que no
+ * pertenece a ninguna etapa (esperas del menú, bloqueos, etc.). Los bytes
+ * leídos cuentan cada proyección o lectura por separado, así que un archivo
+ * que se abre dos veces en la misma operación cuenta dos veces.
+ * 
+ * @par Ejemplo de salida:
+ * @code{.sh}
+ * [estadísticas] --consultar: 554.127 ms reales, 545.310 ms de CPU, 315340 reservas
+ *   lectura           0.041 ms  2 llamadas
+ *   interpretacion    515.262 ms  4 llamadas
+ *   filtrado          2.307 ms  1 llamadas
+ *   presentacion      4.118 ms  3207 llamadas
+ *   escritura         0.000 ms  0 llamadas
+ *   bytes leídos 92259382, escritos 0; registros interpretados 1000000, recorridos 1000000, coincidentes 3205
+ * @endcode
+ */
+void mostrarEstadisticas(std::ostream& salida, const std::string& operacion){
+    static const char* nombres[] = {"lectura", "interpretacion", "filtrado", "presentacion", "escritura"};
+    auto contador = [](contadorMedido c) { return estadisticas.contadores[static_cast<size_t>(c)].load(std::memory_order_relaxed); };
+    const double milisegundos = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - estadisticas.inicio).count();
+    const double milisegundosDeCpu = (segundosDeCpuDelProceso() - estadisticas.segundosDeCpuAlInicio) * 1e3;
+    const uint64_t reservas = reservasDinamicas.load(std::memory_order_relaxed) - estadisticas.reservasAlInicio;
+
+    std::ostringstream informe;
+    informe.setf(std::ios::fixed);
+    informe.precision(3);
+    informe << "[estadísticas] " << operacion << ": " << milisegundos << " ms reales, " << milisegundosDeCpu << " ms de CPU, "
+            << reservas << " reservas\n";
+    for (size_t i = 0; i < static_cast<size_t>(etapaMedida::cantidad); ++i) {
+        std::string nombre = nombres[i];
+        nombre.resize(18, ' ');
+        informe << "  " << nombre << estadisticas.nanosegundos[i].load(std::memory_order_relaxed) / 1e6 << " ms  "
+                << estadisticas.llamadas[i].load(std::memory_order_relaxed) << " llamadas\n";
+    }
+    informe << "  bytes leídos " << contador(contadorMedido::bytesLeidos)
+            << ", escritos " << contador(contadorMedido::bytesEscritos)
+            << "; registros interpretados " << contador(contadorMedido::registrosInterpretados)
+            << ", recorridos " << contador(contadorMedido::registrosRecorridos)
+            << ", coincidentes " << contador(contadorMedido::registrosCoincidentes) << "\n";
+    salida << informe.str();
+    salida.flush();
+}
+
 /**
  * @brief Solicita y valida la entrada de un número decimal al usuario
  * 
@@ -100,6 +358,38 @@ float solicitarNumero(const std::string& mensaje) {
     }
 }
 
+/**
+ * @brief Normaliza y valida un texto con las reglas de los campos de texto de componente
+ * 
+ * @param entrada Texto a validar; se le quitan los espacios y tabuladores
+ *                del inicio y del final
+ * @param permitirNumeros Si es false, rechaza los textos que contienen dígitos
+ * @return const char* nullptr si el texto es válido; en otro caso, el motivo
+ * 
+ * @details
+ * Es la regla que aplica solicitarTexto() en el modo interactivo y
+ * importarComponentes() en la importación masiva, de modo que ambos aceptan
+ * exactamente los mismos valores.
+ */
+const char* validarTexto(std::string& entrada, bool permitirNumeros = true){
+    // Eliminar espacios en blanco al inicio/final
+    entrada.erase(0, entrada.find_first_not_of(" \t"));
+    entrada.erase(entrada.find_last_not_of(" \t") + 1);
+
+    if (entrada.empty()) {
+        return "No puede estar vacío.";
+    }
+
+    if (!permitirNumeros) {
+        for (char c : entrada) {
+            if (isdigit(c)) {
+                return "No se permiten números en este campo.";
+            }
+        }
+    }
+    return nullptr;
+}
+
 /**
  * @brief Solicita y valida una cadena de texto al usuario con opciones de filtrado
  * 
@@ -114,7 +404,7 @@ float solicitarNumero(const std::string& mensaje) {
  * 3. Opcionalmente verifica que no contenga dígitos numéricos
  * 4. Mantiene un bucle hasta recibir una entrada válida
  * 
- * El proceso de validación incluye:
+ * El proceso de validación (ver validarTexto()) incluye:
  * - Trim de espacios con find_first_not_of() y find_last_not_of()
  * - Verificación de cadena vacía
  * - Búsqueda de dígitos con isdigit() cuando !permitirNumeros
@@ -148,29 +438,12 @@ std::string solicitarTexto(const std::string& mensaje, bool permitirNumeros = tr
         std::cout << mensaje;
         std::getline(std::cin, entrada);
 
-        // Eliminar espacios en blanco al inicio/final
-        entrada.erase(0, entrada.find_first_not_of(" \t"));
-        entrada.erase(entrada.find_last_not_of(" \t") + 1);
-
-        if (entrada.empty()) {
-            std::cout << "Error: No puede estar vacío.\n";
+        const char* error = validarTexto(entrada, permitirNumeros);
+        if (error != nullptr) {
+            std::cout << "Error: " << error << "\n";
             continue;
         }
 
-        if (!permitirNumeros) {
-            bool esValido = true;
-            for (char c : entrada) {
-                if (isdigit(c)) {
-                    esValido = false;
-                    break;
-                }
-            }
-            if (!esValido) {
-                std::cout << "Error: No se permiten números en este campo.\n";
-                continue;
-            }
-        }
-
         return entrada;
     }
 }
@@ -231,1020 +504,9552 @@ void registroDeComponentes(std::vector<componente>&registros){
 }
 
 /**
- * @brief Guarda un componente en un archivo de texto (sobrescribiendo si existe)
+ * @brief Serializa un componente en el formato de texto de 7 líneas
  * 
- * @param x Componente a serializar y guardar
- * @param nombreArchivo Ruta del archivo destino (debe incluir extensión .txt)
+ * @param salida Flujo de destino (archivo o consola)
+ * @param x Componente a serializar (componente o vistaComponente)
  * 
  * @details
- * Esta función implementa el almacenamiento persistente de componentes en archivos de texto,
- * usando el siguiente formato por cada componente:
+ * Escribe los seis campos del componente, uno por línea, seguidos del
+ * separador "-----". Es el único lugar donde se define el formato de texto,
+ * de modo que guardarSesion(), continuarConArchivo() y el convertidor
+ * desde el formato binario producen exactamente la misma salida.
  * 
+ * @see guardarSesion()
+ * @see convertirBinarioATexto()
+ */
+template<class Registro>
+void escribirComponente(std::ostream& salida, const Registro& x){
+    salida<<x.nombreDelComponente<<"\n";
+    salida<<x.tipoDeComponente<<"\n";
+    salida<<x.valorNominal<<"\n";
+    salida<<x.tolerancia<<"\n";
+    salida<<x.voltajeDeTrabajo<<"\n";
+    salida<<x.estado<<"\n";
+    salida<<"-----\n"; // Separador entre componentes
+}
+
+/// Primera línea de un bloque de borrado (ver escribirLapida())
+const char MARCA_DE_BORRADO[] = "#borrado";
+
+/**
+ * @brief Escribe un bloque de borrado (lápida) que anula un componente anterior del registro
+ *
+ * @param salida Flujo de destino (el registro abierto para añadir)
+ * @param desplazamiento Byte donde empieza el bloque del componente anulado
+ *
+ * @details
+ * El registro de texto solo crece por el final, así que borrar un componente
+ * no reescribe su bloque: se añade un bloque de 3 líneas
+ *
  * --------------------------
- * NombreComponente
- * TipoComponente
- * ValorNominal
- * Tolerancia
- * VoltajeTrabajo
- * Estado
+ * #borrado
+ * desplazamiento del bloque anulado
  * -----
  * --------------------------
+ *
+ * y los lectores omiten el bloque anulado y la propia lápida (ver
+ * leerLapidas() y analizarSiguienteBloque()). Modificar un componente es
+ * añadir su versión nueva y una lápida para la anterior. Un bloque normal
+ * nunca tiene "-----" en su tercera línea, por lo que no se confunde con una
+ * lápida; una versión anterior del programa la verá como un bloque dañado y
+ * se sincronizará con el separador que la cierra.
+ *
+ * @see compactarRegistro() Para eliminar físicamente los bloques anulados
+ */
+void escribirLapida(std::ostream& salida, uint64_t desplazamiento){
+    salida<<MARCA_DE_BORRADO<<"\n";
+    salida<<desplazamiento<<"\n";
+    salida<<"-----\n";
+}
+
+/**
+ * @struct indiceSecundario
+ * @brief Índice de un archivo de texto: cada tipo y estado distinto con los bloques que lo contienen
+ * 
+ * @details
+ * Se guarda junto al registro en un archivo con el mismo nombre más ".idx"
+ * (ej: "inventario.txt.idx"). Cada valor distinto de tipoDeComponente y de
+ * estado se asocia con la lista de desplazamientos en bytes donde empiezan
+ * sus bloques, en orden de archivo. Como hay pocos tipos y estados distintos,
+ * una búsqueda evalúa la subcadena sobre unas decenas de valores y después
+ * salta directamente a los bloques que coinciden.
  * 
- * El separador "-----" permite identificar componentes individuales al cargar los datos.
+ * Formato del archivo de índice (texto, una entrada por línea):
  * 
- * @post Crea/sobrescribe el archivo especificado
- * @post El archivo contendrá todos los campos del componente en orden predefinido
- * @post Muestra mensaje de error si no puede abrir el archivo
+ * --------------------------
+ * #indice-de-componentes 2
+ * T<TAB>desplazamiento,desplazamiento,...<TAB>tipo
+ * E<TAB>desplazamiento,desplazamiento,...<TAB>estado
+ * L<TAB>bytes del registro cubiertos por el índice<TAB>huella de esos bytes
+ * --------------------------
  * 
- * @warning Si el archivo existe, será sobrescrito completamente
+ * continuarConArchivo() añade líneas T/E/L de un solo desplazamiento al final
+ * en lugar de reescribir el índice; al leerlo, las entradas con el mismo valor
+ * se combinan y la última línea L indica hasta dónde está actualizado. La
+ * huella (ver huellaDeCola()) distingue un registro que solo creció de uno
+ * reescrito con el mismo tamaño.
  * 
- * @par Ejemplo de archivo generado:
- * @code
- * Resistor 1kΩ
- * Resistor
- * 1000
- * 5
- * 12.5
- * Nuevo
- * -----
- * @endcode
+ * @see leerIndiceSecundario()
+ * @see reconstruirIndiceSecundario()
+ */
+struct indiceSecundario
+{
+    uint64_t bytesCubiertos{0}; ///< Tamaño del registro cuando se actualizó el índice
+    uint64_t huella{0}; ///< huellaDeCola() de esos bytes
+    std::map<std::string, std::vector<uint64_t>> porTipo; ///< Tipo → inicios de bloque
+    std::map<std::string, std::vector<uint64_t>> porEstado; ///< Estado → inicios de bloque
+};
+
+/**
+ * @brief Devuelve la ruta del índice secundario de un registro
  * 
- * @see continuarConArchivo() Para añadir componentes sin sobrescribir
- * @see cargarDesdeArchivo() Para leer archivos en este formato
+ * @param nombreArchivo Ruta del registro (ej: "inventario.txt")
+ * @return std::string Ruta del índice (ej: "inventario.txt.idx")
  */
-void guardarEnArchivo(const componente& x, const std::string& nombreArchivo){
-    std::ofstream archivo(nombreArchivo);
-    if (archivo.is_open())
+std::string rutaDeIndice(const std::string& nombreArchivo){
+    return nombreArchivo + ".idx";
+}
+
+/**
+ * @brief Obtiene el tamaño de un archivo sin abrirlo
+ * 
+ * @param nombreArchivo Ruta del archivo
+ * @return uint64_t Tamaño en bytes, o 0 si el archivo no existe
+ */
+uint64_t tamanoDeArchivo(const std::string& nombreArchivo){
+    std::error_code error;
+    uint64_t tamano = std::filesystem::file_size(nombreArchivo, error);
+    return error ? 0 : tamano;
+}
+
+/// Bytes del final de la parte cubierta por un índice que entran en su huella
+const uint64_t BYTES_DE_HUELLA_DE_INDICE = 64;
+
+/**
+ * @brief Huella de los últimos bytes que cubre un índice
+ * 
+ * @param datos Contenido del registro
+ * @param bytes Bytes cubiertos por el índice
+ * @return uint64_t FNV-1a de los BYTES_DE_HUELLA_DE_INDICE bytes anteriores a 'bytes'
+ * 
+ * @details
+ * Junto con 'bytesCubiertos', es lo que un índice guarda para saber si sigue
+ * al día: añadir bloques no cambia esos bytes, pero reescribir el registro
+ * (con otro programa, o copiando otro encima) casi siempre sí. Igual que la
+ * huella de registroEnArena::actualizar(), no detecta un cambio que deje
+ * intactos el tamaño y el final.
+ */
+uint64_t huellaDeCola(const char* datos, uint64_t bytes){
+    uint64_t huella = 14695981039346656037ull;
+    for (uint64_t i = bytes - std::min(bytes, BYTES_DE_HUELLA_DE_INDICE); i < bytes; i++)
     {
-        archivo<<x.nombreDelComponente<<"\n";
-        archivo<<x.tipoDeComponente<<"\n";
-        archivo<<x.valorNominal<<"\n";
-        archivo<<x.tolerancia<<"\n";
-        archivo<<x.voltajeDeTrabajo<<"\n";
-        archivo<<x.estado<<"\n";
-        archivo<<"-----\n"; // Separador entre componentes
-        archivo.close();
-    }
-    else{
-        std::cout<<"No se pudo abrir el archivo para guardar \n";
+        huella = (huella ^ static_cast<unsigned char>(datos[i])) * 1099511628211ull;
     }
+    return huella;
 }
 
 /**
- * @brief Añade un componente al final de un archivo existente
+ * @brief Huella de los últimos bytes que cubre un índice, leída del registro
  * 
- * @param x Componente a serializar y añadir
- * @param nombreArchivo Ruta del archivo destino (debe existir y tener extensión .txt)
+ * @param nombreArchivo Ruta del registro
+ * @param bytes Bytes cubiertos por el índice
+ * @return uint64_t La misma huellaDeCola() que sobre el contenido proyectado
+ *         (la de un registro vacío si no se pudo leer)
+ */
+uint64_t huellaDeColaDelArchivo(const std::string& nombreArchivo, uint64_t bytes){
+    const uint64_t cola = std::min(bytes, BYTES_DE_HUELLA_DE_INDICE);
+    char final[BYTES_DE_HUELLA_DE_INDICE];
+    std::ifstream archivo(nombreArchivo, std::ios::binary);
+    archivo.seekg(static_cast<std::streamoff>(bytes - cola));
+    if (!archivo.read(final, static_cast<std::streamsize>(cola))) return huellaDeCola(final, 0);
+    return huellaDeCola(final, cola);
+}
+
+/**
+ * @brief Lee el índice secundario de un registro
  * 
- * @details
- * Esta función implementa escritura al final (append) de archivos para componentes,
- * manteniendo el mismo formato que guardarEnArchivo():
+ * @param nombreArchivo Ruta del registro (no del índice)
+ * @param indice Salida: índice leído, con las entradas añadidas ya combinadas
+ * @return false si el índice no existe o no tiene el formato esperado
  * 
- * --------------------------
- * NombreComponente
- * TipoComponente
- * ValorNominal
- * Tolerancia
- * VoltajeTrabajo
- * Estado
- * -----
- * --------------------------
+ * @note No comprueba si el índice está al día; usar indiceAlDia() para eso
+ */
+bool leerIndiceSecundario(const std::string& nombreArchivo, indiceSecundario& indice){
+    indice = indiceSecundario();
+    std::ifstream archivo(rutaDeIndice(nombreArchivo));
+    std::string linea;
+    if (!std::getline(archivo, linea) || linea != "#indice-de-componentes 2") return false;
+
+    bool completo = false;
+    while (std::getline(archivo, linea)) {
+        size_t tab1 = linea.find('\t');
+        if (tab1 != 1) return false;
+        if (linea[0] == 'L') {
+            char* fin = nullptr;
+            indice.bytesCubiertos = std::strtoull(linea.c_str() + 2, &fin, 10);
+            if (*fin != '\t') return false;
+            indice.huella = std::strtoull(fin + 1, nullptr, 10);
+            completo = true;
+            continue;
+        }
+        size_t tab2 = linea.find('\t', 2);
+        if (tab2 == std::string::npos || (linea[0] != 'T' && linea[0] != 'E')) return false;
+        auto& destino = (linea[0] == 'T' ? indice.porTipo : indice.porEstado)[linea.substr(tab2 + 1)];
+        const char* posicion = linea.c_str() + 2;
+        const char* finLista = linea.c_str() + tab2;
+        while (posicion < finLista) {
+            uint64_t desplazamiento;
+            auto resultado = std::from_chars(posicion, finLista, desplazamiento);
+            if (resultado.ec != std::errc()) return false;
+            destino.push_back(desplazamiento);
+            posicion = resultado.ptr + 1; // Saltar la coma
+        }
+    }
+    return completo;
+}
+
+/**
+ * @brief Escribe el índice secundario completo, reemplazando el anterior
  * 
- * El modo std::ios::app garantiza que:
- * - Los nuevos datos se añaden después del último componente
- * - No se modifica el contenido existente
- * - Crea el archivo si no existe (comportamiento diferente a guardarEnArchivo())
+ * @param nombreArchivo Ruta del registro (no del índice)
+ * @param indice Índice a guardar
+ * @return true si se escribió correctamente
+ */
+bool escribirIndiceSecundario(const std::string& nombreArchivo, const indiceSecundario& indice){
+    std::ofstream archivo(rutaDeIndice(nombreArchivo), std::ios::trunc);
+    if (!archivo.is_open()) return false;
+    archivo << "#indice-de-componentes 2\n";
+    auto escribirGrupo = [&archivo](char marca, const std::map<std::string, std::vector<uint64_t>>& grupo) {
+        for (const auto& [valor, desplazamientos] : grupo) {
+            archivo << marca << '\t';
+            for (size_t i = 0; i < desplazamientos.size(); i++) {
+                if (i > 0) archivo << ',';
+                archivo << desplazamientos[i];
+            }
+            archivo << '\t' << valor << '\n';
+        }
+    };
+    escribirGrupo('T', indice.porTipo);
+    escribirGrupo('E', indice.porEstado);
+    archivo << "L\t" << indice.bytesCubiertos << '\t' << indice.huella << "\n";
+    return static_cast<bool>(archivo);
+}
+
+/**
+ * @brief Lee solo la última línea L del índice para saber hasta dónde está al día
  * 
- * @post El componente se añade al final del archivo
- * @post Preserva todos los componentes existentes
- * @post Muestra error si falla la apertura
+ * @param nombreArchivo Ruta del registro (no del índice)
+ * @param huella Salida: huella guardada junto a los bytes cubiertos
+ * @return uint64_t Bytes cubiertos, o UINT64_MAX si no hay índice válido
  * 
- * @par Ejemplo de uso:
- * @code
- * componente c;
- * // ... inicializar c ...
- * continuarConArchivo(c, "componentes.txt");
- * @endcode
+ * @details
+ * Lee únicamente los últimos bytes del índice, así que cuesta lo mismo sin
+ * importar el tamaño del registro.
+ */
+uint64_t bytesCubiertosPorIndice(const std::string& nombreArchivo, uint64_t& huella){
+    std::ifstream archivo(rutaDeIndice(nombreArchivo), std::ios::binary | std::ios::ate);
+    if (!archivo.is_open()) return UINT64_MAX;
+    const std::streamoff tamano = archivo.tellg();
+    const std::streamoff cola = std::min<std::streamoff>(tamano, 64);
+    std::string final(cola, '\0');
+    archivo.seekg(tamano - cola);
+    archivo.read(final.data(), cola);
+    size_t marca = final.rfind("\nL\t");
+    if (marca == std::string::npos) return UINT64_MAX;
+    char* fin = nullptr;
+    const uint64_t bytesCubiertos = std::strtoull(final.c_str() + marca + 3, &fin, 10);
+    if (*fin != '\t') return UINT64_MAX;
+    huella = std::strtoull(fin + 1, nullptr, 10);
+    return bytesCubiertos;
+}
+
+/**
+ * @brief Añade al índice secundario los componentes recién agregados al registro
  * 
- * @throw Ninguno (errores se manejan con mensajes a stdout)
+ * @param nombreArchivo Ruta del registro
+ * @param tamanoPrevio Tamaño del registro antes de escribir el lote
+ * @param nuevos Componentes añadidos, en orden
+ * @param desplazamientos Byte donde empieza el bloque de cada uno
+ * @param nuevoTamano Tamaño del registro después de escribir el lote
+ * @param huellaPrevia huellaDeCola() de los primeros 'tamanoPrevio' bytes
+ * @param nuevaHuella huellaDeCola() de los primeros 'nuevoTamano' bytes
  * 
- * @see guardarEnArchivo() Para sobrescribir archivos
- * @see cargarDesdeArchivo() Para leer este formato
- * @see std::ofstream::app Para detalles del modo append
+ * @details
+ * Solo actualiza un índice que estaba al día (su línea L coincide con
+ * 'tamanoPrevio' y 'huellaPrevia'); si no existe o ya estaba desactualizado
+ * no hace nada y el índice se reconstruirá en la siguiente búsqueda por tipo
+ * o estado.
+ * Abre el índice una sola vez por lote y escribe una única línea L al final.
+ * 
+ * El lote puede contener lápidas (ver escribirLapida()), que no tienen
+ * entrada en el índice: si solo hubo lápidas, 'nuevos' está vacío y
+ * únicamente avanza la línea L. Las búsquedas descartan los bloques anulados.
+ * 
+ * @see continuarConArchivo()
+ * @see escritorDeRegistro
  */
-void continuarConArchivo(const componente& x, const std::string& nombreArchivo){
-    std::ofstream archivo(nombreArchivo, std::ios::app);
-    if (archivo.is_open())
+void actualizarIndiceSecundario(const std::string& nombreArchivo, uint64_t tamanoPrevio, const std::vector<componente>& nuevos,
+                                const std::vector<uint64_t>& desplazamientos, uint64_t nuevoTamano,
+                                uint64_t huellaPrevia, uint64_t nuevaHuella){
+    uint64_t huella = 0;
+    if (bytesCubiertosPorIndice(nombreArchivo, huella) != tamanoPrevio || huella != huellaPrevia) return;
+    std::ofstream archivo(rutaDeIndice(nombreArchivo), std::ios::app);
+    for (size_t i = 0; i < nuevos.size(); i++)
     {
-        archivo<<x.nombreDelComponente<<"\n";
-        archivo<<x.tipoDeComponente<<"\n";
-        archivo<<x.valorNominal<<"\n";
-        archivo<<x.tolerancia<<"\n";
-        archivo<<x.voltajeDeTrabajo<<"\n";
-        archivo<<x.estado<<"\n";
-        archivo<<"-----\n";
-        archivo.close();
-    }
-    else{
-        std::cout<<"No se pudo abrir el archivo para guardar \n";
+        archivo << "T\t" << desplazamientos[i] << '\t' << nuevos[i].tipoDeComponente << '\n';
+        archivo << "E\t" << desplazamientos[i] << '\t' << nuevos[i].estado << '\n';
     }
+    archivo << "L\t" << nuevoTamano << '\t' << nuevaHuella << '\n';
 }
 
 /**
- * @brief Muestra el contenido completo de un archivo de componentes en la consola
- * 
- * @param nombreArchivo Ruta del archivo a visualizar (debe incluir extensión .txt)
+ * @struct indiceDeTrigramas
+ * @brief Índice invertido de trigramas sobre nombreDelComponente
  * 
  * @details
- * Esta función realiza las siguientes operaciones:
- * 1. Abre el archivo en modo lectura
- * 2. Lee línea por línea todo el contenido
- * 3. Muestra el contenido formateado en la consola
+ * Cada secuencia de 3 bytes consecutivos (trigrama) que aparece en algún
+ * nombre se asocia con la lista ordenada de desplazamientos de los bloques
+ * cuyo nombre la contiene. Para buscar la subcadena "10kΩ" basta con
+ * intersecar las listas de "10k", "0kΩ"... y verificar los pocos candidatos
+ * con la comparación exacta, en lugar de recorrer todos los nombres.
  * 
- * El formato de visualización muestra exactamente el contenido crudo del archivo,
- * incluyendo los separadores "-----" entre componentes.
+ * Se guarda junto al registro con el mismo nombre más ".tri", en binario:
  * 
- * @post Muestra todo el contenido del archivo o un mensaje de error
- * @post No modifica el archivo original
- * @post Cierra el archivo automáticamente al finalizar
+ * --------------------------
+ * char magia[8]             "RCOMPTR2"
+ * uint64_t bytesCubiertos   tamaño del registro cuando se actualizó
+ * uint64_t huella           huellaDeCola() de esos bytes
+ * repetido hasta el final:
+ *   uint32_t trigrama       3 bytes empaquetados (b0 << 16 | b1 << 8 | b2)
+ *   uint32_t cantidad
+ *   uint64_t desplazamientos[cantidad]
+ * --------------------------
  * 
- * @throw Ninguno (los errores se manejan internamente)
+ * continuarConArchivo() añade entradas de un solo desplazamiento al final y
+ * reescribe solo 'bytesCubiertos' y 'huella'; al leer, las entradas del mismo trigrama se
+ * concatenan, y como los bloques añadidos están después de los anteriores,
+ * las listas siguen ordenadas.
  * 
- * @par Ejemplo de salida:
- * @code
- * Contenido del archivo línea por línea:
- * Resistor 1kΩ
- * Resistor
- * 1000
- * 5
- * 12.5
- * Nuevo
- * -----
- * Capacitor 10uF
- * ...
- * @endcode
+ * @note Los trigramas son de bytes, igual que std::string::find(), así que la
+ *       búsqueda sigue siendo sensible a mayúsculas y funciona con UTF-8
  * 
- * @warning
- * - No interpreta la estructura de componentes, solo muestra líneas
- * - Archivos muy grandes pueden consumir mucha memoria
+ * @see reconstruirIndiceDeTrigramas()
+ * @see buscarConIndiceDeTrigramas()
+ */
+struct indiceDeTrigramas
+{
+    uint64_t bytesCubiertos{0}; ///< Tamaño del registro cuando se actualizó el índice
+    uint64_t huella{0}; ///< huellaDeCola() de esos bytes
+    std::unordered_map<uint32_t, std::vector<uint64_t>> listas; ///< Trigrama → inicios de bloque
+};
+
+const char MAGIA_TRIGRAMAS[8] = {'R','C','O','M','P','T','R','2'}; ///< Firma de los archivos ".tri"
+
+/**
+ * @brief Devuelve la ruta del índice de trigramas de un registro
  * 
- * @see cargarDesdeArchivo() Para cargar componentes con estructura
- * @see guardarEnArchivo() Para entender el formato del archivo
+ * @param nombreArchivo Ruta del registro (ej: "inventario.txt")
+ * @return std::string Ruta del índice (ej: "inventario.txt.tri")
  */
-void mostrarArchivoExistente(const std::string& nombreArchivo){
-    std::ifstream archivo(nombreArchivo);
-    if (!archivo) {
-        std::cerr << "Error al abrir el archivo." << std::endl;
-        return;
-    }
+std::string rutaDeTrigramas(const std::string& nombreArchivo){
+    return nombreArchivo + ".tri";
+}
 
-    std::vector<std::string> lineas;
-    std::string linea;
-    
-    while (std::getline(archivo, linea)) { 
-        lineas.push_back(linea); 
+/**
+ * @brief Obtiene los trigramas distintos de un texto
+ * 
+ * @param texto Nombre o subcadena buscada
+ * @return std::vector<uint32_t> Trigramas empaquetados, ordenados y sin repetir
+ *         (vacío si el texto tiene menos de 3 bytes)
+ */
+std::vector<uint32_t> trigramasDe(std::string_view texto){
+    std::vector<uint32_t> trigramas;
+    for (size_t i = 0; i + 3 <= texto.size(); i++)
+    {
+        trigramas.push_back(static_cast<uint32_t>(static_cast<unsigned char>(texto[i])) << 16
+                          | static_cast<uint32_t>(static_cast<unsigned char>(texto[i + 1])) << 8
+                          | static_cast<uint32_t>(static_cast<unsigned char>(texto[i + 2])));
     }
+    std::sort(trigramas.begin(), trigramas.end());
+    trigramas.erase(std::unique(trigramas.begin(), trigramas.end()), trigramas.end());
+    return trigramas;
+}
 
-    archivo.close();
+/**
+ * @brief Escribe una entrada (trigrama, desplazamientos) del formato ".tri"
+ */
+void escribirEntradaDeTrigrama(std::ostream& salida, uint32_t trigrama, const std::vector<uint64_t>& desplazamientos){
+    uint32_t cantidad = static_cast<uint32_t>(desplazamientos.size());
+    salida.write(reinterpret_cast<const char*>(&trigrama), sizeof(trigrama));
+    salida.write(reinterpret_cast<const char*>(&cantidad), sizeof(cantidad));
+    salida.write(reinterpret_cast<const char*>(desplazamientos.data()), cantidad * sizeof(uint64_t));
+}
+
+/**
+ * @brief Lee el índice de trigramas de un registro
+ * 
+ * @param nombreArchivo Ruta del registro (no del índice)
+ * @param indice Salida: índice leído, con las entradas añadidas ya combinadas
+ * @return false si el índice no existe o está dañado
+ */
+bool leerIndiceDeTrigramas(const std::string& nombreArchivo, indiceDeTrigramas& indice){
+    indice = indiceDeTrigramas();
+    std::ifstream archivo(rutaDeTrigramas(nombreArchivo), std::ios::binary | std::ios::ate);
+    if (!archivo.is_open()) return false;
+    const uint64_t tamano = static_cast<uint64_t>(archivo.tellg());
+    archivo.seekg(0);
+    char firma[8];
+    if (!archivo.read(firma, sizeof(firma)) || std::memcmp(firma, MAGIA_TRIGRAMAS, sizeof(firma)) != 0) return false;
+    if (!archivo.read(reinterpret_cast<char*>(&indice.bytesCubiertos), sizeof(indice.bytesCubiertos))) return false;
+    if (!archivo.read(reinterpret_cast<char*>(&indice.huella), sizeof(indice.huella))) return false;
 
-    std::cout << "Contenido del archivo línea por línea:\n";
-    for (const auto& l : lineas) {
-        std::cout << l << std::endl;
+    uint32_t trigrama;
+    uint32_t cantidad;
+    while (archivo.read(reinterpret_cast<char*>(&trigrama), sizeof(trigrama))) {
+        if (!archivo.read(reinterpret_cast<char*>(&cantidad), sizeof(cantidad))) return false;
+        // Una cantidad dañada no debe provocar una reserva mayor que el propio archivo
+        const uint64_t quedan = tamano - static_cast<uint64_t>(archivo.tellg());
+        if (cantidad > quedan / sizeof(uint64_t)) return false;
+        std::vector<uint64_t>& lista = indice.listas[trigrama];
+        size_t anterior = lista.size();
+        lista.resize(anterior + cantidad);
+        if (!archivo.read(reinterpret_cast<char*>(lista.data() + anterior), cantidad * sizeof(uint64_t))) return false;
     }
+    return true;
+}
 
+/**
+ * @brief Escribe el índice de trigramas completo, reemplazando el anterior
+ * 
+ * @param nombreArchivo Ruta del registro (no del índice)
+ * @param indice Índice a guardar
+ * @return true si se escribió correctamente
+ */
+bool escribirIndiceDeTrigramas(const std::string& nombreArchivo, const indiceDeTrigramas& indice){
+    std::ofstream archivo(rutaDeTrigramas(nombreArchivo), std::ios::binary | std::ios::trunc);
+    if (!archivo.is_open()) return false;
+    archivo.write(MAGIA_TRIGRAMAS, sizeof(MAGIA_TRIGRAMAS));
+    archivo.write(reinterpret_cast<const char*>(&indice.bytesCubiertos), sizeof(indice.bytesCubiertos));
+    archivo.write(reinterpret_cast<const char*>(&indice.huella), sizeof(indice.huella));
+    std::vector<uint32_t> trigramas;
+    trigramas.reserve(indice.listas.size());
+    for (const auto& entrada : indice.listas) trigramas.push_back(entrada.first);
+    std::sort(trigramas.begin(), trigramas.end());
+    for (uint32_t trigrama : trigramas) {
+        escribirEntradaDeTrigrama(archivo, trigrama, indice.listas.at(trigrama));
+    }
+    return static_cast<bool>(archivo);
 }
 
 /**
- * @brief Vacía completamente el contenido de un archivo
+ * @brief Añade al índice de trigramas los componentes recién agregados al registro
  * 
- * @param nombreArchivo Ruta del archivo a vaciar (debe incluir extensión .txt)
+ * @param nombreArchivo Ruta del registro
+ * @param tamanoPrevio Tamaño del registro antes de escribir el lote
+ * @param nuevos Componentes añadidos, en orden
+ * @param desplazamientos Byte donde empieza el bloque de cada uno
+ * @param nuevoTamano Tamaño del registro después de escribir el lote
+ * @param huellaPrevia huellaDeCola() de los primeros 'tamanoPrevio' bytes
+ * @param nuevaHuella huellaDeCola() de los primeros 'nuevoTamano' bytes
  * 
  * @details
- * Esta función elimina todo el contenido del archivo especificado mediante:
- * 1. Apertura en modo truncate (std::ios::trunc)
- * 2. Cierre inmediato del archivo
- * 
- * El archivo permanece existente pero con 0 bytes de tamaño.
- * 
- * @post El archivo queda vacío si se abre correctamente
- * @post El archivo original es sobreescrito completamente
- * @post Muestra confirmación de éxito o error
- * 
- * @warning
- * - La operación es irreversible
- * - No solicita confirmación antes de vaciar
- * - El archivo debe tener permisos de escritura
- * 
- * @par Ejemplo de uso:
- * @code
- * eliminarContenidoArchivo("componentes_obsoletos.txt");
- * // Salida: "El archivo 'componentes_obsoletos.txt' fue vaciado con éxito."
- * @endcode
- * 
- * @see guardarEnArchivo() Para crear archivos nuevos
- * @see continuarConArchivo() Para añadir contenido sin borrar
+ * Igual que actualizarIndiceSecundario(): solo actualiza un índice que estaba
+ * al día. Añade una entrada por trigrama de cada nombre y después reescribe
+ * en su lugar los 16 bytes de 'bytesCubiertos' y 'huella' (lo único que
+ * cambia cuando 'nuevos' está vacío porque solo se añadieron lápidas).
  */
-void eliminarContenidoArchivo(const std::string& nombreArchivo){
-    std::ofstream archivo(nombreArchivo, std::ios::trunc);
-    if (archivo.is_open()) {
-        std::cout << "El archivo '" << nombreArchivo << "' fue vaciado con éxito.\n";
-        archivo.close();
-    } else {
-        std::cout << "No se pudo abrir el archivo.\n";
+void actualizarIndiceDeTrigramas(const std::string& nombreArchivo, uint64_t tamanoPrevio, const std::vector<componente>& nuevos,
+                                 const std::vector<uint64_t>& desplazamientos, uint64_t nuevoTamano,
+                                 uint64_t huellaPrevia, uint64_t nuevaHuella){
+    std::fstream archivo(rutaDeTrigramas(nombreArchivo), std::ios::binary | std::ios::in | std::ios::out);
+    char firma[8];
+    uint64_t cabecera[2]; // bytesCubiertos y huella
+    if (!archivo.read(firma, sizeof(firma)) || std::memcmp(firma, MAGIA_TRIGRAMAS, sizeof(firma)) != 0) return;
+    if (!archivo.read(reinterpret_cast<char*>(cabecera), sizeof(cabecera)) || cabecera[0] != tamanoPrevio || cabecera[1] != huellaPrevia) return;
+
+    archivo.seekp(0, std::ios::end);
+    std::vector<uint64_t> lista(1);
+    for (size_t i = 0; i < nuevos.size(); i++)
+    {
+        lista[0] = desplazamientos[i];
+        for (uint32_t trigrama : trigramasDe(nuevos[i].nombreDelComponente)) {
+            escribirEntradaDeTrigrama(archivo, trigrama, lista);
+        }
     }
+    cabecera[0] = nuevoTamano;
+    cabecera[1] = nuevaHuella;
+    archivo.seekp(sizeof(MAGIA_TRIGRAMAS));
+    archivo.write(reinterpret_cast<const char*>(cabecera), sizeof(cabecera));
 }
 
 /**
- * @brief Muestra el menú principal de la aplicación con formato visual
+ * @brief Añade un lote de componentes recién agregados a todos los índices del registro
  * 
- * @details 
- * Presenta las opciones disponibles en un formato visualmente organizado:
+ * @param nombreArchivo Ruta del registro
+ * @param tamanoPrevio Tamaño del registro antes de escribir el lote
+ * @param nuevos Componentes añadidos, en orden
+ * @param desplazamientos Byte donde empieza el bloque de cada uno
+ * @param nuevoTamano Tamaño del registro después de escribir el lote
  * 
- * ============================
- * ¡Bienvenido! seleccione una opción:
- * (1) Nuevo registro de componentes
- * (2) Continuar registro desde un archivo existente
- * (3) Ver registros de un archivo existente
- * (4) Eliminar el contenido de un archivo
- * (5) Buscar un componente en un archivo
- * (6) Salir
- * ============================
+ * @see actualizarIndiceSecundario()
+ * @see actualizarIndiceDeTrigramas()
+ */
+void actualizarIndices(const std::string& nombreArchivo, uint64_t tamanoPrevio, const std::vector<componente>& nuevos,
+                       const std::vector<uint64_t>& desplazamientos, uint64_t nuevoTamano){
+    const uint64_t huellaPrevia = huellaDeColaDelArchivo(nombreArchivo, tamanoPrevio);
+    const uint64_t nuevaHuella = huellaDeColaDelArchivo(nombreArchivo, nuevoTamano);
+    actualizarIndiceSecundario(nombreArchivo, tamanoPrevio, nuevos, desplazamientos, nuevoTamano, huellaPrevia, nuevaHuella);
+    actualizarIndiceDeTrigramas(nombreArchivo, tamanoPrevio, nuevos, desplazamientos, nuevoTamano, huellaPrevia, nuevaHuella);
+}
+
+/**
+ * @brief Añade un componente recién agregado a todos los índices del registro
  * 
- * Cada opción está numerada y alineada para mejor legibilidad.
+ * @param nombreArchivo Ruta del registro
+ * @param x Componente añadido
+ * @param desplazamiento Byte donde empieza su bloque
+ * @param nuevoTamano Tamaño del registro después de añadirlo
+ */
+void actualizarIndices(const std::string& nombreArchivo, const componente& x, uint64_t desplazamiento, uint64_t nuevoTamano){
+    actualizarIndices(nombreArchivo, desplazamiento, std::vector<componente>{x}, std::vector<uint64_t>{desplazamiento}, nuevoTamano);
+}
+
+/**
+ * @brief Elimina los índices (".idx" y ".tri") de un registro que fue reescrito o vaciado
  * 
- * @post Genera salida estándar con el menú formateado
- * @post No afecta el estado del programa
+ * @param nombreArchivo Ruta del registro
+ */
+void descartarIndices(const std::string& nombreArchivo){
+    std::error_code error;
+    std::filesystem::remove(rutaDeIndice(nombreArchivo), error);
+    std::filesystem::remove(rutaDeTrigramas(nombreArchivo), error);
+}
+
+/**
+ * @brief Devuelve la ruta del archivo de bloqueo de un registro
  * 
- * @note
- * - Las opciones están diseñadas para ser claras y autodescriptivas
- * - Los separadores "===" mejoran la legibilidad visual
- * - Corresponde a eleccionMenuprincipal() para procesar la selección
+ * @param nombreArchivo Ruta del registro
+ * @return std::string nombreArchivo seguido de ".lock"
  * 
- * @see eleccionMenuprincipal() Para el manejo de la selección del usuario
+ * @details
+ * El bloqueo no se toma sobre el propio registro porque quien lo reescribe
+ * completo (guardarSesion(), guardarEnBinario(), eliminarContenidoArchivo())
+ * lo reemplaza con un rename() (reemplazarArchivo()), y un bloqueo sobre el
+ * archivo anterior no excluiría a quien abra el nuevo. El archivo ".lock"
+ * nunca se borra y guarda además la longitud confirmada del registro (ver
+ * registrarLongitudConfirmada()).
  */
-void mostrarMenu(){
-    std::cout << "\n============================\n";
-    std::cout<<"¡Bienvenido! seleccione una opción:\n";
-    std::cout<<"(1)Nuevo registro de componentes \n";
-    std::cout<<"(2)Continuar registro desde un archivo existente. \n";
-    std::cout<<"(3)Ver registros de un archivo existente. \n";
-    std::cout<<"(4)Eliminar el contenido de un archivo. \n";
-    std::cout<<"(5)Buscar un componente en un archivo\n";
-    std::cout<< "(6)Salir\n";
-    std::cout << "\n============================\n";
+std::string rutaDeBloqueo(const std::string& nombreArchivo){
+    return nombreArchivo + ".lock";
 }
 
 /**
- * @brief Carga componentes desde un archivo de texto al vector de registros
+ * @brief Calcula dónde termina el último bloque completo de un registro de texto
  * 
- * @param registros Vector donde se almacenarán los componentes cargados
- * @param nombreArchivo Ruta del archivo a cargar (debe incluir extensión .txt)
+ * @param datos Contenido del registro
+ * @param tamano Bytes de 'datos'
+ * @return uint64_t Byte siguiente a la última línea "-----" (0 si no hay ninguna)
  * 
  * @details
- * Esta función implementa un parser para el formato específico de archivos de componentes:
- * 1. Abre el archivo en modo lectura
- * 2. Lee línea por línea reconstruyendo la estructura de cada componente
- * 3. Sigue estrictamente el formato:
- *    - Línea 1: Nombre
- *    - Línea 2: Tipo  
- *    - Línea 3: Valor nominal (float)
- *    - Línea 4: Tolerancia (float)
- *    - Línea 5: Voltaje (float)
- *    - Línea 6: Estado
- *    - Línea 7: Separador "-----"
+ * Todo bloque (componente o lápida) termina en una línea "-----", así que lo
+ * que haya después de la última es un bloque a medio escribir. En un registro
+ * completo la búsqueda termina en la primera comparación, porque el archivo
+ * acaba en "-----\n".
+ */
+uint64_t finDelUltimoBloque(const char* datos, uint64_t tamano){
+    const std::string_view texto(datos, tamano);
+    size_t posicion = texto.size();
+    while (posicion > 0) {
+        posicion = texto.rfind("-----", posicion - 1);
+        if (posicion == std::string_view::npos) return 0;
+        const size_t fin = posicion + 5;
+        const bool inicioDeLinea = posicion == 0 || texto[posicion - 1] == '\n';
+        if (inicioDeLinea && fin == texto.size()) return fin;
+        if (inicioDeLinea && texto[fin] == '\n') return fin + 1;
+    }
+    return 0;
+}
+
+/**
+ * @enum modoDeBloqueo
+ * @brief Qué hace bloqueoDeRegistro si otro proceso ya tiene el bloqueo
+ */
+enum class modoDeBloqueo
+{
+    esperar, ///< Espera a que se libere (escrituras)
+    intentar ///< No espera; adquirido() indica si se obtuvo (tareas opcionales)
+};
+
+/**
+ * @class bloqueoDeRegistro
+ * @brief Bloqueo exclusivo de escritura sobre un registro, entre procesos
  * 
- * @post El vector 'registros' contiene todos los componentes válidos del archivo
- * @post El vector se vacía antes de cargar nuevos registros
- * @post Muestra error si no puede abrir el archivo
+ * @details
+ * Toma un flock() exclusivo sobre el archivo ".lock" del registro (ver
+ * rutaDeBloqueo()) y lo libera al destruirse. Todas las escrituras del
+ * programa (añadir componentes o lápidas, reescribir, vaciar, compactar y
+ * actualizar los índices) se hacen con el bloqueo, así que se serializan
+ * entre terminales. Los lectores no lo toman: leen una instantánea del
+ * registro (ver longitudConfirmada()) y nunca detienen a un escritor.
  * 
- * @throw std::invalid_argument Si encuentra valores numéricos inválidos
- * @throw std::out_of_range Si los valores numéricos exceden los límites
+ * Es reentrante dentro del proceso: si una función con el bloqueo llama a
+ * otra que también lo pide (ej: compactarRegistro() → guardarSesion()), el
+ * bloqueo interior no hace nada. Dos flock() desde el mismo proceso sobre
+ * descriptores distintos se excluirían entre sí.
  * 
- * @par Ejemplo de formato de archivo:
+ * @warning Es un bloqueo consultivo: solo excluye a los procesos que también
+ *          lo piden. Fuera de sistemas POSIX no bloquea nada
+ * 
+ * @par Ejemplo de uso:
  * @code
- * Resistor 1kΩ
- * Resistor
- * 1000
- * 5  
- * 12.5
- * Nuevo
- * -----
+ * {
+ *     bloqueoDeRegistro bloqueo("inventario.txt");
+ *     // ... escribir en el registro ...
+ *     registrarLongitudConfirmada("inventario.txt", tamanoDeArchivo("inventario.txt"));
+ * } // se libera aquí
  * @endcode
+ */
+class bloqueoDeRegistro
+{
+public:
+    explicit bloqueoDeRegistro(const std::string& nombreArchivo, modoDeBloqueo modo = modoDeBloqueo::esperar);
+    ~bloqueoDeRegistro();
+    bloqueoDeRegistro(const bloqueoDeRegistro&) = delete;
+    bloqueoDeRegistro& operator=(const bloqueoDeRegistro&) = delete;
+
+    bool adquirido() const { return obtenido; } ///< true si este proceso tiene el bloqueo
+    static bool tomadoPorEsteProceso(const std::string& nombreArchivo);
+
+private:
+    /// Rutas de bloqueo que este proceso tiene, con cuántos objetos las usan
+    static std::map<std::string, int>& bloqueosDelProceso();
+    static std::mutex& mutexDeBloqueos();
+
+    std::string ruta;
+    int descriptor{-1};
+    bool obtenido{false};
+};
+
+std::map<std::string, int>& bloqueoDeRegistro::bloqueosDelProceso(){
+    static std::map<std::string, int> bloqueos;
+    return bloqueos;
+}
+
+std::mutex& bloqueoDeRegistro::mutexDeBloqueos(){
+    static std::mutex mutex;
+    return mutex;
+}
+
+/**
+ * @brief Indica si este proceso tiene el bloqueo del registro (y por tanto ningún otro escribe)
+ */
+bool bloqueoDeRegistro::tomadoPorEsteProceso(const std::string& nombreArchivo){
+    std::lock_guard<std::mutex> guarda(mutexDeBloqueos());
+    return bloqueosDelProceso().count(rutaDeBloqueo(nombreArchivo)) > 0;
+}
+
+/**
+ * @brief Adquiere el bloqueo del registro (o lo comparte si este proceso ya lo tiene)
  * 
- * @note
- * - Usa std::stof() para conversión numérica (lanza excepciones)
- * - El contador maneja la posición de cada campo
- * - Reinicia el estado al encontrar "-----"
+ * @param nombreArchivo Ruta del registro
+ * @param modo Esperar a que se libere o solo intentarlo
  * 
- * @see guardarEnArchivo() Para el formato de guardado equivalente
- * @see continuarConArchivo() Para añadir componentes a archivos
+ * @post adquirido() indica si se obtuvo; con modoDeBloqueo::esperar solo es
+ *       false si el archivo ".lock" no se pudo crear
  */
-void cargarDesdeArchivo(std::vector<componente>& registros, const std::string& nombreArchivo) {
-    std::ifstream archivo(nombreArchivo);
-    if (!archivo.is_open()) {
-        std::cout << "No se pudo abrir el archivo.\n";
+bloqueoDeRegistro::bloqueoDeRegistro(const std::string& nombreArchivo, modoDeBloqueo modo) : ruta(rutaDeBloqueo(nombreArchivo)){
+    std::lock_guard<std::mutex> guarda(mutexDeBloqueos());
+    auto existente = bloqueosDelProceso().find(ruta);
+    if (existente != bloqueosDelProceso().end()) {
+        existente->second++;
+        obtenido = true;
         return;
     }
-
-    registros.clear();  // Limpiamos para evitar mezclar registros anteriores
-    componente temp;
-    std::string linea;
-    int contador = 0;
-
-    while (std::getline(archivo, linea)) {
-        switch (contador) {
-            case 0: 
-                temp.nombreDelComponente = linea; 
-                break;
-            case 1: 
-                temp.tipoDeComponente = linea; 
-                break;
-            case 2: 
-                temp.valorNominal = std::stof(linea); 
-                break;
-            case 3: 
-                temp.tolerancia = std::stof(linea); 
-                break;
-            case 4: 
-                temp.voltajeDeTrabajo = std::stof(linea); 
-                break;
-            case 5: 
-                temp.estado = linea; 
-                break;
-            case 6:
-                if (linea == "-----") {
-                    registros.push_back(temp);
-                    temp = componente();  // Limpiar para el siguiente
-                    contador = -1;       // Reiniciar para el siguiente bloque
-                }
-                break;
-        }
-        contador++;
+#if defined(SISTEMA_POSIX)
+    descriptor = ::open(ruta.c_str(), O_RDWR | O_CREAT, 0644);
+    if (descriptor < 0) return;
+    int resultado;
+    do {
+        resultado = ::flock(descriptor, LOCK_EX | (modo == modoDeBloqueo::intentar ? LOCK_NB : 0));
+    } while (resultado != 0 && errno == EINTR);
+    if (resultado != 0) {
+        ::close(descriptor);
+        descriptor = -1;
+        return;
     }
+#else
+    (void)modo;
+#endif
+    bloqueosDelProceso()[ruta] = 1;
+    obtenido = true;
+}
 
-    archivo.close();
+/**
+ * @brief Libera el bloqueo si este objeto fue el último que lo usaba en el proceso
+ */
+bloqueoDeRegistro::~bloqueoDeRegistro(){
+    if (!obtenido) return;
+    std::lock_guard<std::mutex> guarda(mutexDeBloqueos());
+    auto entrada = bloqueosDelProceso().find(ruta);
+    if (entrada == bloqueosDelProceso().end() || --entrada->second > 0) return;
+    bloqueosDelProceso().erase(entrada);
+#if defined(SISTEMA_POSIX)
+    if (descriptor >= 0) ::close(descriptor); // close() libera el flock()
+#endif
 }
 
+/// Se combina con la longitud confirmada para detectar un marcador dañado o a medio escribir
+const uint64_t CONTROL_DE_LONGITUD = 0x52434f4d504c454eull;
+
 /**
- * @brief Muestra el menú de parámetros de búsqueda disponibles
+ * @brief Guarda en el archivo ".lock" la longitud del registro tras una escritura completa
+ * 
+ * @param nombreArchivo Ruta del registro
+ * @param longitud Bytes del registro que forman bloques completos y confirmados
  * 
  * @details
- * Presenta un menú formateado con las diferentes opciones para buscar componentes:
+ * Se llama con el bloqueo tomado, después de escribir (y sincronizar, según
+ * la política) un lote completo. Escribe 16 bytes en el inicio del archivo
+ * ".lock": la longitud y la longitud combinada con CONTROL_DE_LONGITUD, para
+ * que un lector que lo lea a medio actualizar lo descarte.
  * 
- * ============================
- * (1) Nombre
- * (2) Tipo
- * (3) Valor nominal
- * (4) Tolerancia  
- * (5) Voltaje de trabajo
- * (6) Estado
- * (7) Salir
- * Elija el parámetro de búsqueda a utilizar:
- * ============================
+ * @pre El proceso tiene el bloqueoDeRegistro del registro
+ */
+void registrarLongitudConfirmada(const std::string& nombreArchivo, uint64_t longitud){
+#if defined(SISTEMA_POSIX)
+    int descriptor = ::open(rutaDeBloqueo(nombreArchivo).c_str(), O_WRONLY | O_CREAT, 0644);
+    if (descriptor < 0) return;
+    const uint64_t marcador[2] = {longitud, longitud ^ CONTROL_DE_LONGITUD};
+    ssize_t escritos = ::pwrite(descriptor, marcador, sizeof(marcador), 0);
+    (void)escritos; // Sin marcador válido los lectores recortan al último bloque completo
+    ::close(descriptor);
+#else
+    (void)nombreArchivo;
+    (void)longitud;
+#endif
+}
+
+/**
+ * @brief Calcula hasta dónde puede leer un lector sin ver escrituras a medias
  * 
- * Cada opción corresponde a un campo específico de la estructura 'componente'.
+ * @param nombreArchivo Ruta del registro de texto
+ * @param datos Contenido proyectado del registro
+ * @param tamano Bytes proyectados
+ * @return uint64_t Longitud de la instantánea (siempre termina en un bloque completo)
  * 
- * @post Genera salida estándar con el menú formateado
- * @post No modifica ningún estado del programa
+ * @details
+ * 1. Si un escritor tiene el bloqueo (un flock() compartido sin espera
+ *    falla), la instantánea termina en la longitud confirmada del archivo
+ *    ".lock": ni un lote a medias ni la mitad de una modificación (componente
+ *    nuevo sin la lápida del anterior) quedan visibles
+ * 2. Sin escritor activo, sin marcador válido o si el escritor es este mismo
+ *    proceso (que ya terminó sus escrituras), se usa el archivo completo
+ * 3. En ambos casos se recorta al final del último bloque completo con
+ *    finDelUltimoBloque(), lo que también protege de escritores que no usan
+ *    el bloqueo y de un lote que quedó a medias porque el proceso terminó
+ * 
+ * El lector no retiene el bloqueo compartido: lo suelta en cuanto comprueba
+ * que está libre, así que nunca hace esperar a un escritor.
+ */
+uint64_t longitudConfirmada(const std::string& nombreArchivo, const char* datos, uint64_t tamano){
+    uint64_t limite = tamano;
+#if defined(SISTEMA_POSIX)
+    int descriptor = bloqueoDeRegistro::tomadoPorEsteProceso(nombreArchivo) ? -1 : ::open(rutaDeBloqueo(nombreArchivo).c_str(), O_RDONLY);
+    if (descriptor >= 0) {
+        const bool escritorActivo = ::flock(descriptor, LOCK_SH | LOCK_NB) != 0 && errno == EWOULDBLOCK;
+        if (escritorActivo) {
+            uint64_t marcador[2];
+            if (::pread(descriptor, marcador, sizeof(marcador), 0) == static_cast<ssize_t>(sizeof(marcador))
+                && (marcador[0] ^ CONTROL_DE_LONGITUD) == marcador[1]) {
+                limite = std::min(limite, marcador[0]);
+            }
+        }
+        ::close(descriptor); // Suelta el flock() compartido si se obtuvo
+    }
+#else
+    (void)nombreArchivo;
+#endif
+    return finDelUltimoBloque(datos, limite);
+}
+
+/**
+ * @brief Elimina del final de un registro de texto un bloque que quedó a medio escribir
  * 
- * @note
- * - Diseñado para usarse con buscarPorParametro()
- * - Las opciones 1-6 corresponden a campos de búsqueda
- * - La opción 7 permite salir sin buscar
- * - Los separadores "===" mejoran la legibilidad
+ * @param nombreArchivo Ruta del registro de texto
+ * @return uint64_t Tamaño del registro después de repararlo
  * 
- * @see buscarPorParametro() Para el procesamiento de la selección
- * @see componente Para la estructura de datos relacionada
+ * @details
+ * Si un escritor terminó a mitad de un lote, el registro acaba en un
+ * fragmento sin separador que los lectores ya ignoran; pero un componente
+ * añadido a continuación se fundiría con ese fragmento y se perdería como
+ * bloque dañado. Por eso, antes de añadir, los escritores truncan el
+ * fragmento posterior a la última línea "-----" (y completan el salto de
+ * línea si el archivo acaba en "-----" sin él). Solo examina los últimos
+ * 64 KiB: si ahí no hay ningún separador, o hay bytes nulos, el archivo no
+ * parece un registro de texto y no se toca.
+ * 
+ * @pre El proceso tiene el bloqueoDeRegistro del registro
+ * @post Muestra cuántos bytes se descartaron, si hubo que hacerlo
  */
-void menuParametro(){
-    std::cout << "\n============================\n";
-    std::cout<<"(1) Nombre. \n";
-    std::cout<<"(2) Tipo. \n";
-    std::cout<<"(3) Valor nominal. \n";
-    std::cout<<"(4) Tolerancia. \n";
-    std::cout<<"(5) Voltaje de trabajo. \n";
-    std::cout<<"(6) Estado  \n";
-    std::cout<<"(7) Salir  \n";
-    std::cout<<"Elija el parámetro de búsqueda a utilizar: \n";
-    std::cout << "\n============================\n";
+uint64_t descartarColaIncompleta(const std::string& nombreArchivo){
+    const uint64_t tamano = tamanoDeArchivo(nombreArchivo);
+#if defined(SISTEMA_POSIX)
+    const uint64_t ventana = std::min<uint64_t>(tamano, 64 * 1024);
+    if (ventana == 0) return tamano;
+    int descriptor = ::open(nombreArchivo.c_str(), O_RDWR);
+    if (descriptor < 0) return tamano;
+    std::string cola(ventana, '\0');
+    uint64_t reparado = tamano;
+    if (::pread(descriptor, cola.data(), ventana, static_cast<off_t>(tamano - ventana)) == static_cast<ssize_t>(ventana)
+        && cola.find('\0') == std::string::npos) {
+        const uint64_t fin = finDelUltimoBloque(cola.data(), ventana);
+        if (fin == ventana && cola.back() != '\n') {
+            if (::pwrite(descriptor, "\n", 1, static_cast<off_t>(tamano)) == 1) reparado = tamano + 1;
+        } else if (fin > 0 && fin < ventana) {
+            reparado = tamano - ventana + fin;
+            if (::ftruncate(descriptor, static_cast<off_t>(reparado)) == 0) {
+                std::cout << "Se descartaron " << tamano - reparado << " bytes de una escritura interrumpida al final de '"
+                          << nombreArchivo << "'.\n";
+            } else {
+                reparado = tamano;
+            }
+        }
+    }
+    ::close(descriptor);
+    return reparado;
+#else
+    return tamano;
+#endif
 }
 
 /**
- * @brief Muestra los detalles de un componente electrónico en formato legible
+ * @brief Añade un componente al final de un archivo existente
  * 
- * @param c Componente a mostrar (referencia constante)
+ * @param x Componente a serializar y añadir
+ * @param nombreArchivo Ruta del archivo destino (debe existir y tener extensión .txt)
  * 
  * @details
- * Esta función despliega todos los campos de un componente en un formato consistente:
+ * Esta función implementa escritura al final (append) de archivos para componentes,
+ * manteniendo el mismo formato que escribirComponente():
  * 
  * --------------------------
- * Componente encontrado:
- * Nombre: [nombreDelComponente]
- * Tipo: [tipoDeComponente]  
- * Valor nominal: [valorNominal]
- * Tolerancia: [tolerancia]%
- * Voltaje: [voltajeDeTrabajo]V
- * Estado: [estado]
+ * NombreComponente
+ * TipoComponente
+ * ValorNominal
+ * Tolerancia
+ * VoltajeTrabajo
+ * Estado
  * -----
  * --------------------------
  * 
- * @post Genera salida estándar con el formato especificado
- * @post No modifica el componente recibido
+ * El modo std::ios::app garantiza que:
+ * - Los nuevos datos se añaden después del último componente
+ * - No se modifica el contenido existente
+ * - Crea el archivo si no existe
  * 
- * @note
- * - Formato diseñado para máxima legibilidad
- * - Incluye unidades donde es relevante (% y V)
- * - Separador "-----" al final para delimitar visualmente
- * - Campos alineados verticalmente para fácil escaneo
+ * @post El componente se añade al final del archivo, con el bloqueoDeRegistro tomado
+ * @post Preserva todos los componentes existentes
+ * @post Los índices del archivo (".idx", ".tri") que estén al día reciben el nuevo bloque
+ * @post Muestra error si falla la apertura
  * 
- * @par Ejemplo de salida:
+ * @par Ejemplo de uso:
  * @code
- * Componente encontrado:
- * Nombre: Resistor 1kΩ
- * Tipo: Resistor de carbón
- * Valor nominal: 1000
- * Tolerancia: 5%
- * Voltaje: 12.5V  
- * Estado: Nuevo
- * -----
+ * componente c;
+ * // ... inicializar c ...
+ * continuarConArchivo(c, "componentes.txt");
  * @endcode
  * 
- * @see componente Para la estructura de datos mostrada
- * @see buscarPorNombre() Como una de las funciones que usa esta visualización
+ * @throw Ninguno (errores se manejan con mensajes a stdout)
+ * 
+ * @see guardarSesion() Para escribir un registro completo
+ * @see cargarDesdeArchivo() Para leer este formato
+ * @see std::ofstream::app Para detalles del modo append
  */
-void mostrarComponente(const componente& c) {
-    std::cout<< "\nComponente encontrado:\n";
-    std::cout<< "Nombre: " << c.nombreDelComponente << "\n";
-    std::cout<< "Tipo: " << c.tipoDeComponente << "\n";
-    std::cout<< "Valor nominal: " << c.valorNominal << "\n";
-    std::cout<< "Tolerancia: " << c.tolerancia << "%\n";
-    std::cout<< "Voltaje: " << c.voltajeDeTrabajo << "V\n";
-    std::cout<< "Estado: " << c.estado << "\n";
-    std::cout<< "-----\n";
+void continuarConArchivo(const componente& x, const std::string& nombreArchivo){
+    cronometroDeEtapa cronometro(etapaMedida::escritura);
+    bloqueoDeRegistro bloqueo(nombreArchivo);
+    const uint64_t desplazamiento = descartarColaIncompleta(nombreArchivo);
+    std::ofstream archivo(nombreArchivo, std::ios::app);
+    if (archivo.is_open())
+    {
+        escribirComponente(archivo, x);
+        archivo.close();
+        const uint64_t nuevoTamano = tamanoDeArchivo(nombreArchivo);
+        registrarLongitudConfirmada(nombreArchivo, nuevoTamano);
+        contarEstadistica(contadorMedido::bytesEscritos, nuevoTamano - desplazamiento);
+        actualizarIndices(nombreArchivo, x, desplazamiento, nuevoTamano);
+    }
+    else{
+        std::cout<<"No se pudo abrir el archivo para guardar \n";
+    }
 }
 
+#if defined(SISTEMA_POSIX)
 /**
- * @brief Busca componentes por coincidencia parcial de nombre
+ * @brief Escribe todos los bytes en un descriptor, reintentando escrituras parciales e interrumpidas
  * 
- * @param registros Vector de componentes donde buscar (referencia constante)
+ * @param descriptor Descriptor abierto para escritura
+ * @param datos Bytes a escribir
+ * @return false si write() falló
+ */
+bool escribirCompleto(int descriptor, const std::string& datos){
+    const char* p = datos.data();
+    size_t restantes = datos.size();
+    while (restantes > 0) {
+        ssize_t escritos = ::write(descriptor, p, restantes);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += escritos;
+        restantes -= static_cast<size_t>(escritos);
+    }
+    return true;
+}
+#endif
+
+/**
+ * @enum politicaDeDurabilidad
+ * @brief Cuándo fuerza escritorDeRegistro los datos al disco con fsync()
+ */
+enum class politicaDeDurabilidad
+{
+    sinSincronizar,        ///< Nunca; los datos quedan en la caché del sistema operativo
+    sincronizarPorLote,    ///< Un fsync() después de escribir cada lote
+    sincronizarPorRegistro ///< Cada componente se escribe y se sincroniza por separado
+};
+
+/**
+ * @class escritorDeRegistro
+ * @brief Escritor de larga duración que añade componentes a un registro de texto por lotes
  * 
  * @details
- * Esta función implementa una búsqueda case-sensitive de subcadenas en los nombres:
- * 1. Solicita al usuario el texto a buscar mediante solicitarTexto()
- * 2. Recorre todos los componentes comparando nombres
- * 3. Muestra cada coincidencia usando mostrarComponente()
- * 4. Informa cuando no encuentra resultados
- * 
- * La comparación es por coincidencia parcial (subcadena):
- * - "res" encontrará "Resistor 10kΩ" y "RESISTOR 1MΩ"
- * - Búsqueda exacta requiere ingresar el nombre completo
- * 
- * @post Muestra por pantalla todos los componentes coincidentes
- * @post No modifica el vector de registros
- * 
- * @throw Ninguno (errores manejados internamente)
+ * continuarConArchivo() abre el archivo, escribe un componente y lo cierra:
+ * al registrar miles de componentes eso son miles de open/write/close. Este
+ * escritor abre el archivo una vez, serializa los componentes en un búfer
+ * con escribirComponente() y lo vuelca con una sola escritura cuando reúne
+ * 'registrosPorLote' componentes (confirmación en grupo), al llamar a
+ * vaciar() o al destruirse.
+ * 
+ * Cada volcado actualiza también los índices del registro (".idx", ".tri")
+ * que estuvieran al día, abriéndolos una vez por lote.
+ * 
+ * Cada volcado se hace con el bloqueoDeRegistro tomado y termina registrando
+ * la longitud confirmada, así que varios escritores (en otras terminales) se
+ * turnan lote a lote y los lectores nunca ven un lote a medias. Entre lotes
+ * el bloqueo queda libre: una sesión interactiva larga no detiene a los demás.
+ * Como otro proceso puede haber añadido o compactado el registro entre dos
+ * lotes, la posición de cada bloque se calcula al volcar y no al agregar.
+ * 
+ * anular() añade al mismo lote una lápida (ver escribirLapida()); modificar
+ * un componente es agregar() su versión nueva y después anular() la anterior,
+ * de modo que una interrupción entre ambas deja el componente duplicado en
+ * lugar de perdido.
+ * 
+ * La durabilidad se elige con politicaDeDurabilidad. Con
+ * sincronizarPorRegistro cada componente forma su propio lote.
+ * 
+ * @warning Fuera de sistemas POSIX no hay fsync(): las políticas que
+ *          sincronizan solo vacían el búfer de la biblioteca estándar
  * 
  * @par Ejemplo de uso:
  * @code
- * vector<componente> inventario = {...};
- * buscarPorNombre(inventario);
- * // Usuario ingresa: "10k"
- * // Muestra todos los componentes con "10k" en su nombre
+ * escritorDeRegistro escritor("inventario.txt", politicaDeDurabilidad::sincronizarPorLote);
+ * for (const componente& c : catalogo) escritor.agregar(c);
+ * escritor.vaciar(); // o al salir de ámbito
  * @endcode
  * 
- * @note
- * - Sensible a mayúsculas/minúsculas (case-sensitive)
- * - Muestra múltiples coincidencias si existen
- * - Usa string::find() para búsqueda parcial
+ * @see compararEscritura()
+ */
+class escritorDeRegistro
+{
+public:
+    escritorDeRegistro(const std::string& nombreArchivo, politicaDeDurabilidad politica = politicaDeDurabilidad::sinSincronizar,
+                       size_t registrosPorLote = 4096, std::ostream& avisos = std::cout);
+    ~escritorDeRegistro();
+    escritorDeRegistro(const escritorDeRegistro&) = delete;
+    escritorDeRegistro& operator=(const escritorDeRegistro&) = delete;
+
+    bool abierto() const { return descriptorValido; } ///< true si el archivo se pudo abrir
+    bool agregar(const componente& x);
+    bool anular(uint64_t desplazamiento);
+    bool vaciar();
+    uint64_t escritos() const { return totalEscritos; } ///< Componentes ya volcados al archivo
+
+private:
+    bool escribirTodo(const std::string& datos);
+    bool reabrirSiFueReemplazado();
+
+    std::string nombreArchivo;
+    politicaDeDurabilidad politica;
+    size_t registrosPorLote;
+    std::ostream* avisos; ///< Destino de los mensajes de error
+#if defined(SISTEMA_POSIX)
+    int descriptor{-1};
+#else
+    std::ofstream archivo;
+#endif
+    bool descriptorValido{false};
+    std::ostringstream bufer;
+    std::vector<componente> pendientes;
+    std::vector<uint64_t> desplazamientos; ///< Inicio de cada bloque dentro de 'bufer'
+    size_t lapidasPendientes{0};
+    uint64_t totalEscritos{0};
+};
+
+/**
+ * @brief Abre (o crea) el registro en modo de añadir
  * 
- * @see solicitarTexto() Para la entrada del usuario
- * @see mostrarComponente() Para el formato de visualización
+ * @param nombreArchivo Ruta del registro de texto
+ * @param politica Cuándo sincronizar con el disco
+ * @param registrosPorLote Componentes por volcado (se ignora con sincronizarPorRegistro)
+ * @param avisos Flujo para los mensajes de error (el servidor los envía al cliente)
+ * 
+ * @post Muestra un mensaje de error si no se pudo abrir el archivo
  */
-void buscarPorNombre(const std::vector<componente>& registros){
-    std::string nombreComponente=solicitarTexto("Ingrese el nombre del componente que desea encontrar \n");
-    bool encontrado{false};
-    for (const auto& c : registros)
-    {
-        if (c.nombreDelComponente.find(nombreComponente)!=std::string::npos)
-        {
-            mostrarComponente(c);
-            encontrado = true;
-        }
-    }
-    if (encontrado==false)
-    {
-        std::cout << "No se encontró ningún componente con ese nombre.\n";
+escritorDeRegistro::escritorDeRegistro(const std::string& nombreArchivo, politicaDeDurabilidad politica, size_t registrosPorLote,
+                                       std::ostream& avisos)
+    : nombreArchivo(nombreArchivo), politica(politica),
+      registrosPorLote(politica == politicaDeDurabilidad::sincronizarPorRegistro ? 1 : std::max<size_t>(1, registrosPorLote)),
+      avisos(&avisos){
+#if defined(SISTEMA_POSIX)
+    descriptor = ::open(nombreArchivo.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    descriptorValido = descriptor >= 0;
+#else
+    archivo.open(nombreArchivo, std::ios::app | std::ios::binary);
+    descriptorValido = archivo.is_open();
+#endif
+    if (!descriptorValido) {
+        avisos << "No se pudo abrir el archivo para guardar \n";
+        return;
     }
+    pendientes.reserve(this->registrosPorLote);
+    desplazamientos.reserve(this->registrosPorLote);
 }
 
 /**
- * @brief Busca componentes por coincidencia parcial en el tipo
+ * @brief Vuelca lo pendiente y cierra el archivo
+ */
+escritorDeRegistro::~escritorDeRegistro(){
+    if (!descriptorValido) return;
+    vaciar();
+#if defined(SISTEMA_POSIX)
+    ::close(descriptor);
+#endif
+}
+
+/**
+ * @brief Serializa un componente en el búfer y vuelca el lote si está completo
  * 
- * @param registros Vector de componentes donde buscar (referencia constante)
+ * @param x Componente a añadir
+ * @return false si el archivo no está abierto o falló el volcado
+ */
+bool escritorDeRegistro::agregar(const componente& x){
+    if (!descriptorValido) return false;
+    desplazamientos.push_back(static_cast<uint64_t>(bufer.tellp()));
+    escribirComponente(bufer, x);
+    pendientes.push_back(x);
+    if (pendientes.size() + lapidasPendientes >= registrosPorLote) return vaciar();
+    return true;
+}
+
+/**
+ * @brief Añade al lote una lápida que anula el bloque que empieza en 'desplazamiento'
  * 
- * @details
- * Implementa búsqueda de subcadena case-sensitive en el campo tipoDeComponente:
+ * @param desplazamiento Inicio del bloque del componente a borrar
+ * @return false si el archivo no está abierto o falló el volcado
  * 
- * 1. Solicita el tipo a buscar usando solicitarTexto()
- * 2. Recorre todos los componentes comparando tipos
- * 3. Muestra coincidencias con mostrarComponente()
- * 4. Informa si no hay resultados
+ * @see escribirLapida()
+ */
+bool escritorDeRegistro::anular(uint64_t desplazamiento){
+    if (!descriptorValido) return false;
+    escribirLapida(bufer, desplazamiento);
+    lapidasPendientes++;
+    if (pendientes.size() + lapidasPendientes >= registrosPorLote) return vaciar();
+    return true;
+}
+
+/**
+ * @brief Escribe el lote pendiente con una sola llamada, lo sincroniza según la política y actualiza los índices
  * 
- * La comparación es por subcadena:
- * - "cap" encontrará "Capacitor" y "CAPACITOR"
- * - Coincidencia en cualquier posición del texto
+ * @return false si la escritura o la sincronización fallaron
  * 
- * @post Muestra componentes con tipos coincidentes
- * @post No modifica el vector original
+ * @details
+ * Con el bloqueoDeRegistro tomado: vuelve a abrir el registro si otro proceso
+ * lo reemplazó, descarta un fragmento a medio escribir con
+ * descartarColaIncompleta(), escribe el lote, registra la nueva longitud
+ * confirmada y actualiza los índices.
+ */
+bool escritorDeRegistro::vaciar(){
+    if (!descriptorValido || (pendientes.empty() && lapidasPendientes == 0)) return descriptorValido;
+    const std::string datos = bufer.str();
+    bufer.str("");
+    lapidasPendientes = 0;
+
+    bloqueoDeRegistro bloqueo(nombreArchivo);
+    const uint64_t tamanoPrevio = reabrirSiFueReemplazado() ? descartarColaIncompleta(nombreArchivo) : 0;
+    if (!descriptorValido || !escribirTodo(datos)) {
+        *avisos << "Error al escribir en '" << nombreArchivo << "'.\n";
+        pendientes.clear();
+        desplazamientos.clear();
+        return false;
+    }
+    const uint64_t nuevoTamano = tamanoPrevio + datos.size();
+    registrarLongitudConfirmada(nombreArchivo, nuevoTamano);
+    for (uint64_t& desplazamiento : desplazamientos) desplazamiento += tamanoPrevio;
+    totalEscritos += pendientes.size();
+    actualizarIndices(nombreArchivo, tamanoPrevio, pendientes, desplazamientos, nuevoTamano);
+    pendientes.clear();
+    desplazamientos.clear();
+    return true;
+}
+
+/**
+ * @brief Vuelve a abrir el registro si la ruta ya no apunta al archivo abierto
  * 
- * @throw Ninguno (errores manejados internamente)
+ * @return false si no se pudo volver a abrir
  * 
- * @par Ejemplo:
- * @code
- * vector<componente> inventario = {...};
- * buscarPorTipo(inventario);
- * // Usuario ingresa: "resis"
- * // Muestra resistores con cualquier valor
- * @endcode
+ * @details guardarSesion(), compactarRegistro() y eliminarContenidoArchivo() reemplazan el registro con
+ * rename(): el descriptor abierto seguiría añadiendo al archivo anterior, que
+ * ya no tiene nombre. Compara el dispositivo y el inodo del descriptor con los
+ * de la ruta.
  * 
- * @note 
- * - Sensible a mayúsculas/minúsculas
- * - Muestra múltiples coincidencias
- * - Usa string::find() para búsqueda parcial
+ * @pre El proceso tiene el bloqueoDeRegistro del registro
+ */
+bool escritorDeRegistro::reabrirSiFueReemplazado(){
+#if defined(SISTEMA_POSIX)
+    struct stat abierto, actual;
+    if (::fstat(descriptor, &abierto) == 0 && ::stat(nombreArchivo.c_str(), &actual) == 0
+        && abierto.st_dev == actual.st_dev && abierto.st_ino == actual.st_ino) {
+        return true;
+    }
+    ::close(descriptor);
+    descriptor = ::open(nombreArchivo.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    descriptorValido = descriptor >= 0;
+#endif
+    return descriptorValido;
+}
+
+/**
+ * @brief Escribe todos los bytes (reintentando escrituras parciales) y aplica fsync() si corresponde
+ */
+bool escritorDeRegistro::escribirTodo(const std::string& datos){
+    cronometroDeEtapa cronometro(etapaMedida::escritura);
+    contarEstadistica(contadorMedido::bytesEscritos, datos.size());
+#if defined(SISTEMA_POSIX)
+    if (!escribirCompleto(descriptor, datos)) return false;
+    if (politica != politicaDeDurabilidad::sinSincronizar && ::fsync(descriptor) != 0) return false;
+    return true;
+#else
+    archivo.write(datos.data(), static_cast<std::streamsize>(datos.size()));
+    archivo.flush();
+    return static_cast<bool>(archivo);
+#endif
+}
+
+/**
+ * @brief Reemplaza un archivo completo de forma atómica: temporal, fsync() y rename()
  * 
- * @see solicitarTexto() Para entrada validada
- * @see mostrarComponente() Para formato de visualización
+ * @param nombreArchivo Archivo que se reemplaza (o se crea)
+ * @param escribir Función que recibe el std::ostream del temporal y escribe todo el contenido
+ * @return true si el destino quedó reemplazado; si no, el destino no cambia y el temporal se elimina
+ * 
+ * @details
+ * El contenido se escribe en "<nombreArchivo>.tmp", se sincroniza con fsync()
+ * y se renombra sobre el destino con std::filesystem::rename(), que en POSIX
+ * es atómico: quien abra el archivo ve el anterior completo o el nuevo
+ * completo. Quien ya lo tenga proyectado con mmap() conserva el inodo
+ * anterior, que nunca se trunca, así que no recibe SIGBUS.
+ * 
+ * @pre El proceso tiene el bloqueoDeRegistro del archivo, si es un registro
  */
-void buscarPorTipo(const std::vector<componente>& registros){
-    std::string tipo=solicitarTexto("Ingrese el tipo del componente que desea encontrar \n");
-    bool encontrado{false};
-    for (const auto& c : registros)
+template<class Funcion>
+bool reemplazarArchivo(const std::string& nombreArchivo, Funcion escribir){
+    const std::string temporal = nombreArchivo + ".tmp";
+    bool escrito = false;
     {
-        if (c.tipoDeComponente.find(tipo)!=std::string::npos)
-        {
-            mostrarComponente(c);
-            encontrado = true;
+        std::ofstream archivo(temporal, std::ios::binary | std::ios::trunc);
+        if (archivo.is_open()) {
+            escribir(archivo);
+            archivo.close();
+            escrito = !archivo.fail();
         }
     }
-    if (encontrado==false)
-    {
-        std::cout << "No se encontró ningún componente de ese tipo.\n";
+#if defined(SISTEMA_POSIX)
+    if (escrito) {
+        const int descriptor = ::open(temporal.c_str(), O_RDONLY);
+        escrito = descriptor >= 0 && ::fsync(descriptor) == 0;
+        if (descriptor >= 0) ::close(descriptor);
+    }
+#endif
+
+    std::error_code error;
+    if (escrito) std::filesystem::rename(temporal, nombreArchivo, error);
+    if (!escrito || error) {
+        std::filesystem::remove(temporal, error);
+        return false;
     }
+    return true;
 }
 
 /**
- * @brief Busca componentes por valor nominal exacto
+ * @brief Guarda todos los componentes de una sesión de "Nuevo registro" de forma atómica
  * 
- * @param registros Vector de componentes donde buscar (referencia constante)
+ * @param registros Componentes registrados durante la sesión, en orden
+ * @param nombreArchivo Registro de texto de destino (se reemplaza)
+ * @return true si el archivo quedó reemplazado por el contenido completo
  * 
  * @details
- * Realiza una búsqueda exacta por valor numérico en el campo valorNominal:
- * 
- * 1. Solicita el valor a buscar usando solicitarNumero()
- * 2. Compara usando igualdad exacta (==)
- * 3. Muestra coincidencias con mostrarComponente()
- * 4. Informa si no hay resultados
- * 
- * @post Muestra componentes con valores nominales idénticos
- * @post No modifica el vector original
+ * 1. Serializa todo el vector con escribirComponente() en una sola pasada
+ * 2. Lo publica con reemplazarArchivo(): lo escribe en "<nombreArchivo>.tmp",
+ *    lo sincroniza con fsync() y lo renombra sobre el destino, lo que en
+ *    POSIX reemplaza el archivo de forma atómica
  * 
- * @warning
- * - Comparación exacta puede omitir valores equivalentes
- * - Problemas potenciales con precisión de floats
- * 
- * @par Ejemplo:
- * @code
- * vector<componente> inventario = {...};
- * buscarPorValorNominal(inventario);
- * // Usuario ingresa: 1000
- * // Muestra componentes con valor exacto 1000
- * @endcode
+ * Quien lea el registro ve el archivo anterior completo o el nuevo completo,
+ * nunca uno a medio escribir; si algo falla, el destino no se modifica y el
+ * temporal se elimina. Todo se hace con el bloqueoDeRegistro tomado, para que
+ * ningún otro escritor añada al archivo que está a punto de reemplazarse.
  * 
- * @note 
- * - Para búsqueda por rango usar buscarPorParametro()
- * - Considerar margen de error para valores float
+ * @post Elimina los índices (".idx", ".tri") del archivo, que quedan obsoletos
+ * @post Muestra un mensaje de error si no se pudo escribir o renombrar
  * 
- * @see solicitarNumero() Para entrada validada
- * @see mostrarComponente() Para formato de visualización
+ * @see iniciarRegistro()
  */
-void buscarPorValorNominal(const std::vector<componente>& registros){
-    float valor=solicitarNumero("Ingrese el valor nominal del componente que desea encontrar \n");
-    bool encontrado{false};
-    for (const auto& c : registros)
-    {
-        if (c.valorNominal==valor)
-        {
-            mostrarComponente(c);
-            encontrado = true;
-        }
+bool guardarSesion(const std::vector<componente>& registros, const std::string& nombreArchivo){
+    cronometroDeEtapa cronometro(etapaMedida::escritura);
+    std::ostringstream contenido;
+    for (const componente& x : registros) escribirComponente(contenido, x);
+    const std::string datos = contenido.str();
+
+    bloqueoDeRegistro bloqueo(nombreArchivo);
+    if (!reemplazarArchivo(nombreArchivo, [&datos](std::ostream& salida) {
+            salida.write(datos.data(), static_cast<std::streamsize>(datos.size()));
+        })) {
+        std::cout << "No se pudo abrir el archivo para guardar \n";
+        return false;
     }
-    if (encontrado==false)
-        {
-            std::cout << "No se encontró ningún componente con ese valor nominal.\n";
-        }
+    registrarLongitudConfirmada(nombreArchivo, datos.size());
+    contarEstadistica(contadorMedido::bytesEscritos, datos.size());
+    descartarIndices(nombreArchivo);
+    return true;
 }
 
 /**
- * @brief Busca componentes por valor exacto de tolerancia
- * 
- * @param registros Vector de componentes donde buscar (referencia constante)
+ * @struct cabeceraBinaria
+ * @brief Cabecera fija del formato binario columnar de registros (versión 1)
  * 
  * @details
- * Realiza una búsqueda exacta por el porcentaje de tolerancia:
+ * Un archivo binario de componentes tiene la siguiente disposición:
  * 
- * 1. Solicita el valor de tolerancia mediante solicitarNumero()
- * 2. Compara usando igualdad exacta (==) con el campo tolerancia
- * 3. Muestra coincidencias usando mostrarComponente()
- * 4. Informa si no encuentra resultados
- * 
- * @post Muestra componentes con tolerancias idénticas
- * @post No modifica el vector original
- * 
- * @warning
- * - La comparación es exacta (puede omitir valores cercanos)
- * - Problemas potenciales con precisión de punto flotante
- * - La tolerancia debe ingresarse como porcentaje (ej: 5 para 5%)
+ * --------------------------
+ * cabeceraBinaria                       (64 bytes)
+ * float valorNominal[cantidad]          (columna)
+ * float tolerancia[cantidad]            (columna)
+ * float voltajeDeTrabajo[cantidad]      (columna)
+ * uint64_t desplazamientos[3*cantidad+1] (índice del montículo de cadenas)
+ * char montículo[tamanoMonticulo]       (nombre, tipo y estado concatenados)
+ * --------------------------
  * 
- * @par Ejemplo de uso:
- * @code
- * vector<componente> inventario = {...};
- * buscarPorTolerancia(inventario);
- * // Usuario ingresa: 5
- * // Muestra componentes con ±5% de tolerancia
- * @endcode
+ * Las cadenas del registro i ocupan las posiciones 3*i (nombre), 3*i+1 (tipo)
+ * y 3*i+2 (estado) del índice; cada una termina donde empieza la siguiente,
+ * por lo que el índice tiene una entrada extra al final.
  * 
  * @note
- * - Para resistores, valores comunes son: 1%, 5%, 10%
- * - Para capacitores, típicamente 10%, 20%
- * - Considerar implementar búsqueda por rango
+ * - Todos los enteros y flotantes se guardan en el orden de bytes de la máquina
+ *   (little-endian en x86/ARM), sin conversión
+ * - Los desplazamientos de la cabecera son absolutos desde el inicio del archivo
  * 
- * @see solicitarNumero() Para entrada validada
- * @see mostrarComponente() Para formato de visualización
- * @see buscarPorParametro() Para búsqueda parametrizada
+ * @see guardarEnBinario()
+ * @see cargarDesdeBinario()
  */
-void buscarPorTolerancia(const std::vector<componente>& registros){
-    float toleranciaBuscada=solicitarNumero("Ingrese la tolerancia del componente que desea encontrar \n");
-    bool encontrado{false};
-    for (const auto& c : registros)
-    {
-        if (c.tolerancia==toleranciaBuscada)
-        {
-            mostrarComponente(c);
-            encontrado = true;
-        }
-    }
-    if (encontrado==false)
-        {
-            std::cout << "No se encontró ningún componente con esa tolerancia.\n";
-        }
-}
+struct cabeceraBinaria
+{
+    char magia[8]; ///< Siempre "RCOMPBIN"
+    uint32_t version{0}; ///< Versión del formato (actualmente 1)
+    uint32_t reservado{0}; ///< Sin uso, debe ser 0
+    uint64_t cantidad{0}; ///< Número de componentes almacenados
+    uint64_t inicioValorNominal{0}; ///< Desplazamiento de la columna valorNominal
+    uint64_t inicioTolerancia{0}; ///< Desplazamiento de la columna tolerancia
+    uint64_t inicioVoltaje{0}; ///< Desplazamiento de la columna voltajeDeTrabajo
+    uint64_t inicioIndiceCadenas{0}; ///< Desplazamiento del índice de cadenas
+    uint64_t inicioMonticulo{0}; ///< Desplazamiento del montículo de cadenas
+};
+
+const char MAGIA_BINARIA[8] = {'R','C','O','M','P','B','I','N'}; ///< Firma de los archivos binarios
+const uint32_t VERSION_BINARIA = 1; ///< Versión del formato que escribe este programa
 
 /**
- * @brief Busca componentes por voltaje de trabajo exacto
+ * @brief Detecta si un archivo está en el formato binario columnar
  * 
- * @param registros Vector de componentes donde buscar (referencia constante)
+ * @param nombreArchivo Ruta del archivo a inspeccionar
+ * @return true si los primeros 8 bytes coinciden con la firma "RCOMPBIN"
  * 
  * @details
- * Realiza una búsqueda exacta por el voltaje de trabajo especificado:
+ * Solo lee la firma; no valida el resto de la cabecera. Un archivo de texto
+ * nunca empieza con esta firma a menos que el primer componente se llame
+ * literalmente "RCOMPBIN...", caso que se considera inválido.
  * 
- * 1. Solicita el voltaje mediante solicitarNumero()
- * 2. Compara usando igualdad exacta (==) con el campo voltajeDeTrabajo
- * 3. Muestra coincidencias con mostrarComponente()
- * 4. Informa si no hay resultados
+ * @see registroEnArena::cargar() Para la carga con detección automática
+ */
+bool esArchivoBinario(const std::string& nombreArchivo){
+    std::ifstream archivo(nombreArchivo, std::ios::binary);
+    char firma[8];
+    if (!archivo.read(firma, sizeof(firma))) return false;
+    return std::memcmp(firma, MAGIA_BINARIA, sizeof(firma)) == 0;
+}
+
+/**
+ * @brief Guarda un vector de componentes en el formato binario columnar
  * 
- * @post Muestra componentes con voltajes idénticos
- * @post No modifica el vector original
+ * @param registros Componentes a guardar
+ * @param nombreArchivo Ruta del archivo destino (se sobrescribe)
+ * @return true si el archivo se escribió completo
  * 
- * @warning
- * - La comparación es exacta (puede omitir valores cercanos)
- * - Problemas potenciales con precisión de punto flotante
- * - El voltaje debe ingresarse en voltios (ej: 12.5)
+ * @details
+ * Construye primero el montículo de cadenas y su índice de desplazamientos en
+ * memoria y después escribe la cabecera, las tres columnas de flotantes, el
+ * índice y el montículo con una escritura por sección.
  * 
- * @par Ejemplo de uso:
- * @code
- * vector<componente> inventario = {...};
- * buscarPorVoltaje(inventario);
- * // Usuario ingresa: 12
- * // Muestra componentes para 12V exactos
- * @endcode
+ * El archivo se publica con reemplazarArchivo() y con el bloqueoDeRegistro
+ * tomado: un fallo a mitad de escritura deja el archivo anterior intacto, y
+ * los lectores que lo tienen proyectado siguen viendo el anterior completo.
  * 
- * @note
- * - Valores típicos: 3.3V, 5V, 12V, 24V, etc.
- * - Para capacitores: voltaje máximo soportado
- * - Para reguladores: voltaje de salida
+ * @post El archivo contiene exactamente registros.size() componentes
+ * @post Muestra un mensaje de error si no puede escribir; el destino no cambia
  * 
- * @see solicitarNumero() Para entrada validada
- * @see mostrarComponente() Para formato de visualización
+ * @see cabeceraBinaria Para la disposición del archivo
+ * @see convertirTextoABinario()
  */
-void buscarPorVoltaje(const std::vector<componente>& registros){
-    float voltajeBuscado=solicitarNumero("Ingrese el voltaje del componente que desea encontrar \n");
-    bool encontrado{false};
+bool guardarEnBinario(const std::vector<componente>& registros, const std::string& nombreArchivo){
+    cronometroDeEtapa cronometro(etapaMedida::escritura);
+    const uint64_t cantidad = registros.size();
+    std::vector<float> valores, tolerancias, voltajes;
+    std::vector<uint64_t> desplazamientos;
+    std::string monticulo;
+    valores.reserve(cantidad);
+    tolerancias.reserve(cantidad);
+    voltajes.reserve(cantidad);
+    desplazamientos.reserve(3 * cantidad + 1);
+
     for (const auto& c : registros)
     {
-        if (c.voltajeDeTrabajo==voltajeBuscado)
-        {
-            mostrarComponente(c);
-            encontrado = true;
-        }
+        valores.push_back(c.valorNominal);
+        tolerancias.push_back(c.tolerancia);
+        voltajes.push_back(c.voltajeDeTrabajo);
+        desplazamientos.push_back(monticulo.size());
+        monticulo += c.nombreDelComponente;
+        desplazamientos.push_back(monticulo.size());
+        monticulo += c.tipoDeComponente;
+        desplazamientos.push_back(monticulo.size());
+        monticulo += c.estado;
     }
-    if (encontrado==false)
-        {
-            std::cout << "No se encontró ningún componente con ese voltaje.\n";
-        }
+    desplazamientos.push_back(monticulo.size());
+
+    cabeceraBinaria cabecera;
+    std::memcpy(cabecera.magia, MAGIA_BINARIA, sizeof(cabecera.magia));
+    cabecera.version = VERSION_BINARIA;
+    cabecera.cantidad = cantidad;
+    cabecera.inicioValorNominal = sizeof(cabeceraBinaria);
+    cabecera.inicioTolerancia = cabecera.inicioValorNominal + cantidad * sizeof(float);
+    cabecera.inicioVoltaje = cabecera.inicioTolerancia + cantidad * sizeof(float);
+    cabecera.inicioIndiceCadenas = cabecera.inicioVoltaje + cantidad * sizeof(float);
+    cabecera.inicioMonticulo = cabecera.inicioIndiceCadenas + desplazamientos.size() * sizeof(uint64_t);
+
+    bloqueoDeRegistro bloqueo(nombreArchivo);
+    const bool escrito = reemplazarArchivo(nombreArchivo, [&](std::ostream& archivo) {
+        archivo.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+        archivo.write(reinterpret_cast<const char*>(valores.data()), valores.size() * sizeof(float));
+        archivo.write(reinterpret_cast<const char*>(tolerancias.data()), tolerancias.size() * sizeof(float));
+        archivo.write(reinterpret_cast<const char*>(voltajes.data()), voltajes.size() * sizeof(float));
+        archivo.write(reinterpret_cast<const char*>(desplazamientos.data()), desplazamientos.size() * sizeof(uint64_t));
+        archivo.write(monticulo.data(), monticulo.size());
+    });
+    if (!escrito) {
+        std::cout << "Error al escribir el archivo binario.\n";
+        return false;
+    }
+    descartarIndices(nombreArchivo);
+    contarEstadistica(contadorMedido::bytesEscritos, cabecera.inicioMonticulo + monticulo.size());
+    return true;
 }
 
 /**
- * @brief Busca componentes por coincidencia parcial en el estado
+ * @brief Valida la cabecera y el índice de cadenas de un archivo binario en memoria
  * 
- * @param registros Vector de componentes donde buscar (referencia constante)
+ * @param datos Inicio del contenido del archivo (leído o mapeado)
+ * @param tamano Tamaño en bytes del contenido
+ * @param cabecera Salida: copia de la cabecera validada
+ * @return true si todas las secciones caben en el archivo y el índice es coherente
  * 
  * @details
- * Realiza una búsqueda de subcadena case-sensitive en el campo estado:
- * 
- * 1. Solicita el texto a buscar usando solicitarTexto()
- * 2. Compara con el campo estado de cada componente
- * 3. Muestra coincidencias con mostrarComponente()
- * 4. Informa si no hay resultados
- * 
- * La comparación es por subcadena:
- * - "nue" encontrará "Nuevo" y "nuevo"
- * - Coincidencia en cualquier posición del texto
+ * Comprueba firma y versión, que las tres columnas, el índice y el montículo
+ * estén dentro del archivo, y que el índice de cadenas sea no decreciente y no
+ * apunte fuera del montículo. Tras una validación exitosa los lectores pueden
+ * acceder a cualquier registro sin más comprobaciones.
  * 
- * @post Muestra componentes con estados coincidentes
- * @post No modifica el vector original
+ * @post Muestra un mensaje de error describiendo el primer problema encontrado
  * 
- * @warning
- * - Sensible a mayúsculas/minúsculas
- * - No realiza búsqueda fonética o aproximada
+ * @see cargarDesdeBinario()
+ * @see registroMapeado
+ */
+bool validarArchivoBinario(const char* datos, uint64_t tamano, cabeceraBinaria& cabecera){
+    if (tamano < sizeof(cabeceraBinaria)) {
+        std::cout << "El archivo binario está incompleto.\n";
+        return false;
+    }
+    std::memcpy(&cabecera, datos, sizeof(cabecera));
+    if (std::memcmp(cabecera.magia, MAGIA_BINARIA, sizeof(cabecera.magia)) != 0 || cabecera.version != VERSION_BINARIA) {
+        std::cout << "Versión de archivo binario no soportada.\n";
+        return false;
+    }
+
+    const uint64_t cantidad = cabecera.cantidad;
+    const uint64_t bytesColumna = cantidad * sizeof(float);
+    const uint64_t entradasIndice = 3 * cantidad + 1;
+    auto cabe = [tamano](uint64_t inicio, uint64_t bytes) {
+        return inicio <= tamano && bytes <= tamano - inicio;
+    };
+    if (cantidad > tamano / (3 * sizeof(float) + 3 * sizeof(uint64_t))
+        || !cabe(cabecera.inicioValorNominal, bytesColumna)
+        || !cabe(cabecera.inicioTolerancia, bytesColumna)
+        || !cabe(cabecera.inicioVoltaje, bytesColumna)
+        || !cabe(cabecera.inicioIndiceCadenas, entradasIndice * sizeof(uint64_t))
+        || !cabe(cabecera.inicioMonticulo, 0)) {
+        std::cout << "El archivo binario está dañado (secciones fuera de rango).\n";
+        return false;
+    }
+
+    const uint64_t tamanoMonticulo = tamano - cabecera.inicioMonticulo;
+    uint64_t anterior = 0;
+    for (uint64_t i = 0; i < entradasIndice; i++)
+    {
+        uint64_t desplazamiento;
+        std::memcpy(&desplazamiento, datos + cabecera.inicioIndiceCadenas + i * sizeof(uint64_t), sizeof(uint64_t));
+        if (desplazamiento > tamanoMonticulo || desplazamiento < anterior) {
+            std::cout << "El archivo binario está dañado (índice de cadenas inválido).\n";
+            return false;
+        }
+        anterior = desplazamiento;
+    }
+    return true;
+}
+
+/**
+ * @brief Lee un flotante de una columna de un archivo binario ya validado
+ * 
+ * @param datos Inicio del contenido del archivo
+ * @param inicioColumna Desplazamiento de la columna (de la cabecera)
+ * @param i Índice del registro
+ * @return float Valor almacenado
+ * 
+ * @note Usa memcpy porque las columnas no tienen alineación garantizada en un mapeo
+ */
+float leerColumnaBinaria(const char* datos, uint64_t inicioColumna, uint64_t i){
+    float valor;
+    std::memcpy(&valor, datos + inicioColumna + i * sizeof(float), sizeof(float));
+    return valor;
+}
+
+/**
+ * @brief Obtiene una cadena del montículo de un archivo binario ya validado
+ * 
+ * @param datos Inicio del contenido del archivo
+ * @param cabecera Cabecera validada del archivo
+ * @param posicion Entrada del índice (3*i nombre, 3*i+1 tipo, 3*i+2 estado)
+ * @return std::string_view Vista sobre los bytes de la cadena, sin copiarlos
+ */
+std::string_view leerCadenaBinaria(const char* datos, const cabeceraBinaria& cabecera, uint64_t posicion){
+    uint64_t limites[2];
+    std::memcpy(limites, datos + cabecera.inicioIndiceCadenas + posicion * sizeof(uint64_t), sizeof(limites));
+    return std::string_view(datos + cabecera.inicioMonticulo + limites[0], limites[1] - limites[0]);
+}
+
+/**
+ * @brief Carga componentes desde un archivo en formato binario columnar
+ * 
+ * @param registros Vector donde se almacenarán los componentes (se vacía antes)
+ * @param nombreArchivo Ruta del archivo binario
+ * @return true si el archivo es válido y se cargó por completo
+ * 
+ * @details
+ * Lee el archivo completo con una sola lectura y reconstruye los componentes
+ * directamente desde las columnas, sin convertir texto a número:
+ * 1. Valida firma, versión y secciones con validarArchivoBinario()
+ * 2. Construye cada componente copiando sus tres cadenas del montículo
+ * 
+ * @post Si el archivo es inválido, 'registros' queda vacío y se muestra un error
+ * 
+ * @throw Ninguno (los archivos corruptos se rechazan con un mensaje)
+ * 
+ * @see guardarEnBinario() Para el formato equivalente de escritura
+ * @see registroEnArena::cargar() Para la carga con detección automática
+ */
+bool cargarDesdeBinario(std::vector<componente>& registros, const std::string& nombreArchivo){
+    cronometroDeEtapa lectura(etapaMedida::lectura);
+    registros.clear();
+    std::ifstream archivo(nombreArchivo, std::ios::binary | std::ios::ate);
+    if (!archivo.is_open()) {
+        std::cout << "No se pudo abrir el archivo.\n";
+        return false;
+    }
+    const uint64_t tamano = static_cast<uint64_t>(archivo.tellg());
+    std::vector<char> datos(tamano);
+    archivo.seekg(0);
+    if (!archivo.read(datos.data(), tamano)) {
+        std::cout << "El archivo binario está incompleto.\n";
+        return false;
+    }
+
+    contarEstadistica(contadorMedido::bytesLeidos, tamano);
+
+    cronometroDeEtapa interpretacion(etapaMedida::interpretacion);
+    cabeceraBinaria cabecera;
+    if (!validarArchivoBinario(datos.data(), tamano, cabecera)) return false;
+
+    registros.resize(cabecera.cantidad);
+    for (uint64_t i = 0; i < cabecera.cantidad; i++)
+    {
+        componente& c = registros[i];
+        c.valorNominal = leerColumnaBinaria(datos.data(), cabecera.inicioValorNominal, i);
+        c.tolerancia = leerColumnaBinaria(datos.data(), cabecera.inicioTolerancia, i);
+        c.voltajeDeTrabajo = leerColumnaBinaria(datos.data(), cabecera.inicioVoltaje, i);
+        c.nombreDelComponente = std::string(leerCadenaBinaria(datos.data(), cabecera, 3 * i));
+        c.tipoDeComponente = std::string(leerCadenaBinaria(datos.data(), cabecera, 3 * i + 1));
+        c.estado = std::string(leerCadenaBinaria(datos.data(), cabecera, 3 * i + 2));
+    }
+    contarEstadistica(contadorMedido::registrosInterpretados, cabecera.cantidad);
+    return true;
+}
+
+/**
+ * @brief Convierte texto a flotante sin reservar memoria ni lanzar excepciones
+ * 
+ * @param texto Línea con el número (ej: "12.5")
+ * @param valor Salida: número convertido
+ * @return true si se pudo leer un número al inicio del texto
+ * 
+ * @details
+ * Imita la aceptación de std::stof() sobre las líneas del formato de texto:
+ * ignora espacios iniciales y un signo '+' opcional, y descarta lo que haya
+ * después del número (ej: "5  " se lee como 5). A diferencia de std::stof(),
+ * usa std::from_chars(), por lo que no depende del locale ni crea un std::string.
+ * 
+ * @see cargarDesdeArchivo() Para la conversión original con std::stof()
+ */
+bool convertirFlotante(std::string_view texto, float& valor){
+    size_t i = 0;
+    while (i < texto.size() && std::isspace(static_cast<unsigned char>(texto[i]))) i++;
+    if (i < texto.size() && texto[i] == '+') i++;
+    const char* inicio = texto.data() + i;
+    auto resultado = std::from_chars(inicio, texto.data() + texto.size(), valor);
+    return resultado.ec == std::errc() && resultado.ptr != inicio;
+}
+
+/**
+ * @class archivoMapeado
+ * @brief Proyección de solo lectura de un archivo completo en memoria
+ * 
+ * @details
+ * En sistemas POSIX usa mmap(), de modo que el contenido no se copia al heap:
+ * las páginas se leen bajo demanda desde la caché del sistema operativo. En
+ * otros sistemas lee el archivo completo en un búfer interno con la misma
+ * interfaz.
+ * 
+ * El objeto no es copiable; la proyección se libera en el destructor, por lo
+ * que cualquier std::string_view obtenido de datos() deja de ser válido
+ * cuando el objeto se destruye.
+ * 
+ * En un registro de texto, tamano() no es el tamaño del archivo sino el de
+ * una instantánea coherente (ver longitudConfirmada()): termina en un bloque
+ * completo y no incluye un lote que otro proceso esté escribiendo. Todos los
+ * lectores del formato de texto pasan por aquí, así que ninguno ve
+ * componentes a medio escribir. Los archivos binarios se proyectan completos.
+ * 
+ * @see registroMapeado Para recorrer componentes sobre la proyección
+ */
+class archivoMapeado
+{
+public:
+    explicit archivoMapeado(const std::string& nombreArchivo);
+    ~archivoMapeado();
+    archivoMapeado(const archivoMapeado&) = delete;
+    archivoMapeado& operator=(const archivoMapeado&) = delete;
+
+    bool abierto() const { return estaAbierto; } ///< true si el archivo se pudo proyectar
+    const char* datos() const { return inicio; } ///< Primer byte del archivo
+    uint64_t tamano() const { return visibles; } ///< Bytes de la instantánea (todo el archivo si es binario)
+
+private:
+    const char* inicio{nullptr};
+    uint64_t bytes{0}; ///< Bytes proyectados
+    uint64_t visibles{0}; ///< Bytes confirmados que se ofrecen a los lectores
+    bool estaAbierto{false};
+#ifndef SISTEMA_POSIX
+    std::vector<char> copia; ///< Contenido leído cuando no hay mmap()
+#endif
+};
+
+/**
+ * @brief Abre y proyecta el archivo indicado
+ * 
+ * @param nombreArchivo Ruta del archivo a proyectar
+ * 
+ * @post abierto() indica si la operación tuvo éxito
+ * @post Un archivo vacío se considera abierto con tamano() == 0
+ * @post En texto, tamano() termina en el último bloque confirmado
+ */
+archivoMapeado::archivoMapeado(const std::string& nombreArchivo){
+    cronometroDeEtapa cronometro(etapaMedida::lectura);
+#ifdef SISTEMA_POSIX
+    int descriptor = ::open(nombreArchivo.c_str(), O_RDONLY);
+    if (descriptor < 0) return;
+    struct stat info;
+    if (::fstat(descriptor, &info) == 0) {
+        bytes = static_cast<uint64_t>(info.st_size);
+        if (bytes == 0) {
+            estaAbierto = true;
+        } else {
+            void* mapa = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapa != MAP_FAILED) {
+                ::madvise(mapa, bytes, MADV_SEQUENTIAL);
+                inicio = static_cast<const char*>(mapa);
+                estaAbierto = true;
+            } else {
+                bytes = 0;
+            }
+        }
+    }
+    ::close(descriptor); // La proyección sigue siendo válida sin el descriptor
+#else
+    std::ifstream archivo(nombreArchivo, std::ios::binary | std::ios::ate);
+    if (!archivo.is_open()) return;
+    bytes = static_cast<uint64_t>(archivo.tellg());
+    copia.resize(bytes);
+    archivo.seekg(0);
+    if (!archivo.read(copia.data(), bytes)) {
+        bytes = 0;
+        return;
+    }
+    inicio = copia.data();
+    estaAbierto = true;
+#endif
+    const bool binario = bytes >= sizeof(MAGIA_BINARIA) && std::memcmp(inicio, MAGIA_BINARIA, sizeof(MAGIA_BINARIA)) == 0;
+    visibles = binario ? bytes : longitudConfirmada(nombreArchivo, inicio, bytes);
+    contarEstadistica(contadorMedido::bytesLeidos, visibles);
+}
+
+/**
+ * @brief Libera la proyección del archivo
+ */
+archivoMapeado::~archivoMapeado(){
+#ifdef SISTEMA_POSIX
+    if (inicio != nullptr) {
+        ::munmap(const_cast<char*>(inicio), bytes);
+    }
+#endif
+}
+
+/**
+ * @brief Comprueba si un índice (".idx" o ".tri") cubre exactamente el registro actual
+ * 
+ * @param nombreArchivo Ruta del registro
+ * @param bytesCubiertos Tamaño guardado en el índice
+ * @param huella huellaDeCola() guardada en el índice
+ * @return true si coinciden el tamaño de la instantánea coherente (ver
+ *         archivoMapeado::tamano()) y la huella de su final
+ */
+bool indiceAlDia(const std::string& nombreArchivo, uint64_t bytesCubiertos, uint64_t huella){
+    archivoMapeado mapa(nombreArchivo);
+    return mapa.abierto() && mapa.tamano() == bytesCubiertos && huellaDeCola(mapa.datos(), mapa.tamano()) == huella;
+}
+
+/**
+ * @struct vistaComponente
+ * @brief Componente de solo lectura cuyas cadenas apuntan al archivo proyectado
+ * 
+ * @details
+ * Tiene los mismos nombres de campo que la estructura componente, así que las
+ * funciones de búsqueda y visualización funcionan con ambas. Las cadenas son
+ * std::string_view sobre el archivo proyectado (no se copian) y los números
+ * ya están convertidos.
+ * 
+ * @warning Una vista solo es válida mientras exista el registroMapeado que la produjo
+ * 
+ * @see componente
+ * @see registroMapeado
+ */
+struct vistaComponente
+{
+    std::string_view nombreDelComponente; ///< Apunta al archivo proyectado
+    std::string_view tipoDeComponente; ///< Apunta al archivo proyectado
+    float valorNominal{0.00}; ///< Valor principal
+    float tolerancia{0.00}; ///< Tolerancia en porcentaje
+    float voltajeDeTrabajo{0.00}; ///< Voltaje máximo
+    std::string_view estado; ///< Apunta al archivo proyectado
+};
+
+/**
+ * @class escanerDeLineas
+ * @brief Divide un búfer en líneas localizando los saltos de línea por bloques de 64 bytes
+ * 
+ * @details
+ * En lugar de buscar cada '\n' por separado, compara 64 bytes a la vez contra
+ * '\n' con instrucciones SSE2 y guarda el resultado como una máscara de bits;
+ * las líneas siguientes se obtienen de la máscara sin volver a leer memoria.
+ * Como las líneas del formato de componentes son cortas (10-20 bytes), una
+ * sola ventana de 64 bytes suele contener un bloque completo.
+ * 
+ * Sin SSE2 (u otros procesadores) se usa std::memchr(), que la biblioteca
+ * estándar ya implementa de forma vectorizada.
+ * 
+ * @note Las líneas devueltas no incluyen el '\n'; la última línea se devuelve
+ *       aunque no termine en salto de línea, igual que std::getline()
+ * 
+ * @see analizarSiguienteBloque()
+ */
+class escanerDeLineas
+{
+public:
+    escanerDeLineas() = default;
+    escanerDeLineas(const char* inicio, const char* fin) : actual(inicio), fin(fin), ventana(inicio){
+        cargarVentana();
+    }
+
+    bool siguiente(std::string_view& linea);
+    void reposicionar(const char* posicion);
+    const char* posicion() const { return actual; } ///< Inicio de la próxima línea
+
+private:
+    void cargarVentana();
+
+    const char* actual{nullptr};
+    const char* fin{nullptr};
+    const char* ventana{nullptr}; ///< Inicio de los 64 bytes descritos por 'mascara'
+    uint64_t mascara{0}; ///< Bit i activo si ventana[i] == '\n' y aún no se consumió
+};
+
+/**
+ * @brief Calcula la máscara de saltos de línea de la ventana actual
+ */
+void escanerDeLineas::cargarVentana(){
+    mascara = 0;
+    if (ventana >= fin) return;
+#ifdef __SSE2__
+    if (fin - ventana >= 64) {
+        const __m128i salto = _mm_set1_epi8('\n');
+        for (int i = 0; i < 4; i++) {
+            __m128i bloque = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ventana + 16 * i));
+            uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bloque, salto)));
+            mascara |= static_cast<uint64_t>(bits) << (16 * i);
+        }
+        return;
+    }
+#endif
+    const int disponibles = static_cast<int>(std::min<std::ptrdiff_t>(64, fin - ventana));
+    for (int i = 0; i < disponibles; i++) {
+        if (ventana[i] == '\n') mascara |= uint64_t{1} << i;
+    }
+}
+
+/**
+ * @brief Obtiene la siguiente línea del búfer
+ * 
+ * @param linea Salida: línea sin el '\n' final (apunta al búfer)
+ * @return false si no quedan bytes por leer
+ */
+bool escanerDeLineas::siguiente(std::string_view& linea){
+    if (actual >= fin) return false;
+    const char* salto = nullptr;
+#ifdef __SSE2__
+    while (true) {
+        if (mascara != 0) {
+            salto = ventana + __builtin_ctzll(mascara);
+            mascara &= mascara - 1;
+            break;
+        }
+        ventana += 64;
+        if (ventana >= fin) break;
+        cargarVentana();
+    }
+#else
+    salto = static_cast<const char*>(std::memchr(actual, '\n', fin - actual));
+#endif
+    const char* finLinea = salto != nullptr ? salto : fin;
+    linea = std::string_view(actual, finLinea - actual);
+    actual = salto != nullptr ? salto + 1 : fin;
+    return true;
+}
+
+/**
+ * @brief Mueve el escáner a una posición arbitraria del búfer
+ * 
+ * @param posicion Inicio de la próxima línea a leer
+ */
+void escanerDeLineas::reposicionar(const char* posicion){
+    actual = posicion;
+    ventana = posicion;
+    cargarVentana();
+}
+
+/**
+ * @struct errorDeCarga
+ * @brief Describe un bloque del formato de texto que no se pudo interpretar
+ */
+struct errorDeCarga
+{
+    uint64_t desplazamiento{0}; ///< Byte del archivo donde empieza el bloque dañado
+    std::string motivo; ///< Descripción breve (ej: "tolerancia inválida")
+};
+
+/**
+ * @brief Intenta interpretar una lápida que empieza en 'linea'
+ * 
+ * @param linea Primera línea de un posible bloque
+ * @param siguiente Línea que la sigue
+ * @param separador Tercera línea
+ * @param desplazamiento Salida: bloque anulado
+ * @return true si las tres líneas forman una lápida válida
+ * 
+ * @see escribirLapida()
+ */
+bool esLapida(std::string_view linea, std::string_view siguiente, std::string_view separador, uint64_t& desplazamiento){
+    if (linea != MARCA_DE_BORRADO || separador != "-----" || siguiente.empty()) return false;
+    auto [fin, error] = std::from_chars(siguiente.data(), siguiente.data() + siguiente.size(), desplazamiento);
+    return error == std::errc() && fin == siguiente.data() + siguiente.size();
+}
+
+/**
+ * @brief Reúne los desplazamientos anulados por las lápidas de un registro de texto
+ * 
+ * @param datos Contenido del registro (normalmente proyectado con archivoMapeado)
+ * @param tamano Bytes de 'datos'
+ * @param bytesDeLapidas Si no es nullptr, recibe los bytes que ocupan las lápidas
+ * @return std::vector<uint64_t> Bloques anulados, ordenados y sin repetir
+ * 
+ * @details
+ * Busca la marca "#borrado" al inicio de línea con std::string_view::find(),
+ * que localiza el primer byte con memchr() vectorizado; como el carácter '#'
+ * casi nunca aparece en los datos, en un registro sin lápidas esto cuesta una
+ * fracción de la lectura del archivo. El resultado se consulta con
+ * std::binary_search() al recorrer los bloques.
+ * 
+ * @see analizarSiguienteBloque()
+ */
+std::vector<uint64_t> leerLapidas(const char* datos, uint64_t tamano, uint64_t* bytesDeLapidas = nullptr){
+    std::vector<uint64_t> anulados;
+    if (bytesDeLapidas != nullptr) *bytesDeLapidas = 0;
+    const std::string_view texto(datos, tamano);
+    const std::string_view marca(MARCA_DE_BORRADO);
+    for (size_t posicion = texto.find(marca); posicion != std::string_view::npos; posicion = texto.find(marca, posicion + 1)) {
+        if (posicion != 0 && texto[posicion - 1] != '\n') continue;
+        escanerDeLineas escaner(datos + posicion, datos + tamano);
+        std::string_view lineas[3];
+        uint64_t desplazamiento;
+        if (escaner.siguiente(lineas[0]) && escaner.siguiente(lineas[1]) && escaner.siguiente(lineas[2])
+            && esLapida(lineas[0], lineas[1], lineas[2], desplazamiento)) {
+            anulados.push_back(desplazamiento);
+            if (bytesDeLapidas != nullptr) *bytesDeLapidas += escaner.posicion() - (datos + posicion);
+        }
+    }
+    std::sort(anulados.begin(), anulados.end());
+    anulados.erase(std::unique(anulados.begin(), anulados.end()), anulados.end());
+    return anulados;
+}
+
+/**
+ * @brief Indica si el bloque que empieza en 'desplazamiento' fue anulado por una lápida
+ * 
+ * @param anulados Resultado de leerLapidas(), o nullptr si no se consideran
+ * @param desplazamiento Inicio del bloque
+ */
+bool estaAnulado(const std::vector<uint64_t>* anulados, uint64_t desplazamiento){
+    return anulados != nullptr && !anulados->empty()
+        && std::binary_search(anulados->begin(), anulados->end(), desplazamiento);
+}
+
+/**
+ * @brief Interpreta el siguiente bloque de 7 líneas del formato de texto
+ * 
+ * @param escaner Escáner posicionado al inicio de un bloque
+ * @param base Inicio del búfer completo (para calcular desplazamientos)
+ * @param vista Salida: componente leído (las cadenas apuntan al búfer)
+ * @param errores Si no es nullptr, recibe un errorDeCarga por cada bloque dañado
+ * @return true si se leyó un componente; false al llegar al final del búfer
+ * 
+ * @details
+ * Lee siete líneas y valida que la séptima sea "-----" y que las líneas 3 a 5
+ * sean números (con convertirFlotante()). Si el bloque está dañado:
+ * 1. Registra su desplazamiento y el motivo en 'errores'
+ * 2. Vuelve a la segunda línea del bloque y descarta líneas hasta el siguiente
+ *    separador "-----"
+ * 3. Continúa con el bloque que sigue
+ * 
+ * Un bloque incompleto al final del búfer también se reporta como error.
+ * 
+ * Las lápidas (ver escribirLapida()) se saltan sin reportarlas, y si se pasa
+ * 'anulados' también se saltan los bloques válidos cuyo desplazamiento
+ * respecto de 'base' figure en la lista.
+ * 
+ * @throw Ninguno (los errores se reportan por desplazamiento, nunca con excepciones)
+ * 
+ * @see cargarDesdeArchivoRapido()
+ * @see registroMapeado
+ * @see leerLapidas()
+ */
+bool analizarSiguienteBloque(escanerDeLineas& escaner, const char* base, vistaComponente& vista, std::vector<errorDeCarga>* errores,
+                             const std::vector<uint64_t>* anulados = nullptr){
+    while (true) {
+        const char* inicioBloque = escaner.posicion();
+        std::string_view lineas[7];
+        int leidas = 0;
+        while (leidas < 7 && escaner.siguiente(lineas[leidas])) leidas++;
+        if (leidas == 0) return false;
+
+        uint64_t anulado;
+        if (leidas >= 3 && esLapida(lineas[0], lineas[1], lineas[2], anulado)) {
+            escaner.reposicionar(lineas[2].data() + lineas[2].size());
+            std::string_view salto;
+            escaner.siguiente(salto); // Consume el '\n' del separador de la lápida
+            continue;
+        }
+
+        const char* motivo = nullptr;
+        if (leidas < 7) {
+            motivo = "bloque incompleto al final del archivo";
+        } else if (lineas[6] != "-----") {
+            motivo = "falta el separador \"-----\"";
+        } else if (!convertirFlotante(lineas[2], vista.valorNominal)) {
+            motivo = "valor nominal inválido";
+        } else if (!convertirFlotante(lineas[3], vista.tolerancia)) {
+            motivo = "tolerancia inválida";
+        } else if (!convertirFlotante(lineas[4], vista.voltajeDeTrabajo)) {
+            motivo = "voltaje inválido";
+        }
+
+        if (motivo == nullptr) {
+            if (estaAnulado(anulados, static_cast<uint64_t>(inicioBloque - base))) continue;
+            vista.nombreDelComponente = lineas[0];
+            vista.tipoDeComponente = lineas[1];
+            vista.estado = lineas[5];
+            return true;
+        }
+        if (errores != nullptr) {
+            errores->push_back({static_cast<uint64_t>(inicioBloque - base), motivo});
+        }
+        if (leidas < 7) return false;
+
+        // Sincronizar con el siguiente separador a partir de la segunda línea del bloque
+        escaner.reposicionar(lineas[1].data());
+        std::string_view linea;
+        while (escaner.siguiente(linea) && linea != "-----") {}
+    }
+}
+
+/**
+ * @class registroMapeado
+ * @brief Colección de solo lectura de componentes sobre un archivo proyectado en memoria
+ * 
+ * @details
+ * Proyecta el archivo con archivoMapeado y lo recorre bloque a bloque con un
+ * iterador que produce objetos vistaComponente. No se construye ningún
+ * std::vector<componente>: el costo de memoria de una búsqueda es solo la
+ * residencia de las páginas del archivo en la caché del sistema.
+ * 
+ * Funciona con ambos formatos:
+ * - Texto: cada vista apunta a las líneas del bloque; los bloques se
+ *   interpretan con analizarSiguienteBloque() al avanzar el iterador
+ * - Binario: cada vista apunta al montículo de cadenas y lee las columnas
+ * 
+ * En el formato de texto, un bloque cuya séptima línea no sea "-----" o con
+ * números inválidos se omite y la lectura continúa después del siguiente
+ * separador, en lugar de lanzar una excepción. Al abrirlo se reúnen las
+ * lápidas con leerLapidas() y el recorrido omite los bloques anulados.
+ * 
+ * Como los bloques se interpretan al recorrerlos, en las estadísticas (ver
+ * cronometroDeEtapa) ese tiempo forma parte del filtrado que los recorre.
  * 
  * @par Ejemplo de uso:
  * @code
- * vector<componente> inventario = {...};
- * buscarPorEstado(inventario);
- * // Usuario ingresa: "usad"
- * // Muestra componentes marcados como "Usado" o "usado"
+ * registroMapeado mapa("inventario.txt");
+ * for (const auto& c : mapa) {
+ *     if (c.estado == "Nuevo") mostrarComponente(c);
+ * }
+ * @endcode
+ * 
+ * @see vistaComponente
+ * @see buscarEnArchivo()
+ */
+class registroMapeado
+{
+public:
+    /**
+     * @class iterador
+     * @brief Iterador de entrada que produce un vistaComponente por bloque
+     */
+    class iterador
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = vistaComponente;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const vistaComponente*;
+        using reference = const vistaComponente&;
+
+        iterador() = default;
+        iterador(const registroMapeado* origen, const char* posicion);
+
+        reference operator*() const { return actual; }
+        pointer operator->() const { return &actual; }
+        iterador& operator++() { avanzar(); return *this; }
+        bool operator==(const iterador& otro) const { return terminado == otro.terminado; }
+        bool operator!=(const iterador& otro) const { return terminado != otro.terminado; }
+
+    private:
+        void avanzar();
+
+        const registroMapeado* origen{nullptr};
+        escanerDeLineas escaner;
+        uint64_t indice{0};
+        vistaComponente actual;
+        bool terminado{true};
+    };
+
+    explicit registroMapeado(const std::string& nombreArchivo);
+
+    bool abierto() const { return valido; } ///< true si el archivo se proyectó y su formato es válido
+    bool esBinario() const { return binario; } ///< true si el archivo está en formato binario
+    uint64_t tamano() const { return mapa.tamano(); } ///< Tamaño del archivo en bytes
+    iterador begin() const { return iterador(this, mapa.datos()); }
+    iterador end() const { return iterador(); }
+
+    const char* datos() const { return mapa.datos(); } ///< Inicio de la proyección
+    const cabeceraBinaria& cabeceraDelArchivo() const { return cabecera; } ///< Cabecera validada (solo binario)
+    const std::vector<uint64_t>& anulados() const { return lapidas; } ///< Bloques anulados por lápidas (solo texto)
+    vistaComponente fila(uint64_t indice) const;
+
+private:
+    archivoMapeado mapa;
+    cabeceraBinaria cabecera;
+    std::vector<uint64_t> lapidas;
+    bool binario{false};
+    bool valido{false};
+};
+
+/**
+ * @brief Proyecta el archivo y detecta su formato
+ * 
+ * @param nombreArchivo Ruta del archivo de componentes
+ * 
+ * @post Muestra un mensaje de error si el archivo no existe o es un binario dañado
+ */
+registroMapeado::registroMapeado(const std::string& nombreArchivo) : mapa(nombreArchivo){
+    cronometroDeEtapa cronometro(etapaMedida::interpretacion);
+    if (!mapa.abierto()) {
+        std::cout << "No se pudo abrir el archivo.\n";
+        return;
+    }
+    binario = mapa.tamano() >= sizeof(MAGIA_BINARIA)
+        && std::memcmp(mapa.datos(), MAGIA_BINARIA, sizeof(MAGIA_BINARIA)) == 0;
+    valido = !binario || validarArchivoBinario(mapa.datos(), mapa.tamano(), cabecera);
+    if (!binario) lapidas = leerLapidas(mapa.datos(), mapa.tamano());
+}
+
+/**
+ * @brief Lee la fila 'indice' de un archivo binario sin recorrer las anteriores
+ * 
+ * @param indice Fila a leer (menor que cabeceraDelArchivo().cantidad)
+ * @return vistaComponente Vista sobre las columnas y el montículo proyectados
+ * 
+ * @pre abierto() && esBinario()
+ */
+vistaComponente registroMapeado::fila(uint64_t indice) const{
+    const char* datos = mapa.datos();
+    vistaComponente vista;
+    vista.nombreDelComponente = leerCadenaBinaria(datos, cabecera, 3 * indice);
+    vista.tipoDeComponente = leerCadenaBinaria(datos, cabecera, 3 * indice + 1);
+    vista.estado = leerCadenaBinaria(datos, cabecera, 3 * indice + 2);
+    vista.valorNominal = leerColumnaBinaria(datos, cabecera.inicioValorNominal, indice);
+    vista.tolerancia = leerColumnaBinaria(datos, cabecera.inicioTolerancia, indice);
+    vista.voltajeDeTrabajo = leerColumnaBinaria(datos, cabecera.inicioVoltaje, indice);
+    return vista;
+}
+
+/**
+ * @brief Crea un iterador posicionado en el primer componente válido
+ */
+registroMapeado::iterador::iterador(const registroMapeado* origen, const char* posicion)
+    : origen(origen), terminado(false){
+    if (!origen->valido) {
+        terminado = true;
+        return;
+    }
+    if (!origen->binario) {
+        escaner = escanerDeLineas(posicion, origen->mapa.datos() + origen->mapa.tamano());
+    }
+    avanzar();
+}
+
+/**
+ * @brief Avanza al siguiente componente válido o marca el fin del recorrido
+ * 
+ * @details
+ * En binario lee la fila 'indice' de las columnas. En texto delega en
+ * analizarSiguienteBloque(), que omite los bloques dañados, las lápidas y
+ * los bloques que estas anulan.
+ */
+void registroMapeado::iterador::avanzar(){
+    if (origen->binario) {
+        if (indice >= origen->cabecera.cantidad) {
+            terminado = true;
+            return;
+        }
+        actual = origen->fila(indice);
+        indice++;
+        return;
+    }
+
+    if (!analizarSiguienteBloque(escaner, origen->mapa.datos(), actual, nullptr, &origen->lapidas)) {
+        terminado = true;
+    }
+}
+
+/**
+ * @brief Muestra los componentes vigentes de un archivo en la consola
+ * 
+ * @param nombreArchivo Ruta del archivo a visualizar (texto o binario)
+ * 
+ * @details
+ * Recorre el archivo con registroMapeado, igual que las búsquedas, y muestra
+ * cada componente con escribirComponente(), en el formato de 7 líneas del
+ * archivo de texto. Por eso no aparecen:
+ * - los componentes borrados ni los bloques de lápida ("#borrado")
+ * - las versiones anteriores de los componentes modificados
+ * - lo escrito después de la longitud confirmada (ver longitudConfirmada()),
+ *   que otro proceso puede estar escribiendo todavía
+ * - los bloques dañados, que se omiten como en cualquier otra lectura
+ * 
+ * Los archivos binarios se muestran en el mismo formato.
+ * 
+ * @post No modifica el archivo
+ * 
+ * @par Ejemplo de salida:
+ * @code
+ * Componentes del archivo:
+ * Resistor 1kΩ
+ * Resistor
+ * 1000
+ * 5
+ * 12.5
+ * Nuevo
+ * -----
+ * Capacitor 10uF
+ * ...
+ * 2 componentes.
+ * @endcode
+ * 
+ * @see registroMapeado
+ * @see escribirComponente() Para entender el formato del archivo
+ */
+void mostrarArchivoExistente(const std::string& nombreArchivo){
+    registroMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) return;
+
+    cronometroDeEtapa presentacion(etapaMedida::presentacion);
+    std::cout << "Componentes del archivo" << (mapa.esBinario() ? " (formato binario)" : "") << ":\n";
+    uint64_t mostrados = 0;
+    for (const vistaComponente& c : mapa) {
+        escribirComponente(std::cout, c);
+        mostrados++;
+    }
+    contarEstadistica(contadorMedido::registrosRecorridos, mostrados);
+    std::cout << mostrados << " componentes.\n";
+}
+
+/**
+ * @brief Vacía completamente el contenido de un archivo
+ * 
+ * @param nombreArchivo Ruta del archivo a vaciar (debe incluir extensión .txt)
+ * 
+ * @details
+ * Esta función elimina todo el contenido del archivo especificado mediante:
+ * 1. Toma del bloqueoDeRegistro del archivo
+ * 2. Publicación de un archivo vacío con reemplazarArchivo() (temporal y rename())
+ * 
+ * El archivo permanece existente pero con 0 bytes de tamaño. No se trunca en
+ * su sitio: un lector que lo tenga proyectado sigue viendo el contenido anterior.
+ * 
+ * @post El archivo queda vacío si se abre correctamente
+ * @post Sus índices (".idx", ".tri"), si existen, se eliminan
+ * @post El archivo original es sobreescrito completamente
+ * @post Muestra confirmación de éxito o error
+ * 
+ * @warning
+ * - La operación es irreversible
+ * - No solicita confirmación antes de vaciar
+ * - El archivo debe tener permisos de escritura
+ * 
+ * @par Ejemplo de uso:
+ * @code
+ * eliminarContenidoArchivo("componentes_obsoletos.txt");
+ * // Salida: "El archivo 'componentes_obsoletos.txt' fue vaciado con éxito."
+ * @endcode
+ * 
+ * @see guardarSesion() Para crear archivos nuevos
+ * @see continuarConArchivo() Para añadir contenido sin borrar
+ */
+void eliminarContenidoArchivo(const std::string& nombreArchivo){
+    bloqueoDeRegistro bloqueo(nombreArchivo);
+    if (reemplazarArchivo(nombreArchivo, [](std::ostream&) {})) {
+        registrarLongitudConfirmada(nombreArchivo, 0);
+        descartarIndices(nombreArchivo);
+        std::cout << "El archivo '" << nombreArchivo << "' fue vaciado con éxito.\n";
+    } else {
+        std::cout << "No se pudo abrir el archivo.\n";
+    }
+}
+
+/**
+ * @brief Muestra el menú principal de la aplicación con formato visual
+ * 
+ * @details 
+ * Presenta las opciones disponibles en un formato visualmente organizado:
+ * 
+ * ============================
+ * ¡Bienvenido! seleccione una opción:
+ * (1) Nuevo registro de componentes
+ * (2) Continuar registro desde un archivo existente
+ * (3) Ver registros de un archivo existente
+ * (4) Eliminar el contenido de un archivo
+ * (5) Buscar un componente en un archivo
+ * (6) Convertir un archivo entre texto y binario
+ * (7) Eliminar o modificar un componente
+ * (8) Activar o desactivar las estadísticas
+ * (9) Salir
+ * ============================
+ * 
+ * Cada opción está numerada y alineada para mejor legibilidad.
+ * 
+ * @post Genera salida estándar con el menú formateado
+ * @post No afecta el estado del programa
+ * 
+ * @note
+ * - Las opciones están diseñadas para ser claras y autodescriptivas
+ * - Los separadores "===" mejoran la legibilidad visual
+ * - Corresponde a eleccionMenuprincipal() para procesar la selección
+ * 
+ * @see eleccionMenuprincipal() Para el manejo de la selección del usuario
+ */
+void mostrarMenu(){
+    std::cout << "\n============================\n";
+    std::cout<<"¡Bienvenido! seleccione una opción:\n";
+    std::cout<<"(1)Nuevo registro de componentes \n";
+    std::cout<<"(2)Continuar registro desde un archivo existente. \n";
+    std::cout<<"(3)Ver registros de un archivo existente. \n";
+    std::cout<<"(4)Eliminar el contenido de un archivo. \n";
+    std::cout<<"(5)Buscar un componente en un archivo\n";
+    std::cout<<"(6)Convertir un archivo entre texto y binario\n";
+    std::cout<<"(7)Eliminar o modificar un componente\n";
+    std::cout<<"(8)Activar o desactivar las estadísticas\n";
+    std::cout<< "(9)Salir\n";
+    std::cout << "\n============================\n";
+}
+
+/**
+ * @brief Carga componentes desde un archivo de texto al vector de registros
+ * 
+ * @param registros Vector donde se almacenarán los componentes cargados
+ * @param nombreArchivo Ruta del archivo a cargar (debe incluir extensión .txt)
+ * 
+ * @details
+ * Esta función implementa un parser para el formato específico de archivos de componentes:
+ * 1. Abre el archivo en modo lectura
+ * 2. Lee línea por línea reconstruyendo la estructura de cada componente
+ * 3. Sigue estrictamente el formato:
+ *    - Línea 1: Nombre
+ *    - Línea 2: Tipo  
+ *    - Línea 3: Valor nominal (float)
+ *    - Línea 4: Tolerancia (float)
+ *    - Línea 5: Voltaje (float)
+ *    - Línea 6: Estado
+ *    - Línea 7: Separador "-----"
+ * 
+ * @post El vector 'registros' contiene todos los componentes válidos del archivo
+ * @post El vector se vacía antes de cargar nuevos registros
+ * @post Muestra error si no puede abrir el archivo
+ * 
+ * @throw std::invalid_argument Si encuentra valores numéricos inválidos
+ * @throw std::out_of_range Si los valores numéricos exceden los límites
+ * 
+ * @par Ejemplo de formato de archivo:
+ * @code
+ * Resistor 1kΩ
+ * Resistor
+ * 1000
+ * 5  
+ * 12.5
+ * Nuevo
+ * -----
+ * @endcode
+ * 
+ * @note
+ * - Usa std::stof() para conversión numérica (lanza excepciones)
+ * - El contador maneja la posición de cada campo
+ * - Reinicia el estado al encontrar "-----"
+ * 
+ * @see escribirComponente() Para el formato de guardado equivalente
+ * @see continuarConArchivo() Para añadir componentes a archivos
+ */
+void cargarDesdeArchivo(std::vector<componente>& registros, const std::string& nombreArchivo) {
+    cronometroDeEtapa cronometro(etapaMedida::interpretacion); // std::getline() lee e interpreta a la vez
+    std::ifstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        std::cout << "No se pudo abrir el archivo.\n";
+        return;
+    }
+
+    registros.clear();  // Limpiamos para evitar mezclar registros anteriores
+    componente temp;
+    std::string linea;
+    int contador = 0;
+
+    while (std::getline(archivo, linea)) {
+        switch (contador) {
+            case 0: 
+                temp.nombreDelComponente = linea; 
+                break;
+            case 1: 
+                temp.tipoDeComponente = linea; 
+                break;
+            case 2: 
+                temp.valorNominal = std::stof(linea); 
+                break;
+            case 3: 
+                temp.tolerancia = std::stof(linea); 
+                break;
+            case 4: 
+                temp.voltajeDeTrabajo = std::stof(linea); 
+                break;
+            case 5: 
+                temp.estado = linea; 
+                break;
+            case 6:
+                if (linea == "-----") {
+                    registros.push_back(temp);
+                    temp = componente();  // Limpiar para el siguiente
+                    contador = -1;       // Reiniciar para el siguiente bloque
+                }
+                break;
+        }
+        contador++;
+    }
+
+    archivo.close();
+    contarEstadistica(contadorMedido::registrosInterpretados, registros.size());
+}
+
+/**
+ * @brief Carga componentes de un archivo de texto con el parser rápido
+ * 
+ * @param registros Vector donde se almacenarán los componentes (se vacía antes)
+ * @param nombreArchivo Ruta del archivo de texto
+ * @param errores Recibe un errorDeCarga por cada bloque dañado (se vacía antes)
+ * @return true si el archivo se pudo abrir
+ * 
+ * @details
+ * Alternativa a cargarDesdeArchivo() con el mismo formato de 7 líneas:
+ * 1. Proyecta el archivo con archivoMapeado (sin std::getline ni una línea por std::string)
+ * 2. Separa las líneas con escanerDeLineas
+ * 3. Convierte los números con std::from_chars() (independiente del locale)
+ * 4. Reporta los bloques dañados por desplazamiento en lugar de lanzar excepciones
+ * 
+ * A diferencia de cargarDesdeArchivo(), un bloque sin separador no arruina el
+ * resto de la carga: se reporta y la lectura continúa tras el siguiente "-----".
+ * Los componentes borrados o reemplazados (ver escribirLapida()) no se cargan.
+ * 
+ * @post 'registros' contiene todos los componentes vigentes en el orden del archivo
+ * 
+ * @throw Ninguno
+ * 
+ * @see analizarSiguienteBloque()
+ * @see mostrarErroresDeCarga()
+ */
+bool cargarDesdeArchivoRapido(std::vector<componente>& registros, const std::string& nombreArchivo, std::vector<errorDeCarga>& errores){
+    cronometroDeEtapa cronometro(etapaMedida::interpretacion);
+    registros.clear();
+    errores.clear();
+    archivoMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) {
+        std::cout << "No se pudo abrir el archivo.\n";
+        return false;
+    }
+
+    const std::vector<uint64_t> anulados = leerLapidas(mapa.datos(), mapa.tamano());
+    escanerDeLineas escaner(mapa.datos(), mapa.datos() + mapa.tamano());
+    vistaComponente vista;
+    while (analizarSiguienteBloque(escaner, mapa.datos(), vista, &errores, &anulados)) {
+        componente& c = registros.emplace_back();
+        c.nombreDelComponente = vista.nombreDelComponente;
+        c.tipoDeComponente = vista.tipoDeComponente;
+        c.valorNominal = vista.valorNominal;
+        c.tolerancia = vista.tolerancia;
+        c.voltajeDeTrabajo = vista.voltajeDeTrabajo;
+        c.estado = vista.estado;
+    }
+    contarEstadistica(contadorMedido::registrosInterpretados, registros.size());
+    return true;
+}
+
+/**
+ * @brief Tamaño mínimo de cada rango de bytes en la carga paralela
+ * 
+ * Evita crear hilos para archivos pequeños, donde el costo de lanzarlos
+ * supera al de interpretar el archivo en un solo hilo.
+ */
+const uint64_t BYTES_MINIMOS_POR_HILO = 4ull * 1024 * 1024;
+
+/**
+ * @brief Ajusta una posición del búfer al inicio del siguiente bloque de componente
+ * 
+ * @param inicio Inicio del búfer
+ * @param fin Fin del búfer
+ * @param posicion Posición aproximada dentro del búfer
+ * @return const char* Primer byte después de la siguiente línea "-----" completa
+ *         que empiece en 'posicion' o después; 'fin' si no hay ninguna
+ * 
+ * @details
+ * Una línea separadora es "-----" precedida por '\n' (o el inicio del búfer)
+ * y seguida por '\n'. Como los bloques terminan en el separador, la posición
+ * devuelta siempre coincide con el inicio de un bloque en un archivo bien formado.
+ * 
+ * @see cargarDesdeArchivoParalelo()
+ */
+const char* alinearAlSiguienteBloque(const char* inicio, const char* fin, const char* posicion){
+    static const char separador[] = "-----\n";
+    const size_t largo = sizeof(separador) - 1;
+    while (posicion < fin) {
+        const char* candidato = std::search(posicion, fin, separador, separador + largo);
+        if (candidato == fin) return fin;
+        if (candidato == inicio || candidato[-1] == '\n') return candidato + largo;
+        posicion = candidato + 1;
+    }
+    return fin;
+}
+
+/**
+ * @brief Carga un archivo de texto repartiendo rangos de bytes entre varios hilos
+ * 
+ * @param registros Vector donde se almacenarán los componentes (se vacía antes)
+ * @param nombreArchivo Ruta del archivo de texto
+ * @param errores Recibe los bloques dañados de todos los rangos, en orden de archivo
+ * @param hilos Número de hilos a usar (0 = std::thread::hardware_concurrency())
+ * @return true si el archivo se pudo abrir
+ * 
+ * @details
+ * 1. Proyecta el archivo con archivoMapeado
+ * 2. Lo divide en rangos de igual tamaño (al menos BYTES_MINIMOS_POR_HILO cada uno)
+ * 3. Mueve cada frontera al siguiente separador con alinearAlSiguienteBloque()
+ * 4. Cada hilo interpreta su rango con analizarSiguienteBloque() en un vector propio
+ * 5. Concatena los vectores de los hilos en el orden de los rangos
+ * 
+ * Como los rangos no se solapan y se concatenan en orden, el resultado es el
+ * mismo que el de cargarDesdeArchivoRapido(), incluido el orden de los registros.
+ * Con un solo hilo (archivos pequeños) no se crea ningún hilo adicional.
+ * 
+ * @warning La equivalencia exacta supone que ningún campo de texto es
+ *          literalmente "-----"; un nombre así se confundiría con un separador
+ *          al alinear las fronteras
+ * 
+ * @throw Ninguno
+ * 
+ * @see cargarDesdeArchivoRapido() Para la versión secuencial
+ */
+bool cargarDesdeArchivoParalelo(std::vector<componente>& registros, const std::string& nombreArchivo, std::vector<errorDeCarga>& errores, unsigned hilos = 0){
+    cronometroDeEtapa cronometro(etapaMedida::interpretacion); // Los trabajadores no cronometran: el hilo principal los espera
+    registros.clear();
+    errores.clear();
+    archivoMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) {
+        std::cout << "No se pudo abrir el archivo.\n";
+        return false;
+    }
+
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    const uint64_t maximoPorTamano = std::max<uint64_t>(1, mapa.tamano() / BYTES_MINIMOS_POR_HILO);
+    hilos = static_cast<unsigned>(std::min<uint64_t>(hilos, maximoPorTamano));
+
+    const char* inicio = mapa.datos();
+    const char* fin = inicio + mapa.tamano();
+    std::vector<const char*> fronteras(hilos + 1);
+    fronteras[0] = inicio;
+    fronteras[hilos] = fin;
+    for (unsigned i = 1; i < hilos; i++)
+    {
+        const char* aproximada = inicio + mapa.tamano() * i / hilos;
+        fronteras[i] = std::max(fronteras[i - 1], alinearAlSiguienteBloque(inicio, fin, aproximada));
+    }
+
+    const std::vector<uint64_t> anulados = leerLapidas(inicio, mapa.tamano()); // Una lápida puede anular un bloque de otro rango
+    std::vector<std::vector<componente>> parciales(hilos);
+    std::vector<std::vector<errorDeCarga>> erroresParciales(hilos);
+    auto trabajar = [&](unsigned i) {
+        escanerDeLineas escaner(fronteras[i], fronteras[i + 1]);
+        vistaComponente vista;
+        while (analizarSiguienteBloque(escaner, inicio, vista, &erroresParciales[i], &anulados)) {
+            componente& c = parciales[i].emplace_back();
+            c.nombreDelComponente = vista.nombreDelComponente;
+            c.tipoDeComponente = vista.tipoDeComponente;
+            c.valorNominal = vista.valorNominal;
+            c.tolerancia = vista.tolerancia;
+            c.voltajeDeTrabajo = vista.voltajeDeTrabajo;
+            c.estado = vista.estado;
+        }
+    };
+
+    std::vector<std::thread> trabajadores;
+    for (unsigned i = 1; i < hilos; i++)
+    {
+        trabajadores.emplace_back(trabajar, i);
+    }
+    trabajar(0); // El hilo principal procesa el primer rango
+    for (auto& t : trabajadores) t.join();
+
+    size_t total = 0;
+    for (const auto& parcial : parciales) total += parcial.size();
+    registros.reserve(total);
+    for (unsigned i = 0; i < hilos; i++)
+    {
+        registros.insert(registros.end(), std::make_move_iterator(parciales[i].begin()), std::make_move_iterator(parciales[i].end()));
+        errores.insert(errores.end(), erroresParciales[i].begin(), erroresParciales[i].end());
+    }
+    contarEstadistica(contadorMedido::registrosInterpretados, registros.size());
+    return true;
+}
+
+/**
+ * @brief Muestra un resumen de los bloques dañados encontrados durante una carga
+ * 
+ * @param errores Errores devueltos por cargarDesdeArchivoRapido()
+ * @param salida Flujo donde se muestran (std::cerr cuando la salida estándar lleva datos)
+ * 
+ * @details
+ * Muestra como máximo los primeros 10 errores con su desplazamiento en bytes
+ * y el total, para no inundar la consola con archivos muy dañados.
+ */
+void mostrarErroresDeCarga(const std::vector<errorDeCarga>& errores, std::ostream& salida = std::cout){
+    if (errores.empty()) return;
+    const size_t maximo = 10;
+    for (size_t i = 0; i < errores.size() && i < maximo; i++)
+    {
+        salida << "Bloque dañado en el byte " << errores[i].desplazamiento << ": " << errores[i].motivo << "\n";
+    }
+    if (errores.size() > maximo) {
+        salida << "... y " << errores.size() - maximo << " bloques dañados más.\n";
+    }
+    salida << errores.size() << " bloques dañados fueron omitidos.\n";
+}
+
+/**
+ * @class registroEnArena
+ * @brief Componentes cargados de un archivo cuyas cadenas viven en una arena monótona
+ * 
+ * @details
+ * Cargar un archivo en std::vector<componente> hace hasta tres reservas de
+ * memoria por registro (las cadenas largas) más las del propio vector, y
+ * vaciarlo las devuelve una por una. Aquí las filas son vistaComponente cuyas
+ * cadenas se copian a un std::pmr::monotonic_buffer_resource: todo el archivo
+ * ocupa unos pocos bloques grandes que crecen geométricamente, y liberar()
+ * los devuelve de una vez, en O(número de bloques), al cargar el siguiente.
+ * 
+ * Ofrece size(), operator[] y begin()/end(), por lo que las funciones de
+ * búsqueda genéricas y los índices numéricos lo aceptan igual que a un vector.
+ * 
+ * También funciona como caché del último archivo cargado: recuerda su ruta
+ * canónica, su tamaño y su fecha de modificación, y actualizar() evita
+ * volver a interpretarlo si no cambió o interpreta solo lo añadido al final.
+ * 
+ * @warning Las vistas obtenidas dejan de ser válidas tras liberar() o cargar()
+ * 
+ * @see cargar()
+ * @see actualizar()
+ * @see compararAsignaciones()
+ */
+class registroEnArena
+{
+public:
+    /**
+     * @enum resultadoDeActualizacion
+     * @brief Qué tuvo que hacer actualizar() para reflejar el archivo
+     */
+    enum class resultadoDeActualizacion
+    {
+        sinCambios, ///< El archivo no cambió; se reutilizaron las filas
+        ampliado,   ///< Solo creció por el final; se interpretó la parte nueva
+        recargado,  ///< Se interpretó el archivo completo
+        error       ///< No se pudo abrir o su formato es inválido
+    };
+
+    registroEnArena() = default;
+    registroEnArena(const registroEnArena&) = delete;
+    registroEnArena& operator=(const registroEnArena&) = delete;
+
+    bool cargar(const std::string& nombreArchivo, std::vector<errorDeCarga>& errores);
+    resultadoDeActualizacion actualizar(const std::string& nombreArchivo, std::vector<errorDeCarga>& errores);
+    void liberar();
+
+    size_t size() const { return filas.size(); } ///< Número de componentes cargados
+    bool empty() const { return filas.empty(); } ///< true si no hay componentes cargados
+    const vistaComponente& operator[](size_t i) const { return filas[i]; } ///< Componente i
+    const vistaComponente* begin() const { return filas.data(); }
+    const vistaComponente* end() const { return filas.data() + filas.size(); }
+
+private:
+    std::string_view copiar(std::string_view texto);
+    vistaComponente copiar(const vistaComponente& vista);
+    void interpretarTexto(const registroMapeado& mapa, uint64_t desde, std::vector<errorDeCarga>& errores);
+
+    /// Bytes del final de la parte interpretada que actualizar() compara para
+    /// comprobar que el archivo solo creció
+    static const uint64_t BYTES_DE_HUELLA = 64;
+
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::vector<vistaComponente> filas{&arena};
+    std::string rutaCargada; ///< Ruta canónica del archivo cargado (vacía si no hay)
+    uint64_t tamanoCargado{0};
+    std::filesystem::file_time_type fechaCargada;
+    bool binarioCargado{false};
+    uint64_t bytesInterpretados{0}; ///< Fin del último bloque válido (solo texto)
+    std::string huella; ///< Los BYTES_DE_HUELLA bytes anteriores a bytesInterpretados
+};
+
+/**
+ * @brief Copia una cadena a la arena y devuelve una vista sobre la copia
+ */
+std::string_view registroEnArena::copiar(std::string_view texto){
+    if (texto.empty()) return {};
+    char* destino = static_cast<char*>(arena.allocate(texto.size(), 1));
+    std::memcpy(destino, texto.data(), texto.size());
+    return std::string_view(destino, texto.size());
+}
+
+/**
+ * @brief Copia las cadenas de una vista (que apunta al archivo proyectado) a la arena
+ */
+vistaComponente registroEnArena::copiar(const vistaComponente& vista){
+    vistaComponente copia = vista;
+    copia.nombreDelComponente = copiar(vista.nombreDelComponente);
+    copia.tipoDeComponente = copiar(vista.tipoDeComponente);
+    copia.estado = copiar(vista.estado);
+    return copia;
+}
+
+/**
+ * @brief Libera todos los componentes cargados de una vez
+ * 
+ * @post size() == 0 y la arena devolvió sus bloques al sistema
+ */
+void registroEnArena::liberar(){
+    filas = std::pmr::vector<vistaComponente>(&arena);
+    arena.release();
+    rutaCargada.clear();
+}
+
+/**
+ * @brief Interpreta los bloques de texto desde un desplazamiento y los añade a la arena
+ * 
+ * @param mapa Archivo de texto proyectado
+ * @param desde Inicio de un bloque (0 o el bytesInterpretados de una carga anterior)
+ * @param errores Recibe los bloques dañados, con desplazamientos absolutos
+ * 
+ * @post bytesInterpretados y huella corresponden al último bloque válido
+ */
+void registroEnArena::interpretarTexto(const registroMapeado& mapa, uint64_t desde, std::vector<errorDeCarga>& errores){
+    cronometroDeEtapa cronometro(etapaMedida::interpretacion);
+    const size_t filasPrevias = filas.size();
+    escanerDeLineas escaner(mapa.datos() + desde, mapa.datos() + mapa.tamano());
+    vistaComponente vista;
+    bytesInterpretados = desde;
+    while (analizarSiguienteBloque(escaner, mapa.datos(), vista, &errores, &mapa.anulados())) {
+        filas.push_back(copiar(vista));
+        bytesInterpretados = escaner.posicion() - mapa.datos();
+    }
+    const uint64_t inicioHuella = bytesInterpretados - std::min(bytesInterpretados, BYTES_DE_HUELLA);
+    huella.assign(mapa.datos() + inicioHuella, bytesInterpretados - inicioHuella);
+    contarEstadistica(contadorMedido::registrosInterpretados, filas.size() - filasPrevias);
+}
+
+/**
+ * @brief Carga un archivo de componentes (texto o binario) en la arena
+ * 
+ * @param nombreArchivo Ruta del archivo
+ * @param errores Recibe un errorDeCarga por cada bloque dañado (se vacía antes)
+ * @return true si el archivo se pudo abrir y su formato es válido
+ * 
+ * @details
+ * Libera primero lo cargado anteriormente. Recorre el archivo con
+ * registroMapeado (el mismo parser que cargarDesdeArchivoRapido() en texto, y
+ * las columnas en binario) y copia cada fila a la arena, de modo que el
+ * archivo se puede cerrar al terminar.
+ */
+bool registroEnArena::cargar(const std::string& nombreArchivo, std::vector<errorDeCarga>& errores){
+    liberar();
+    errores.clear();
+    std::error_code error;
+    const auto fecha = std::filesystem::last_write_time(nombreArchivo, error);
+    registroMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) return false;
+
+    binarioCargado = mapa.esBinario();
+    if (binarioCargado) {
+        cronometroDeEtapa cronometro(etapaMedida::interpretacion);
+        filas.reserve(mapa.cabeceraDelArchivo().cantidad);
+        for (const vistaComponente& vista : mapa) filas.push_back(copiar(vista));
+        contarEstadistica(contadorMedido::registrosInterpretados, filas.size());
+    } else {
+        interpretarTexto(mapa, 0, errores);
+    }
+    rutaCargada = std::filesystem::weakly_canonical(nombreArchivo, error).string();
+    tamanoCargado = mapa.tamano();
+    fechaCargada = fecha;
+    return true;
+}
+
+/**
+ * @brief Actualiza la caché con el estado actual del archivo, interpretando lo mínimo posible
+ * 
+ * @param nombreArchivo Ruta del archivo (texto o binario)
+ * @param errores Recibe los bloques dañados de la parte interpretada (se vacía antes)
+ * @return resultadoDeActualizacion Qué hubo que hacer
+ * 
+ * @details
+ * - Misma ruta canónica, mismo tamaño y misma fecha de modificación: no lee
+ *   el archivo (sinCambios)
+ * - Archivo de texto que solo creció: comprueba que los últimos bytes de la
+ *   parte ya interpretada no cambiaron (huella) e interpreta únicamente los
+ *   bloques nuevos (ampliado). Si lo añadido contiene lápidas, que pueden
+ *   anular filas ya cargadas, se recarga completo
+ * - Cualquier otro cambio, otro archivo o un binario modificado: cargar()
+ *   completo (recargado)
+ * 
+ * @note La huella detecta un archivo reescrito con otro contenido, pero no
+ *       una modificación que deje intactos su tamaño final y sus últimos bytes
+ */
+registroEnArena::resultadoDeActualizacion registroEnArena::actualizar(const std::string& nombreArchivo, std::vector<errorDeCarga>& errores){
+    errores.clear();
+    std::error_code error;
+    const std::string ruta = std::filesystem::weakly_canonical(nombreArchivo, error).string();
+    const uint64_t tamano = tamanoDeArchivo(nombreArchivo);
+    const auto fecha = std::filesystem::last_write_time(nombreArchivo, error);
+    if (!rutaCargada.empty() && ruta == rutaCargada && !error) {
+        if (tamano == tamanoCargado && fecha == fechaCargada) return resultadoDeActualizacion::sinCambios;
+
+        if (!binarioCargado && tamano > tamanoCargado) {
+            registroMapeado mapa(nombreArchivo);
+            if (mapa.abierto() && !mapa.esBinario() && mapa.tamano() >= bytesInterpretados
+                && std::string_view(mapa.datos() + bytesInterpretados - huella.size(), huella.size()) == huella
+                && leerLapidas(mapa.datos() + bytesInterpretados, mapa.tamano() - bytesInterpretados).empty()) {
+                interpretarTexto(mapa, bytesInterpretados, errores);
+                tamanoCargado = mapa.tamano();
+                fechaCargada = fecha;
+                return resultadoDeActualizacion::ampliado;
+            }
+        }
+    }
+    return cargar(nombreArchivo, errores) ? resultadoDeActualizacion::recargado : resultadoDeActualizacion::error;
+}
+
+/**
+ * @brief Convierte un archivo de componentes de texto al formato binario
+ * 
+ * @param origen Archivo de texto de entrada (formato de 7 líneas)
+ * @param destino Archivo binario de salida (se sobrescribe)
+ * @return true si la conversión terminó correctamente
+ * 
+ * @note Los bloques dañados del origen se omiten y se reportan por desplazamiento
+ * 
+ * @see convertirBinarioATexto() Para la conversión inversa
+ */
+bool convertirTextoABinario(const std::string& origen, const std::string& destino){
+    std::vector<componente> registros;
+    std::vector<errorDeCarga> errores;
+    if (!cargarDesdeArchivoRapido(registros, origen, errores)) return false;
+    mostrarErroresDeCarga(errores);
+    return guardarEnBinario(registros, destino);
+}
+
+/**
+ * @brief Convierte un archivo de componentes binario al formato de texto
+ * 
+ * @param origen Archivo binario de entrada
+ * @param destino Archivo de texto de salida (se sobrescribe)
+ * @return true si la conversión terminó correctamente
+ * 
+ * @note Los flotantes se escriben con la precisión por defecto de std::ostream,
+ *       igual que escribirComponente()
+ * @note El destino se publica con guardarSesion() (temporal y rename()), nunca se trunca en su sitio
+ * 
+ * @see convertirTextoABinario() Para la conversión inversa
+ */
+bool convertirBinarioATexto(const std::string& origen, const std::string& destino){
+    std::vector<componente> registros;
+    if (!cargarDesdeBinario(registros, origen)) return false;
+    return guardarSesion(registros, destino);
+}
+
+/**
+ * @brief Solicita los archivos y ejecuta la conversión entre formatos
+ * 
+ * @details
+ * Detecta el formato del archivo de origen y convierte en la dirección
+ * correspondiente: texto → binario o binario → texto.
+ * 
+ * @see convertirTextoABinario()
+ * @see convertirBinarioATexto()
+ */
+void convertirFormato(){
+    std::string origen;
+    std::string destino;
+    std::cin.ignore();
+    std::cout << "Ingresa el nombre del archivo de origen: \n";
+    std::getline(std::cin, origen);
+    std::cout << "Ingresa el nombre del archivo de destino: \n";
+    std::getline(std::cin, destino);
+
+    std::ifstream test(origen);
+    if (!test.is_open()) {
+        std::cout << "El archivo no existe. No se puede continuar\n";
+        return;
+    }
+    test.close();
+
+    bool binario = esArchivoBinario(origen);
+    bool exito = binario ? convertirBinarioATexto(origen, destino) : convertirTextoABinario(origen, destino);
+    if (exito) {
+        std::cout << "Archivo convertido a formato " << (binario ? "de texto" : "binario") << " correctamente.\n";
+    }
+}
+
+/**
+ * @brief Número de ULPs (unidades en la última posición) que se toleran al comparar flotantes
+ * 
+ * Un float guardado en texto con 6 cifras significativas (la precisión por
+ * defecto de std::ostream) puede volver con un error relativo de hasta
+ * 5e-7, es decir, unas 4-8 ULPs según la posición dentro de la potencia de 2.
+ * 16 ULPs cubre ese redondeo con margen sin confundir valores distintos que
+ * un usuario escribiría (ej: 4.7 y 4.70001).
+ */
+const int ULPS_DE_TOLERANCIA = 16;
+
+/**
+ * @brief Avanza un flotante un número dado de ULPs
+ * 
+ * @param valor Valor de partida
+ * @param ulps Número de pasos (negativo para retroceder)
+ * @return float El flotante representable que está 'ulps' pasos de 'valor'
+ */
+float desplazarUlps(float valor, int ulps){
+    const float destino = ulps < 0 ? -std::numeric_limits<float>::infinity() : std::numeric_limits<float>::infinity();
+    for (int i = 0; i < std::abs(ulps); i++) valor = std::nextafter(valor, destino);
+    return valor;
+}
+
+/**
+ * @brief Compara dos flotantes tolerando el redondeo del formato de texto
+ * 
+ * @param a Valor almacenado
+ * @param b Valor buscado
+ * @return true si 'a' está a lo sumo ULPS_DE_TOLERANCIA ULPs de 'b'
+ * 
+ * @see ULPS_DE_TOLERANCIA
+ */
+bool sonAproximadamenteIguales(float a, float b){
+    return a >= desplazarUlps(b, -ULPS_DE_TOLERANCIA) && a <= desplazarUlps(b, ULPS_DE_TOLERANCIA);
+}
+
+/**
+ * @enum unidadElectrica
+ * @brief Unidad SI del valor de un componente
+ * 
+ * Se deduce del texto ("10uF", "1kΩ") o, si el texto no la indica, del tipo
+ * de componente (ver unidadDelTipo()).
+ */
+enum class unidadElectrica : uint8_t
+{
+    ninguna, ///< Sin unidad conocida (ej: diodos, transistores)
+    ohmio,   ///< Ω
+    faradio, ///< F
+    henrio,  ///< H
+    voltio,  ///< V
+    amperio, ///< A
+    cantidad ///< Número de unidades (no es una unidad)
+};
+
+/**
+ * @struct magnitudElectrica
+ * @brief Valor expresado en la unidad SI base (ohmios, faradios, ...) junto con su unidad
+ */
+struct magnitudElectrica
+{
+    double valor{0.0}; ///< Ej: 1e-08 para "10nF"
+    unidadElectrica unidad{unidadElectrica::ninguna}; ///< Ej: unidadElectrica::faradio
+};
+
+/**
+ * @struct prefijoSI
+ * @brief Entrada de PREFIJOS_SI: símbolo de un prefijo y su factor
+ */
+struct prefijoSI
+{
+    std::string_view simbolo;
+    double factor;
+};
+
+/**
+ * @brief Prefijos SI admitidos en los valores
+ * 
+ * 'u' es la forma ASCII de micro y 'K' la forma habitual de kilo en los
+ * códigos de resistencias. Micro se acepta como µ (U+00B5, signo micro) y
+ * como μ (U+03BC, letra griega), que se ven iguales.
+ */
+constexpr prefijoSI PREFIJOS_SI[] = {
+    {"p", 1e-12}, {"n", 1e-9}, {"u", 1e-6}, {"\xC2\xB5", 1e-6}, {"\xCE\xBC", 1e-6}, {"m", 1e-3},
+    {"k", 1e3}, {"K", 1e3}, {"M", 1e6}, {"G", 1e9}
+};
+
+/**
+ * @struct simboloDeUnidad
+ * @brief Entrada de SIMBOLOS_DE_UNIDAD: cómo se escribe una unidad
+ */
+struct simboloDeUnidad
+{
+    std::string_view simbolo;
+    unidadElectrica unidad;
+};
+
+/**
+ * @brief Símbolos de unidad admitidos; ohmio como Ω (U+03A9), Ω (U+2126, signo ohmio) u "ohm"
+ */
+constexpr simboloDeUnidad SIMBOLOS_DE_UNIDAD[] = {
+    {"\xCE\xA9", unidadElectrica::ohmio}, {"\xE2\x84\xA6", unidadElectrica::ohmio}, {"ohm", unidadElectrica::ohmio},
+    {"F", unidadElectrica::faradio}, {"H", unidadElectrica::henrio}, {"V", unidadElectrica::voltio}, {"A", unidadElectrica::amperio}
+};
+
+/**
+ * @struct unidadDeTipo
+ * @brief Entrada de UNIDADES_POR_TIPO: raíz del tipo de componente y la unidad de su valor
+ */
+struct unidadDeTipo
+{
+    std::string_view raiz; ///< En minúsculas; basta con que el tipo la contenga
+    unidadElectrica unidad;
+};
+
+/**
+ * @brief Unidad del valor nominal según el tipo de componente
+ */
+constexpr unidadDeTipo UNIDADES_POR_TIPO[] = {
+    {"resist", unidadElectrica::ohmio}, {"capacit", unidadElectrica::faradio}, {"condensador", unidadElectrica::faradio},
+    {"induct", unidadElectrica::henrio}, {"bobina", unidadElectrica::henrio}
+};
+
+/**
+ * @brief Tolerancia relativa al comparar magnitudes canónicas
+ * 
+ * Equivale a ULPS_DE_TOLERANCIA ULPs de un float, porque una de las dos
+ * partes suele venir de valorNominal, que es float.
+ */
+const double TOLERANCIA_CANONICA = ULPS_DE_TOLERANCIA * static_cast<double>(std::numeric_limits<float>::epsilon());
+
+/**
+ * @brief Indica si 'texto' empieza por 'prefijo'
+ * 
+ * Compara el primer byte antes que el resto: los símbolos de PREFIJOS_SI y
+ * SIMBOLOS_DE_UNIDAD casi nunca coinciden y así no se llama a memcmp().
+ */
+inline bool empiezaCon(std::string_view texto, std::string_view prefijo){
+    return texto.size() >= prefijo.size() && (prefijo.empty() || texto.front() == prefijo.front())
+        && texto.compare(0, prefijo.size(), prefijo) == 0;
+}
+
+/**
+ * @brief Unidad del valor de un tipo de componente (ej: "Capacitor cerámico" → faradio)
+ * 
+ * @param tipo tipoDeComponente; se compara sin distinguir mayúsculas ASCII
+ * @return unidadElectrica::ninguna si el tipo no está en UNIDADES_POR_TIPO
+ */
+unidadElectrica unidadDelTipo(std::string_view tipo){
+    std::string minusculas(tipo);
+    for (char& caracter : minusculas) caracter = static_cast<char>(std::tolower(static_cast<unsigned char>(caracter)));
+    for (const unidadDeTipo& entrada : UNIDADES_POR_TIPO)
+    {
+        if (minusculas.find(entrada.raiz) != std::string::npos) return entrada.unidad;
+    }
+    return unidadElectrica::ninguna;
+}
+
+/**
+ * @brief Interpreta un valor con prefijo SI y unidad opcionales
+ * 
+ * @param texto Ej: "10uF", "4.7k", "100 nF", "1kΩ", "50V", "4k7", "4R7"
+ * @param magnitud Salida: valor en la unidad base y unidad (ninguna si no se escribió)
+ * @param conSufijo Salida opcional: true si el texto llevaba prefijo o unidad
+ * @param escala Salida opcional: factor del prefijo SI (1 si no llevaba prefijo)
+ * @return true si todo el texto (sin los espacios de los extremos) es un valor válido
+ * 
+ * @details
+ * Admite un espacio entre el número y el sufijo, y la notación de los
+ * códigos de componentes en la que el prefijo ocupa el lugar del punto
+ * decimal: "4k7" es 4.7k, "2M2" es 2.2M y "4R7" es 4.7 Ω. Primero se prueba
+ * el sufijo como unidad y después como prefijo seguido de unidad, así "m" es
+ * mili, "M" mega y "F" faradio. No usa memoria dinámica.
+ * 
+ * @par Ejemplo de uso:
+ * @code
+ * magnitudElectrica m;
+ * interpretarMagnitud("10uF", m);  // m.valor == 1e-05, m.unidad == unidadElectrica::faradio
+ * @endcode
+ */
+bool interpretarMagnitud(std::string_view texto, magnitudElectrica& magnitud, bool* conSufijo = nullptr, double* escala = nullptr){
+    while (!texto.empty() && texto.front() == ' ') texto.remove_prefix(1);
+    while (!texto.empty() && texto.back() == ' ') texto.remove_suffix(1);
+    if (!texto.empty() && texto.front() == '+') texto.remove_prefix(1);
+    // Evita que std::from_chars() acepte "inf" o "nan" al inicio de una palabra
+    if (texto.empty() || !(std::isdigit(static_cast<unsigned char>(texto.front())) || texto.front() == '.' || texto.front() == '-')) return false;
+
+    double numero;
+    auto leido = std::from_chars(texto.data(), texto.data() + texto.size(), numero);
+    if (leido.ec != std::errc()) return false;
+    const bool entero = std::string_view(texto.data(), leido.ptr - texto.data()).find_first_of(".eE") == std::string_view::npos;
+    std::string_view resto(leido.ptr, texto.data() + texto.size() - leido.ptr);
+
+    double factor = 1.0;
+    unidadElectrica unidad = unidadElectrica::ninguna;
+    bool sufijo = false;
+    auto esUnidad = [&unidad](std::string_view candidato) {
+        for (const simboloDeUnidad& entrada : SIMBOLOS_DE_UNIDAD)
+        {
+            if (candidato.size() == entrada.simbolo.size() && empiezaCon(candidato, entrada.simbolo)) {
+                unidad = entrada.unidad;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    if (entero && resto.find_first_of("0123456789") != std::string_view::npos) {
+        // Notación de código: el prefijo (o R, ohmios) entre la parte entera y la decimal
+        auto probarCodigo = [&](std::string_view simbolo, double factorDelSimbolo) {
+            if (resto.size() <= simbolo.size() || !empiezaCon(resto, simbolo)
+                || !std::isdigit(static_cast<unsigned char>(resto[simbolo.size()]))) {
+                return false;
+            }
+            const char* decimales = resto.data() + simbolo.size();
+            const char* finDecimales = decimales;
+            while (finDecimales < resto.data() + resto.size() && std::isdigit(static_cast<unsigned char>(*finDecimales))) finDecimales++;
+            double fraccion = 0;
+            std::from_chars(decimales, finDecimales, fraccion);
+            numero += fraccion / std::pow(10.0, static_cast<double>(finDecimales - decimales));
+            factor = factorDelSimbolo;
+            resto = std::string_view(finDecimales, resto.data() + resto.size() - finDecimales);
+            return true;
+        };
+        if (probarCodigo("R", 1.0)) {
+            unidad = unidadElectrica::ohmio;
+            sufijo = true;
+        } else {
+            for (const prefijoSI& prefijo : PREFIJOS_SI)
+            {
+                if (probarCodigo(prefijo.simbolo, prefijo.factor)) {
+                    sufijo = true;
+                    break;
+                }
+            }
+        }
+        if (sufijo) {
+            const unidadElectrica deCodigo = unidad;
+            if (!resto.empty() && (!esUnidad(resto) || (deCodigo != unidadElectrica::ninguna && unidad != deCodigo))) return false;
+            magnitud = {numero * factor, unidad};
+            if (conSufijo) *conSufijo = true;
+            if (escala) *escala = factor;
+            return true;
+        }
+    }
+
+    if (!resto.empty() && resto.front() == ' ') resto.remove_prefix(1);
+    if (!resto.empty() && !esUnidad(resto)) {
+        bool conPrefijo = false;
+        for (const prefijoSI& prefijo : PREFIJOS_SI)
+        {
+            if (!empiezaCon(resto, prefijo.simbolo)) continue;
+            const std::string_view tras = resto.substr(prefijo.simbolo.size());
+            if (tras.empty() || esUnidad(tras)) {
+                factor = prefijo.factor;
+                conPrefijo = true;
+                break;
+            }
+        }
+        if (!conPrefijo) return false;
+    }
+    magnitud = {numero * factor, unidad};
+    if (conSufijo) *conSufijo = !resto.empty();
+    if (escala) *escala = factor;
+    return true;
+}
+
+/**
+ * @brief Valor canónico (unidad SI base) y unidad de un componente
+ * 
+ * @param nombre nombreDelComponente, que solo aporta la unidad y, a veces, la escala (ej: "Capacitor 10uF 50V")
+ * @param esperada Unidad del tipo de componente (unidadDelTipo()), que se usa cuando el texto no la indica
+ * @param valorNominal Valor del componente; es la fuente del resultado
+ * @return magnitudElectrica Valor en la unidad base y su unidad
+ * 
+ * @details
+ * El valor sale siempre de valorNominal, así que editar el campo "valor"
+ * cambia lo que ven las consultas con unidades. El nombre solo sirve de
+ * pista: se toma la primera palabra que interpretarMagnitud() acepta con
+ * prefijo o unidad (un número suelto como "#12" o "0" no cuenta) y cuya
+ * unidad coincide con la del tipo. En "Capacitor 10uF 50V" es "10uF"; "50V"
+ * es la tensión. Una palabra solo con prefijo ("4.7K") toma la unidad del tipo.
+ * 
+ * - La unidad es la de esa palabra, o la del tipo si no hay ninguna
+ * - Si valorNominal es el número de la palabra sin su prefijo (10 en un
+ *   "10uF" guardado sin convertir), se le aplica el prefijo: 1e-05
+ * - En cualquier otro caso valorNominal ya está en la unidad base (ver
+ *   convertirValorNominal()) y se usa tal cual
+ * 
+ * @see tablaDeComponentes::agregar() Para el cálculo al cargar
+ */
+magnitudElectrica magnitudCanonica(std::string_view nombre, unidadElectrica esperada, float valorNominal){
+    size_t inicio = 0;
+    while (inicio < nombre.size())
+    {
+        size_t fin = nombre.find(' ', inicio);
+        if (fin == std::string_view::npos) fin = nombre.size();
+        magnitudElectrica magnitud;
+        bool conSufijo = false;
+        double escala = 1.0;
+        if (fin > inicio && interpretarMagnitud(nombre.substr(inicio, fin - inicio), magnitud, &conSufijo, &escala) && conSufijo) {
+            if (magnitud.unidad == unidadElectrica::ninguna) magnitud.unidad = esperada;
+            if (esperada == unidadElectrica::ninguna || magnitud.unidad == esperada) {
+                const bool sinPrefijo = escala != 1.0 && sonAproximadamenteIguales(valorNominal, static_cast<float>(magnitud.valor / escala))
+                    && !sonAproximadamenteIguales(valorNominal, static_cast<float>(magnitud.valor));
+                return {sinPrefijo ? valorNominal * escala : static_cast<double>(valorNominal), magnitud.unidad};
+            }
+        }
+        inicio = fin + 1;
+    }
+    return {valorNominal, esperada};
+}
+
+/**
+ * @brief Valor canónico de un componente cuyo tipo se da como texto
+ */
+magnitudElectrica magnitudCanonica(std::string_view nombre, std::string_view tipo, float valorNominal){
+    return magnitudCanonica(nombre, unidadDelTipo(tipo), valorNominal);
+}
+
+/**
+ * @brief Convierte un valor nominal escrito con o sin prefijo SI
+ * 
+ * @param texto Ej: "10uF" (→ 1e-05), "4k7" (→ 4700) o "0.5"
+ * @param valor Salida: valor en la unidad base
+ * @return false si no es un número válido
+ * 
+ * @details Si el texto no es una magnitud con sufijo (interpretarMagnitud()),
+ * se interpreta con convertirFlotante(), como los demás campos numéricos.
+ */
+bool convertirValorNominal(std::string_view texto, float& valor){
+    magnitudElectrica magnitud;
+    bool conSufijo = false;
+    if (interpretarMagnitud(texto, magnitud, &conSufijo) && conSufijo) {
+        valor = static_cast<float>(magnitud.valor);
+        return true;
+    }
+    return convertirFlotante(texto, valor);
+}
+
+/**
+ * @enum campoDeBusqueda
+ * @brief Campo de la estructura componente sobre el que se evalúa un criterio
+ */
+enum class campoDeBusqueda
+{
+    nombre,       ///< nombreDelComponente (subcadena)
+    tipo,         ///< tipoDeComponente (subcadena)
+    valorNominal, ///< valorNominal (igualdad tolerante a redondeo)
+    tolerancia,   ///< tolerancia (igualdad tolerante a redondeo)
+    voltaje,      ///< voltajeDeTrabajo (igualdad tolerante a redondeo)
+    estado        ///< estado (subcadena)
+};
+
+/**
+ * @struct criterioDeBusqueda
+ * @brief Criterio de búsqueda sobre un solo campo, con la misma semántica que buscarPor*()
+ * 
+ * @details
+ * Los campos de texto se comparan por subcadena sensible a mayúsculas (como
+ * buscarPorNombre()) y los numéricos por igualdad tolerante al redondeo
+ * (como buscarPorValorNominal() en modo exacto, ver sonAproximadamenteIguales()).
+ * Solo se usa 'texto' o 'valor', según el campo.
+ * 
+ * @see cumpleCriterio()
+ */
+struct criterioDeBusqueda
+{
+    campoDeBusqueda campo{campoDeBusqueda::nombre}; ///< Campo a evaluar
+    std::string texto; ///< Subcadena buscada (campos de texto)
+    float valor{0.00}; ///< Valor buscado (campos numéricos)
+};
+
+/**
+ * @brief Interpreta el nombre de un campo escrito en la línea de comandos
+ * 
+ * @param nombre Uno de: nombre, tipo, valor, tolerancia, voltaje, estado
+ * @param campo Salida: campo correspondiente
+ * @return false si el nombre no corresponde a ningún campo
+ */
+bool interpretarCampo(const std::string& nombre, campoDeBusqueda& campo){
+    if (nombre == "nombre") campo = campoDeBusqueda::nombre;
+    else if (nombre == "tipo") campo = campoDeBusqueda::tipo;
+    else if (nombre == "valor") campo = campoDeBusqueda::valorNominal;
+    else if (nombre == "tolerancia") campo = campoDeBusqueda::tolerancia;
+    else if (nombre == "voltaje") campo = campoDeBusqueda::voltaje;
+    else if (nombre == "estado") campo = campoDeBusqueda::estado;
+    else return false;
+    return true;
+}
+
+/**
+ * @brief Evalúa un criterio de búsqueda sobre un componente
+ * 
+ * @param c Componente a evaluar (componente o vistaComponente)
+ * @param criterio Criterio a aplicar
+ * @return true si el componente cumple el criterio
+ */
+template<class Registro>
+bool cumpleCriterio(const Registro& c, const criterioDeBusqueda& criterio){
+    switch (criterio.campo)
+    {
+    case campoDeBusqueda::nombre:
+        return c.nombreDelComponente.find(criterio.texto) != std::string::npos;
+    case campoDeBusqueda::tipo:
+        return c.tipoDeComponente.find(criterio.texto) != std::string::npos;
+    case campoDeBusqueda::valorNominal:
+        return sonAproximadamenteIguales(c.valorNominal, criterio.valor);
+    case campoDeBusqueda::tolerancia:
+        return sonAproximadamenteIguales(c.tolerancia, criterio.valor);
+    case campoDeBusqueda::voltaje:
+        return sonAproximadamenteIguales(c.voltajeDeTrabajo, criterio.valor);
+    case campoDeBusqueda::estado:
+        return c.estado.find(criterio.texto) != std::string::npos;
+    }
+    return false;
+}
+
+/**
+ * @brief Obtiene el valor de un campo numérico de un componente
+ * 
+ * @param c Componente (componente o vistaComponente)
+ * @param campo valorNominal, tolerancia o voltaje
+ * @return float Valor del campo
+ */
+template<class Registro>
+float valorDeCampo(const Registro& c, campoDeBusqueda campo){
+    switch (campo)
+    {
+    case campoDeBusqueda::tolerancia:
+        return c.tolerancia;
+    case campoDeBusqueda::voltaje:
+        return c.voltajeDeTrabajo;
+    default:
+        return c.valorNominal;
+    }
+}
+
+/**
+ * @enum modoNumerico
+ * @brief Tipo de comparación de una consulta sobre un campo numérico
+ */
+enum class modoNumerico
+{
+    igual,   ///< Igualdad tolerante a redondeo (ver sonAproximadamenteIguales())
+    rango,   ///< minimo <= valor <= maximo
+    cercano  ///< Valor(es) más cercano(s) a 'minimo'
+};
+
+/**
+ * @struct consultaNumerica
+ * @brief Consulta sobre un campo numérico: valor exacto, rango o valor más cercano
+ */
+struct consultaNumerica
+{
+    modoNumerico modo{modoNumerico::igual}; ///< Tipo de comparación
+    float minimo{0.00}; ///< Valor buscado, o límite inferior del rango
+    float maximo{0.00}; ///< Límite superior del rango (solo modoNumerico::rango)
+};
+
+/**
+ * @brief Solicita al usuario el tipo de consulta numérica y sus valores
+ * 
+ * @param descripcion Nombre del campo para los mensajes (ej: "el voltaje")
+ * @return consultaNumerica Consulta validada
+ * 
+ * @details
+ * Muestra las opciones:
+ * - (1) Valor exacto (tolerante al redondeo del archivo de texto)
+ * - (2) Rango, pidiendo mínimo y máximo (se intercambian si vienen al revés)
+ * - (3) Valor más cercano
+ * 
+ * Cualquier otra opción se interpreta como valor exacto.
+ * 
+ * @par Ejemplo de flujo:
+ * @code{.sh}
+ * (1) Valor exacto  (2) Rango  (3) Valor más cercano
+ * > 2
+ * Ingrese el mínimo para el voltaje: 12
+ * Ingrese el máximo para el voltaje: 50
+ * @endcode
+ * 
+ * @see solicitarNumero()
+ */
+consultaNumerica solicitarConsultaNumerica(const std::string& descripcion){
+    consultaNumerica consulta;
+    int modo = static_cast<int>(solicitarNumero("(1) Valor exacto  (2) Rango  (3) Valor más cercano\n"));
+    if (modo == 2) {
+        consulta.modo = modoNumerico::rango;
+        consulta.minimo = solicitarNumero("Ingrese el mínimo para " + descripcion + ": ");
+        consulta.maximo = solicitarNumero("Ingrese el máximo para " + descripcion + ": ");
+        if (consulta.minimo > consulta.maximo) std::swap(consulta.minimo, consulta.maximo);
+    } else {
+        consulta.modo = modo == 3 ? modoNumerico::cercano : modoNumerico::igual;
+        consulta.minimo = solicitarNumero("Ingrese " + descripcion + " del componente que desea encontrar \n");
+        consulta.maximo = consulta.minimo;
+    }
+    return consulta;
+}
+
+/**
+ * @struct indiceNumerico
+ * @brief Índice ordenado (valor, posición) de un campo numérico de un vector de componentes
+ * 
+ * @details
+ * Las entradas se ordenan por valor y, a igualdad de valor, por posición en el
+ * vector. Las consultas usan búsqueda binaria: O(log n) para localizar el
+ * inicio y O(k) para recorrer las k coincidencias. Los NaN no se indexan.
+ * 
+ * Las posiciones ocupan 32 bits para que cada entrada quepa en 8 bytes; por
+ * eso solo se indexan colecciones de hasta MAXIMO_DE_FILAS_INDEXABLES filas.
+ * 
+ * @see construirIndiceNumerico()
+ * @see consultarIndiceNumerico()
+ */
+struct indiceNumerico
+{
+    std::vector<std::pair<float, uint32_t>> entradas; ///< (valor, posición en el vector)
+};
+
+/// Número máximo de filas de una colección indexable: sus posiciones deben caber en uint32_t
+const size_t MAXIMO_DE_FILAS_INDEXABLES = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Construye el índice ordenado de un campo numérico
+ * 
+ * @param registros Componentes a indexar: std::vector<componente> o registroEnArena
+ * @param campo valorNominal, tolerancia o voltaje
+ * @return indiceNumerico Índice ordenado
+ * 
+ * @pre registros.size() <= MAXIMO_DE_FILAS_INDEXABLES (ver indiceDeCampo()); si
+ *      no se cumple, el índice queda vacío en lugar de confundir posiciones
+ */
+template<class Coleccion>
+indiceNumerico construirIndiceNumerico(const Coleccion& registros, campoDeBusqueda campo){
+    indiceNumerico indice;
+    if (registros.size() > MAXIMO_DE_FILAS_INDEXABLES) return indice;
+    indice.entradas.reserve(registros.size());
+    for (size_t i = 0; i < registros.size(); i++)
+    {
+        float valor = valorDeCampo(registros[i], campo);
+        if (!std::isnan(valor)) indice.entradas.emplace_back(valor, static_cast<uint32_t>(i));
+    }
+    std::sort(indice.entradas.begin(), indice.entradas.end());
+    return indice;
+}
+
+/**
+ * @brief Resuelve una consulta numérica con búsqueda binaria sobre el índice
+ * 
+ * @param indice Índice del campo consultado
+ * @param consulta Consulta a resolver
+ * @return std::vector<uint32_t> Posiciones coincidentes, en el orden del vector original
+ * 
+ * @details
+ * - igual: rango [valor - 16 ULPs, valor + 16 ULPs]
+ * - rango: [minimo, maximo]
+ * - cercano: localiza el valor con lower_bound() y compara con su vecino
+ *   anterior; devuelve todas las entradas con el valor (o los dos valores, si
+ *   empatan en distancia) más próximo
+ * 
+ * @see sonAproximadamenteIguales()
+ */
+std::vector<uint32_t> consultarIndiceNumerico(const indiceNumerico& indice, const consultaNumerica& consulta){
+    const auto& entradas = indice.entradas;
+    auto porValor = [](const std::pair<float, uint32_t>& entrada, float valor) { return entrada.first < valor; };
+    auto valorAntes = [](float valor, const std::pair<float, uint32_t>& entrada) { return valor < entrada.first; };
+    auto agregarRango = [&](float minimo, float maximo, std::vector<uint32_t>& salida) {
+        auto desde = std::lower_bound(entradas.begin(), entradas.end(), minimo, porValor);
+        auto hasta = std::upper_bound(desde, entradas.end(), maximo, valorAntes);
+        for (auto it = desde; it != hasta; ++it) salida.push_back(it->second);
+    };
+
+    std::vector<uint32_t> posiciones;
+    switch (consulta.modo)
+    {
+    case modoNumerico::igual:
+        agregarRango(desplazarUlps(consulta.minimo, -ULPS_DE_TOLERANCIA), desplazarUlps(consulta.minimo, ULPS_DE_TOLERANCIA), posiciones);
+        break;
+    case modoNumerico::rango:
+        agregarRango(consulta.minimo, consulta.maximo, posiciones);
+        break;
+    case modoNumerico::cercano: {
+        if (entradas.empty()) break;
+        auto siguiente = std::lower_bound(entradas.begin(), entradas.end(), consulta.minimo, porValor);
+        float distanciaSiguiente = siguiente != entradas.end() ? std::abs(siguiente->first - consulta.minimo) : std::numeric_limits<float>::infinity();
+        float distanciaAnterior = siguiente != entradas.begin() ? std::abs(std::prev(siguiente)->first - consulta.minimo) : std::numeric_limits<float>::infinity();
+        if (distanciaAnterior <= distanciaSiguiente) {
+            float valor = std::prev(siguiente)->first;
+            agregarRango(valor, valor, posiciones);
+        }
+        if (distanciaSiguiente <= distanciaAnterior) {
+            float valor = siguiente->first;
+            agregarRango(valor, valor, posiciones);
+        }
+        break;
+    }
+    }
+    std::sort(posiciones.begin(), posiciones.end());
+    return posiciones;
+}
+
+/**
+ * @struct entradaCanonica
+ * @brief Entrada de indiceCanonico: magnitud canónica de una fila
+ */
+struct entradaCanonica
+{
+    unidadElectrica unidad; ///< Unidad del valor
+    double valor;           ///< Valor en la unidad base
+    uint32_t fila;          ///< Posición en la tabla
+
+    bool operator<(const entradaCanonica& otra) const {
+        if (unidad != otra.unidad) return unidad < otra.unidad;
+        if (valor != otra.valor) return valor < otra.valor;
+        return fila < otra.fila;
+    }
+};
+
+/**
+ * @struct indiceCanonico
+ * @brief Índice ordenado por (unidad, valor canónico, fila) de una tablaDeComponentes
+ * 
+ * @details
+ * Al ordenar primero por unidad, los valores de cada unidad quedan contiguos:
+ * "valor>=1nF y valor<=100nF" son dos búsquedas binarias dentro del tramo de
+ * los faradios, sin mezclar 10 nF con 10 Ω.
+ * 
+ * @see construirIndiceCanonico()
+ * @see recorrerIndiceCanonico()
+ */
+struct indiceCanonico
+{
+    std::vector<entradaCanonica> entradas; ///< Ordenadas con entradaCanonica::operator<
+};
+
+/**
+ * @struct indicesNumericos
+ * @brief Índices de los tres campos numéricos de un vector, construidos bajo demanda
+ * 
+ * @details
+ * Cada índice se construye la primera vez que se consulta su campo y se
+ * reutiliza en las búsquedas siguientes sobre el mismo vector. Si el vector
+ * cambia, hay que descartar la estructura (asignarle indicesNumericos()).
+ * 
+ * @see indiceDeCampo()
+ */
+struct indicesNumericos
+{
+    indiceNumerico porCampo[3]; ///< valorNominal, tolerancia, voltaje
+    bool construido[3]{false, false, false}; ///< Si el índice correspondiente ya existe
+    indiceCanonico canonico; ///< Valores canónicos de la tabla (ver indiceCanonicoDe())
+    bool canonicoConstruido{false}; ///< Si 'canonico' ya existe
+};
+
+/**
+ * @brief Devuelve el índice de un campo numérico, construyéndolo si aún no existe
+ * 
+ * @param indices Índices asociados a 'registros'
+ * @param registros Vector indexado
+ * @param campo valorNominal, tolerancia o voltaje
+ * @return const indiceNumerico* Índice del campo, o nullptr si 'registros' tiene
+ *         más de MAXIMO_DE_FILAS_INDEXABLES filas (hay que recorrerlo)
+ */
+template<class Coleccion>
+const indiceNumerico* indiceDeCampo(indicesNumericos& indices, const Coleccion& registros, campoDeBusqueda campo){
+    if (registros.size() > MAXIMO_DE_FILAS_INDEXABLES) return nullptr;
+    int i = campo == campoDeBusqueda::valorNominal ? 0 : (campo == campoDeBusqueda::tolerancia ? 1 : 2);
+    if (!indices.construido[i]) {
+        indices.porCampo[i] = construirIndiceNumerico(registros, campo);
+        indices.construido[i] = true;
+    }
+    return &indices.porCampo[i];
+}
+
+/**
+ * @struct diccionarioDeCadenas
+ * @brief Diccionario que asigna un código de 16 bits a cada cadena distinta
+ * 
+ * @details
+ * tipoDeComponente y estado toman muy pocos valores distintos (decenas de
+ * tipos, 3-5 estados) repetidos en millones de registros. En lugar de guardar
+ * una std::string por registro (32 bytes más la memoria dinámica de las
+ * cadenas largas), la tabla guarda el código del valor, y el valor se guarda
+ * una sola vez aquí. Los códigos se asignan en orden de aparición.
+ * 
+ * También cuenta cuántas veces se codificó cada valor; en una tabla es el
+ * número de filas con ese valor, que usa el motor de consultas para estimar
+ * la selectividad de un criterio sin recorrer la columna.
+ * 
+ * @see tablaDeComponentes
+ * @see codigosQueCumplen()
+ */
+struct diccionarioDeCadenas
+{
+    std::vector<std::string> valores; ///< Código → cadena
+    std::unordered_map<std::string, uint16_t> codigos; ///< Cadena → código
+    std::vector<uint64_t> apariciones; ///< Código → veces que se codificó
+
+    static const size_t CAPACIDAD = 65536; ///< Número máximo de valores distintos
+
+    /**
+     * @brief Obtiene el código de una cadena, agregándola si es nueva
+     * 
+     * @param valor Cadena a codificar
+     * @param codigo Salida: código asignado
+     * @return false si la cadena es nueva y el diccionario está lleno
+     * 
+     * @post Si tiene éxito, apariciones[codigo] aumenta en 1
+     */
+    bool codificar(const std::string& valor, uint16_t& codigo){
+        auto existente = codigos.find(valor);
+        if (existente != codigos.end()) {
+            codigo = existente->second;
+            apariciones[codigo]++;
+            return true;
+        }
+        if (valores.size() >= CAPACIDAD) return false;
+        codigo = static_cast<uint16_t>(valores.size());
+        valores.push_back(valor);
+        codigos.emplace(valor, codigo);
+        apariciones.push_back(1);
+        return true;
+    }
+
+    /**
+     * @brief Obtiene el código de una cadena que no es std::string (ej: de una vistaComponente)
+     * 
+     * @details std::unordered_map no busca por std::string_view en C++17; la
+     * cadena se copia en 'buscada', que conserva su capacidad entre llamadas,
+     * así que solo reserva memoria cuando llega una cadena más larga que todas
+     * las anteriores.
+     */
+    bool codificar(std::string_view valor, uint16_t& codigo){
+        buscada.assign(valor);
+        return codificar(buscada, codigo);
+    }
+
+private:
+    std::string buscada; ///< Copia reutilizada de la cadena buscada por codificar(std::string_view)
+};
+
+/**
+ * @struct tablaDeComponentes
+ * @brief Representación columnar (estructura de arreglos) de un conjunto de componentes
+ * 
+ * @details
+ * std::vector<componente> intercala tres std::string con tres float: recorrer
+ * un solo campo numérico trae a caché más de 100 bytes por registro para usar
+ * 4. Aquí cada campo es un arreglo contiguo propio, de modo que un filtro sobre
+ * voltajeDeTrabajo lee exactamente n * 4 bytes y puede evaluarse con
+ * instrucciones vectoriales (ver seleccionarEnRango()).
+ * 
+ * Los tipos y estados se guardan como códigos de 16 bits de un
+ * diccionarioDeCadenas: 4 bytes por registro en lugar de 64, y los filtros
+ * sobre ellos evalúan la cadena una vez por valor distinto (ver
+ * seleccionarPorCodigos()).
+ * 
+ * La fila i está formada por el elemento i de cada columna. Es la misma
+ * disposición que el formato binario (ver cabeceraBinaria), cuyas columnas
+ * proyectadas se filtran con los mismos núcleos sin copiarlas.
+ * 
+ * @see tablaDesdeRegistros()
+ * @see registrosDesdeTabla()
+ */
+struct tablaDeComponentes
+{
+    std::vector<std::string> nombres;    ///< Columna nombreDelComponente
+    std::vector<uint16_t> tipos;         ///< Columna tipoDeComponente (códigos de diccionarioDeTipos)
+    std::vector<float> valoresNominales; ///< Columna valorNominal
+    std::vector<float> tolerancias;      ///< Columna tolerancia
+    std::vector<float> voltajes;         ///< Columna voltajeDeTrabajo
+    std::vector<uint16_t> estados;       ///< Columna estado (códigos de diccionarioDeEstados)
+    std::vector<double> magnitudes;      ///< Valor canónico en la unidad base (ver magnitudCanonica())
+    std::vector<unidadElectrica> unidades; ///< Unidad de 'magnitudes'
+    std::vector<unidadElectrica> unidadesDeTipos; ///< unidadDelTipo() de cada código de diccionarioDeTipos
+    diccionarioDeCadenas diccionarioDeTipos;   ///< Valores distintos de tipoDeComponente
+    diccionarioDeCadenas diccionarioDeEstados; ///< Valores distintos de estado
+
+    size_t size() const { return nombres.size(); } ///< Número de filas
+
+    /**
+     * @brief Reserva espacio para 'cantidad' filas en todas las columnas
+     */
+    void reservar(size_t cantidad){
+        nombres.reserve(cantidad);
+        tipos.reserve(cantidad);
+        valoresNominales.reserve(cantidad);
+        tolerancias.reserve(cantidad);
+        voltajes.reserve(cantidad);
+        estados.reserve(cantidad);
+        magnitudes.reserve(cantidad);
+        unidades.reserve(cantidad);
+    }
+
+    /**
+     * @brief Agrega una fila al final de la tabla copiando el componente
+     * 
+     * @param c Componente a agregar (solo se copia su nombre; tipo y estado se codifican)
+     * @return false si su tipo o estado no cabe en el diccionario; la tabla no cambia
+     */
+    bool agregar(const componente& c){
+        return agregarFila(c, std::string(c.nombreDelComponente));
+    }
+
+    /**
+     * @brief Agrega una fila al final de la tabla a partir de una vista
+     * 
+     * @param c Componente a agregar (solo se copia su nombre; tipo y estado se codifican)
+     * @return false si su tipo o estado no cabe en el diccionario; la tabla no cambia
+     */
+    bool agregar(const vistaComponente& c){
+        return agregarFila(c, std::string(c.nombreDelComponente));
+    }
+
+    /**
+     * @brief Agrega una fila al final de la tabla
+     * 
+     * @param c Componente a agregar (su nombre se mueve a la tabla)
+     * @return false si su tipo o estado no cabe en el diccionario; la tabla no cambia
+     */
+    bool agregar(componente&& c){
+        return agregarFila(c, std::move(c.nombreDelComponente));
+    }
+
+    /**
+     * @brief Agrega una fila con los campos de 'c' y el nombre ya preparado
+     * 
+     * @param c componente o vistaComponente del que se leen los demás campos
+     * @param nombre Nombre de la fila; solo se mueve a la tabla si la fila se agrega
+     * @return false si su tipo o estado no cabe en el diccionario; la tabla no cambia
+     * 
+     * @details El valor canónico se calcula aquí, una vez por fila, para que las
+     * consultas con unidades comparen dos double sin volver a leer el nombre.
+     */
+    template<class Registro>
+    bool agregarFila(const Registro& c, std::string&& nombre){
+        uint16_t tipo;
+        uint16_t estado;
+        if (!diccionarioDeTipos.codificar(c.tipoDeComponente, tipo)
+            || !diccionarioDeEstados.codificar(c.estado, estado)) {
+            return false;
+        }
+        if (tipo >= unidadesDeTipos.size()) unidadesDeTipos.push_back(unidadDelTipo(c.tipoDeComponente));
+        const magnitudElectrica magnitud = magnitudCanonica(nombre, unidadesDeTipos[tipo], c.valorNominal);
+        magnitudes.push_back(magnitud.valor);
+        unidades.push_back(magnitud.unidad);
+        nombres.push_back(std::move(nombre));
+        tipos.push_back(tipo);
+        valoresNominales.push_back(c.valorNominal);
+        tolerancias.push_back(c.tolerancia);
+        voltajes.push_back(c.voltajeDeTrabajo);
+        estados.push_back(estado);
+        return true;
+    }
+
+    /**
+     * @brief Devuelve la fila i como vista, sin copiar las cadenas
+     */
+    vistaComponente fila(size_t i) const {
+        vistaComponente vista;
+        vista.nombreDelComponente = nombres[i];
+        vista.tipoDeComponente = diccionarioDeTipos.valores[tipos[i]];
+        vista.valorNominal = valoresNominales[i];
+        vista.tolerancia = tolerancias[i];
+        vista.voltajeDeTrabajo = voltajes[i];
+        vista.estado = diccionarioDeEstados.valores[estados[i]];
+        return vista;
+    }
+
+    /**
+     * @brief Devuelve la columna de un campo numérico
+     * 
+     * @param campo valorNominal, tolerancia o voltaje
+     */
+    const std::vector<float>& columna(campoDeBusqueda campo) const {
+        if (campo == campoDeBusqueda::valorNominal) return valoresNominales;
+        if (campo == campoDeBusqueda::tolerancia) return tolerancias;
+        return voltajes;
+    }
+};
+
+/**
+ * @brief Construye el índice de valores canónicos de una tabla
+ * 
+ * @param tabla Tabla con las columnas magnitudes y unidades
+ * @return indiceCanonico Índice ordenado; los NaN no se indexan
+ * 
+ * @pre tabla.size() <= MAXIMO_DE_FILAS_INDEXABLES (ver indiceCanonicoDe())
+ */
+indiceCanonico construirIndiceCanonico(const tablaDeComponentes& tabla){
+    indiceCanonico indice;
+    if (tabla.size() > MAXIMO_DE_FILAS_INDEXABLES) return indice;
+    indice.entradas.reserve(tabla.size());
+    for (size_t i = 0; i < tabla.size(); i++)
+    {
+        if (!std::isnan(tabla.magnitudes[i])) indice.entradas.push_back({tabla.unidades[i], tabla.magnitudes[i], static_cast<uint32_t>(i)});
+    }
+    std::sort(indice.entradas.begin(), indice.entradas.end());
+    return indice;
+}
+
+/**
+ * @brief Devuelve el índice canónico de una tabla, construyéndolo si aún no existe
+ * 
+ * @param indices Índices asociados a las filas de 'tabla'
+ * @param tabla Tabla indexada
+ * @return const indiceCanonico* El índice, o nullptr si la tabla tiene más de
+ *         MAXIMO_DE_FILAS_INDEXABLES filas (las consultas recorren las columnas)
+ */
+const indiceCanonico* indiceCanonicoDe(indicesNumericos& indices, const tablaDeComponentes& tabla){
+    if (tabla.size() > MAXIMO_DE_FILAS_INDEXABLES) return nullptr;
+    if (!indices.canonicoConstruido) {
+        indices.canonico = construirIndiceCanonico(tabla);
+        indices.canonicoConstruido = true;
+    }
+    return &indices.canonico;
+}
+
+/**
+ * @brief Convierte un conjunto de componentes a su representación columnar
+ * 
+ * @param registros Componentes en el orden original: std::vector<componente> o registroEnArena
+ * @return tablaDeComponentes Tabla con las mismas filas en el mismo orden
+ * 
+ * @post Si hay más de diccionarioDeCadenas::CAPACIDAD tipos o estados
+ *       distintos, muestra un error y la tabla se detiene en la primera fila
+ *       que no cabe (tabla.size() < registros.size())
+ * 
+ * @note Los nombres se copian; para moverlos, pasar el vector con std::move()
+ */
+template<class Coleccion>
+tablaDeComponentes tablaDesdeRegistros(const Coleccion& registros){
+    tablaDeComponentes tabla;
+    tabla.reservar(registros.size());
+    for (const auto& c : registros)
+    {
+        if (!tabla.agregar(c)) {
+            std::cout << "La tabla admite como máximo " << diccionarioDeCadenas::CAPACIDAD << " tipos y estados distintos.\n";
+            break;
+        }
+    }
+    return tabla;
+}
+
+/**
+ * @brief Convierte un vector de componentes a columnas moviendo sus nombres
+ * 
+ * @param registros Vector que se consume (queda con nombres vacíos)
+ * @return tablaDeComponentes Tabla con las mismas filas en el mismo orden
+ * 
+ * @post Mismo tratamiento del diccionario lleno que la versión que copia
+ */
+tablaDeComponentes tablaDesdeRegistros(std::vector<componente>&& registros){
+    tablaDeComponentes tabla;
+    tabla.reservar(registros.size());
+    for (componente& c : registros)
+    {
+        if (!tabla.agregar(std::move(c))) {
+            std::cout << "La tabla admite como máximo " << diccionarioDeCadenas::CAPACIDAD << " tipos y estados distintos.\n";
+            break;
+        }
+    }
+    return tabla;
+}
+
+/**
+ * @brief Convierte una tabla columnar de vuelta a un vector de componentes
+ * 
+ * @param tabla Tabla de origen
+ * @return std::vector<componente> Componentes en el orden de las filas
+ */
+std::vector<componente> registrosDesdeTabla(const tablaDeComponentes& tabla){
+    std::vector<componente> registros(tabla.size());
+    for (size_t i = 0; i < tabla.size(); i++)
+    {
+        registros[i].nombreDelComponente = tabla.nombres[i];
+        registros[i].tipoDeComponente = tabla.diccionarioDeTipos.valores[tabla.tipos[i]];
+        registros[i].valorNominal = tabla.valoresNominales[i];
+        registros[i].tolerancia = tabla.tolerancias[i];
+        registros[i].voltajeDeTrabajo = tabla.voltajes[i];
+        registros[i].estado = tabla.diccionarioDeEstados.valores[tabla.estados[i]];
+    }
+    return registros;
+}
+
+/**
+ * @brief Mapa de bits de selección: el bit (i % 64) de la palabra i / 64 indica si la fila i cumple
+ */
+using mascaraDeSeleccion = std::vector<uint64_t>;
+
+/**
+ * @brief Posición del bit activo menos significativo de una palabra distinta de 0
+ */
+inline unsigned primerBitActivo(uint64_t palabra){
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(palabra));
+#else
+    unsigned posicion = 0;
+    while ((palabra & 1) == 0) { palabra >>= 1; posicion++; }
+    return posicion;
+#endif
+}
+
+/**
+ * @brief Recorre en orden las filas seleccionadas de una máscara
+ * 
+ * @param mascara Máscara producida por seleccionarPorConsulta()
+ * @param visitar Función llamada con el número de cada fila seleccionada;
+ *                si devuelve false el recorrido se detiene
+ * @return uint64_t Número de filas visitadas
+ */
+template<class Funcion>
+uint64_t recorrerSeleccion(const mascaraDeSeleccion& mascara, Funcion visitar){
+    uint64_t cantidad = 0;
+    for (size_t palabra = 0; palabra < mascara.size(); palabra++)
+    {
+        for (uint64_t bits = mascara[palabra]; bits != 0; bits &= bits - 1)
+        {
+            cantidad++;
+            if (!visitar(palabra * 64 + primerBitActivo(bits))) return cantidad;
+        }
+    }
+    return cantidad;
+}
+
+/**
+ * @brief Marca las filas de una columna cuyo valor está en [minimo, maximo]
+ * 
+ * @param columna Valores contiguos de un campo numérico
+ * @param n Número de filas
+ * @param minimo Límite inferior (incluido)
+ * @param maximo Límite superior (incluido)
+ * @return mascaraDeSeleccion Máscara de (n + 63) / 64 palabras
+ * 
+ * @details
+ * Cada palabra de la máscara cubre 64 filas: con AVX2 son 8 comparaciones de
+ * 8 flotantes, con SSE2 16 de 4, y _mm*_movemask_ps convierte cada resultado
+ * en bits sin saltos condicionales. Las filas que no completan una palabra (y
+ * los compiladores sin SSE2) usan el recorrido escalar equivalente. Los NaN
+ * nunca se seleccionan, igual que con las comparaciones escalares.
+ * 
+ * @note AVX2 se usa solo si el programa se compila con -mavx2 o -march=native
+ */
+mascaraDeSeleccion seleccionarEnRango(const float* columna, size_t n, float minimo, float maximo){
+    mascaraDeSeleccion mascara((n + 63) / 64, 0);
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 inferior = _mm256_set1_ps(minimo);
+    const __m256 superior = _mm256_set1_ps(maximo);
+    for (; i + 64 <= n; i += 64)
+    {
+        uint64_t palabra = 0;
+        for (int k = 0; k < 8; k++)
+        {
+            __m256 v = _mm256_loadu_ps(columna + i + 8 * k);
+            __m256 dentro = _mm256_and_ps(_mm256_cmp_ps(v, inferior, _CMP_GE_OQ), _mm256_cmp_ps(v, superior, _CMP_LE_OQ));
+            palabra |= static_cast<uint64_t>(_mm256_movemask_ps(dentro)) << (8 * k);
+        }
+        mascara[i / 64] = palabra;
+    }
+#elif defined(__SSE2__)
+    const __m128 inferior = _mm_set1_ps(minimo);
+    const __m128 superior = _mm_set1_ps(maximo);
+    for (; i + 64 <= n; i += 64)
+    {
+        uint64_t palabra = 0;
+        for (int k = 0; k < 16; k++)
+        {
+            __m128 v = _mm_loadu_ps(columna + i + 4 * k);
+            __m128 dentro = _mm_and_ps(_mm_cmpge_ps(v, inferior), _mm_cmple_ps(v, superior));
+            palabra |= static_cast<uint64_t>(_mm_movemask_ps(dentro)) << (4 * k);
+        }
+        mascara[i / 64] = palabra;
+    }
+#endif
+    for (; i < n; i++)
+    {
+        if (columna[i] >= minimo && columna[i] <= maximo) mascara[i / 64] |= uint64_t{1} << (i % 64);
+    }
+    return mascara;
+}
+
+/**
+ * @brief Calcula la menor distancia |valor - objetivo| de una columna
+ * 
+ * @param columna Valores contiguos de un campo numérico
+ * @param n Número de filas
+ * @param objetivo Valor de referencia
+ * @return float Distancia mínima (infinito si n == 0 o todos son NaN)
+ */
+float distanciaMinima(const float* columna, size_t n, float objetivo){
+    float mejor = std::numeric_limits<float>::infinity();
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 signo = _mm256_set1_ps(-0.0f);
+    const __m256 referencia = _mm256_set1_ps(objetivo);
+    __m256 minimos = _mm256_set1_ps(mejor);
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 distancia = _mm256_andnot_ps(signo, _mm256_sub_ps(_mm256_loadu_ps(columna + i), referencia));
+        minimos = _mm256_min_ps(distancia, minimos); // si 'distancia' es NaN conserva 'minimos'
+    }
+    alignas(32) float parciales[8];
+    _mm256_store_ps(parciales, minimos);
+    for (float parcial : parciales) mejor = std::min(mejor, parcial);
+#elif defined(__SSE2__)
+    const __m128 signo = _mm_set1_ps(-0.0f);
+    const __m128 referencia = _mm_set1_ps(objetivo);
+    __m128 minimos = _mm_set1_ps(mejor);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128 distancia = _mm_andnot_ps(signo, _mm_sub_ps(_mm_loadu_ps(columna + i), referencia));
+        minimos = _mm_min_ps(distancia, minimos); // si 'distancia' es NaN conserva 'minimos'
+    }
+    alignas(16) float parciales[4];
+    _mm_store_ps(parciales, minimos);
+    for (float parcial : parciales) mejor = std::min(mejor, parcial);
+#endif
+    for (; i < n; i++)
+    {
+        float distancia = std::abs(columna[i] - objetivo);
+        if (distancia < mejor) mejor = distancia;
+    }
+    return mejor;
+}
+
+/**
+ * @brief Marca las filas cuya distancia |valor - objetivo| es exactamente 'distancia'
+ * 
+ * @param columna Valores contiguos de un campo numérico
+ * @param n Número de filas
+ * @param objetivo Valor de referencia
+ * @param distancia Distancia buscada (normalmente la de distanciaMinima())
+ * @return mascaraDeSeleccion Máscara de (n + 63) / 64 palabras
+ */
+mascaraDeSeleccion seleccionarPorDistancia(const float* columna, size_t n, float objetivo, float distancia){
+    mascaraDeSeleccion mascara((n + 63) / 64, 0);
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 signo = _mm256_set1_ps(-0.0f);
+    const __m256 referencia = _mm256_set1_ps(objetivo);
+    const __m256 buscada = _mm256_set1_ps(distancia);
+    for (; i + 64 <= n; i += 64)
+    {
+        uint64_t palabra = 0;
+        for (int k = 0; k < 8; k++)
+        {
+            __m256 d = _mm256_andnot_ps(signo, _mm256_sub_ps(_mm256_loadu_ps(columna + i + 8 * k), referencia));
+            palabra |= static_cast<uint64_t>(_mm256_movemask_ps(_mm256_cmp_ps(d, buscada, _CMP_EQ_OQ))) << (8 * k);
+        }
+        mascara[i / 64] = palabra;
+    }
+#elif defined(__SSE2__)
+    const __m128 signo = _mm_set1_ps(-0.0f);
+    const __m128 referencia = _mm_set1_ps(objetivo);
+    const __m128 buscada = _mm_set1_ps(distancia);
+    for (; i + 64 <= n; i += 64)
+    {
+        uint64_t palabra = 0;
+        for (int k = 0; k < 16; k++)
+        {
+            __m128 d = _mm_andnot_ps(signo, _mm_sub_ps(_mm_loadu_ps(columna + i + 4 * k), referencia));
+            palabra |= static_cast<uint64_t>(_mm_movemask_ps(_mm_cmpeq_ps(d, buscada))) << (4 * k);
+        }
+        mascara[i / 64] = palabra;
+    }
+#endif
+    for (; i < n; i++)
+    {
+        if (std::abs(columna[i] - objetivo) == distancia) mascara[i / 64] |= uint64_t{1} << (i % 64);
+    }
+    return mascara;
+}
+
+/**
+ * @brief Evalúa una consulta numérica sobre una columna y devuelve su máscara de selección
+ * 
+ * @param columna Valores contiguos de un campo numérico
+ * @param n Número de filas
+ * @param consulta Consulta a evaluar
+ * @return mascaraDeSeleccion Filas que cumplen la consulta
+ * 
+ * @details
+ * Mismo resultado que el recorrido escalar de buscarPorCampoNumerico():
+ * - igual: rango [valor - 16 ULPs, valor + 16 ULPs] (ver sonAproximadamenteIguales())
+ * - rango: [minimo, maximo]
+ * - cercano: distanciaMinima() y después seleccionarPorDistancia()
+ */
+mascaraDeSeleccion seleccionarPorConsulta(const float* columna, size_t n, const consultaNumerica& consulta){
+    switch (consulta.modo)
+    {
+    case modoNumerico::igual:
+        return seleccionarEnRango(columna, n, desplazarUlps(consulta.minimo, -ULPS_DE_TOLERANCIA), desplazarUlps(consulta.minimo, ULPS_DE_TOLERANCIA));
+    case modoNumerico::rango:
+        return seleccionarEnRango(columna, n, consulta.minimo, consulta.maximo);
+    case modoNumerico::cercano:
+        break;
+    }
+    return seleccionarPorDistancia(columna, n, consulta.minimo, distanciaMinima(columna, n, consulta.minimo));
+}
+
+/**
+ * @brief Evalúa una subcadena una sola vez por cada valor distinto de un diccionario
+ * 
+ * @param diccionario Diccionario de tipos o de estados
+ * @param texto Subcadena buscada (mismo criterio que buscarPorTipo()/buscarPorEstado())
+ * @return std::vector<uint8_t> aceptados[codigo] == 1 si el valor de ese código contiene 'texto'
+ */
+std::vector<uint8_t> codigosQueCumplen(const diccionarioDeCadenas& diccionario, const std::string& texto){
+    std::vector<uint8_t> aceptados(diccionario.valores.size(), 0);
+    for (size_t codigo = 0; codigo < diccionario.valores.size(); codigo++)
+    {
+        aceptados[codigo] = diccionario.valores[codigo].find(texto) != std::string::npos;
+    }
+    return aceptados;
+}
+
+/**
+ * @brief Marca las filas de una columna de códigos cuyo código está aceptado
+ * 
+ * @param columna Códigos de tipo o de estado de una tablaDeComponentes
+ * @param aceptados Resultado de codigosQueCumplen()
+ * @return mascaraDeSeleccion Máscara de (n + 63) / 64 palabras
+ * 
+ * @details
+ * Cada fila cuesta una consulta a 'aceptados' en lugar de una búsqueda de
+ * subcadena. Si exactamente un código es aceptado (el caso habitual con un
+ * tipo o estado concreto) y hay SSE2, compara 16 códigos por paso con
+ * _mm_cmpeq_epi16.
+ */
+mascaraDeSeleccion seleccionarPorCodigos(const std::vector<uint16_t>& columna, const std::vector<uint8_t>& aceptados){
+    const size_t n = columna.size();
+    mascaraDeSeleccion mascara((n + 63) / 64, 0);
+    if (std::find(aceptados.begin(), aceptados.end(), 1) == aceptados.end()) return mascara;
+    size_t i = 0;
+#if defined(__SSE2__)
+    if (std::count(aceptados.begin(), aceptados.end(), 1) == 1) {
+        const __m128i buscado = _mm_set1_epi16(static_cast<short>(std::find(aceptados.begin(), aceptados.end(), 1) - aceptados.begin()));
+        for (; i + 64 <= n; i += 64)
+        {
+            uint64_t palabra = 0;
+            for (int k = 0; k < 4; k++)
+            {
+                const uint16_t* p = columna.data() + i + 16 * k;
+                __m128i bajos = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), buscado);
+                __m128i altos = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 8)), buscado);
+                palabra |= static_cast<uint64_t>(_mm_movemask_epi8(_mm_packs_epi16(bajos, altos))) << (16 * k);
+            }
+            mascara[i / 64] = palabra;
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        if (aceptados[columna[i]]) mascara[i / 64] |= uint64_t{1} << (i % 64);
+    }
+    return mascara;
+}
+
+/**
+ * @brief Devuelve la columna proyectada de un campo numérico de un archivo binario
+ * 
+ * @param mapa Registro binario abierto
+ * @param campo valorNominal, tolerancia o voltaje
+ * @return const float* Inicio de la columna dentro de la proyección
+ * 
+ * @note Las columnas empiezan tras la cabecera de 64 bytes y miden múltiplos
+ *       de 4, así que quedan alineadas para float
+ */
+const float* columnaMapeada(const registroMapeado& mapa, campoDeBusqueda campo){
+    const cabeceraBinaria& cabecera = mapa.cabeceraDelArchivo();
+    uint64_t inicio = campo == campoDeBusqueda::valorNominal ? cabecera.inicioValorNominal
+                    : (campo == campoDeBusqueda::tolerancia ? cabecera.inicioTolerancia : cabecera.inicioVoltaje);
+    return reinterpret_cast<const float*>(mapa.datos() + inicio);
+}
+
+/**
+ * @brief Muestra el menú de parámetros de búsqueda disponibles
+ * 
+ * @details
+ * Presenta un menú formateado con las diferentes opciones para buscar componentes:
+ * 
+ * ============================
+ * (1) Nombre
+ * (2) Tipo
+ * (3) Valor nominal
+ * (4) Tolerancia  
+ * (5) Voltaje de trabajo
+ * (6) Estado
+ * (7) Varios criterios combinados
+ * (8) Salir
+ * Elija el parámetro de búsqueda a utilizar:
+ * ============================
+ * 
+ * Cada opción corresponde a un campo específico de la estructura 'componente';
+ * la 7 combina varios en una consulta (ver interpretarConsulta()).
+ * 
+ * @post Genera salida estándar con el menú formateado
+ * @post No modifica ningún estado del programa
+ * 
+ * @note
+ * - Diseñado para usarse con buscarPorParametro()
+ * - Las opciones 1-6 corresponden a campos de búsqueda
+ * - La opción 7 la resuelve buscarEnArchivo() con ejecutarConsulta()
+ * - La opción 8 permite salir sin buscar
+ * - Los separadores "===" mejoran la legibilidad
+ * 
+ * @see buscarPorParametro() Para el procesamiento de la selección
+ * @see componente Para la estructura de datos relacionada
+ */
+void menuParametro(){
+    std::cout << "\n============================\n";
+    std::cout<<"(1) Nombre. \n";
+    std::cout<<"(2) Tipo. \n";
+    std::cout<<"(3) Valor nominal. \n";
+    std::cout<<"(4) Tolerancia. \n";
+    std::cout<<"(5) Voltaje de trabajo. \n";
+    std::cout<<"(6) Estado  \n";
+    std::cout<<"(7) Varios criterios combinados  \n";
+    std::cout<<"(8) Salir  \n";
+    std::cout<<"Elija el parámetro de búsqueda a utilizar: \n";
+    std::cout << "\n============================\n";
+}
+
+/**
+ * @enum formatoDeSalida
+ * @brief Formato en que salidaDeResultados escribe cada componente
+ */
+enum class formatoDeSalida
+{
+    humano, ///< Bloque "Componente encontrado:" de mostrarComponente()
+    tsv,    ///< Una fila por componente, separada por tabuladores, con encabezado
+    jsonl   ///< Un objeto JSON por línea
+};
+
+/**
+ * @class salidaDeResultados
+ * @brief Destino de los resultados de búsqueda que los formatea en un búfer y los escribe en bloques
+ * 
+ * @details
+ * Escribir cada campo con su propio std::cout << hace que, con cientos de
+ * miles de coincidencias, la salida cueste más que la búsqueda. Aquí cada
+ * componente se formatea en un búfer reutilizable (los números con
+ * std::to_chars(), sin locale ni flujos) y el búfer se envía a la salida
+ * estándar con una sola llamada a write() cada CAPACIDAD_DEL_BUFER bytes.
+ * 
+ * Aplica además la paginación: las primeras 'desplazamiento' coincidencias se
+ * cuentan pero no se escriben, y a partir de 'limite' escritas emitir()
+ * devuelve false para que el recorrido que la llama se detenga.
+ * 
+ * Los mensajes que no son resultados (planes, errores, totales) deben ir a
+ * avisos(), que en los formatos TSV y JSON es la salida de errores para que
+ * la salida estándar contenga solo datos. redirigir() cambia ambos destinos
+ * por flujos en memoria (así responde el servidor de ejecutarServidor()).
+ * 
+ * @warning std::cout se vacía antes de cada escritura para respetar el orden;
+ *          no escribir resultados por std::cout mientras la salida esté viva
+ * 
+ * @par Ejemplo de uso:
+ * @code
+ * salidaDeResultados salida(formatoDeSalida::jsonl, 100);
+ * for (const auto& c : registros) {
+ *     if (c.estado == "Nuevo" && !salida.emitir(c)) break;
+ * }
+ * @endcode
+ */
+class salidaDeResultados
+{
+public:
+    static const uint64_t SIN_LIMITE = std::numeric_limits<uint64_t>::max(); ///< Valor de 'limite' que no limita
+    static const size_t CAPACIDAD_DEL_BUFER = 64 * 1024; ///< Bytes acumulados antes de escribir
+
+    explicit salidaDeResultados(formatoDeSalida formato = formatoDeSalida::humano, uint64_t limite = SIN_LIMITE, uint64_t desplazamiento = 0)
+        : formato(formato), limite(limite), desplazamiento(desplazamiento) {
+        bufer.reserve(CAPACIDAD_DEL_BUFER + 1024);
+    }
+    salidaDeResultados(const salidaDeResultados&) = delete;
+    salidaDeResultados& operator=(const salidaDeResultados&) = delete;
+    ~salidaDeResultados() {
+        vaciar();
+        contarEstadistica(contadorMedido::registrosCoincidentes, vistas);
+    }
+
+    template<class Registro>
+    bool emitir(const Registro& c);
+    void vaciar();
+    void redirigir(std::ostream& datos, std::ostream& mensajes);
+
+    formatoDeSalida formatoActual() const { return formato; } ///< Formato de los resultados
+    uint64_t coincidencias() const { return vistas; } ///< Coincidencias recibidas, escritas o no
+    uint64_t escritas() const { return emitidas; } ///< Coincidencias escritas
+    bool limiteAlcanzado() const { return emitidas >= limite; } ///< true si ya no se escribirá nada más
+    bool escribiraLaSiguiente() const { return vistas >= desplazamiento && emitidas < limite; } ///< true si la próxima coincidencia se escribirá
+    uint64_t restantes() const; ///< Coincidencias que aún se omitirán o escribirán antes del límite
+    std::ostream& avisos() const { ///< Flujo para mensajes
+        if (flujoDeAvisos) return *flujoDeAvisos;
+        return formato == formatoDeSalida::humano ? std::cout : std::cerr;
+    }
+
+private:
+    void agregarNumero(float valor);
+    void agregarTexto(std::string_view texto);
+
+    formatoDeSalida formato;
+    uint64_t limite;
+    uint64_t desplazamiento;
+    uint64_t vistas{0};
+    uint64_t emitidas{0};
+    std::string bufer;
+    std::ostream* flujoDeDatos{nullptr};  ///< Destino de redirigir(); nullptr para la salida estándar
+    std::ostream* flujoDeAvisos{nullptr}; ///< Destino de redirigir() para avisos()
+};
+
+/**
+ * @brief Agrega un número al búfer con std::to_chars()
+ * 
+ * @details En formato humano usa 6 cifras significativas, como std::cout; en
+ * TSV y JSON, la representación más corta que se lee de vuelta como el mismo
+ * float. En JSON los NaN e infinitos se escriben como null.
+ */
+void salidaDeResultados::agregarNumero(float valor){
+    if (formato == formatoDeSalida::jsonl && !std::isfinite(valor)) {
+        bufer += "null";
+        return;
+    }
+    char numero[32];
+    std::to_chars_result resultado = formato == formatoDeSalida::humano
+        ? std::to_chars(numero, numero + sizeof(numero), valor, std::chars_format::general, 6)
+        : std::to_chars(numero, numero + sizeof(numero), valor);
+    bufer.append(numero, resultado.ptr);
+}
+
+/**
+ * @brief Agrega una cadena al búfer, escapada según el formato
+ * 
+ * @details TSV: tabulador, salto de línea y barra invertida como \\t, \\n y
+ * \\\\. JSON: comillas, barra invertida y caracteres de control según RFC 8259.
+ */
+void salidaDeResultados::agregarTexto(std::string_view texto){
+    if (formato == formatoDeSalida::humano) {
+        bufer.append(texto);
+        return;
+    }
+    for (char caracter : texto) {
+        switch (caracter)
+        {
+        case '\t': bufer += "\\t"; break;
+        case '\n': bufer += "\\n"; break;
+        case '\r': bufer += "\\r"; break;
+        case '\\': bufer += "\\\\"; break;
+        case '"':
+            if (formato == formatoDeSalida::jsonl) bufer += "\\\"";
+            else bufer += caracter;
+            break;
+        default:
+            if (formato == formatoDeSalida::jsonl && static_cast<unsigned char>(caracter) < 0x20) {
+                const char hexadecimal[] = "0123456789abcdef";
+                bufer += "\\u00";
+                bufer += hexadecimal[caracter >> 4];
+                bufer += hexadecimal[caracter & 0xF];
+            } else {
+                bufer += caracter;
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Registra una coincidencia y la escribe si está dentro de la página pedida
+ * 
+ * @param c Componente (componente o vistaComponente)
+ * @return false si ya se alcanzó el límite y el recorrido puede detenerse
+ */
+template<class Registro>
+bool salidaDeResultados::emitir(const Registro& c){
+    vistas++;
+    if (vistas <= desplazamiento) return true;
+    if (emitidas >= limite) return false;
+
+    cronometroDeEtapa cronometro(etapaMedida::presentacion);
+    switch (formato)
+    {
+    case formatoDeSalida::humano:
+        bufer += "\nComponente encontrado:\nNombre: ";
+        agregarTexto(c.nombreDelComponente);
+        bufer += "\nTipo: ";
+        agregarTexto(c.tipoDeComponente);
+        bufer += "\nValor nominal: ";
+        agregarNumero(c.valorNominal);
+        bufer += "\nTolerancia: ";
+        agregarNumero(c.tolerancia);
+        bufer += "%\nVoltaje: ";
+        agregarNumero(c.voltajeDeTrabajo);
+        bufer += "V\nEstado: ";
+        agregarTexto(c.estado);
+        bufer += "\n-----\n";
+        break;
+    case formatoDeSalida::tsv:
+        if (emitidas == 0) bufer += "nombre\ttipo\tvalorNominal\ttolerancia\tvoltaje\testado\n";
+        agregarTexto(c.nombreDelComponente);
+        bufer += '\t';
+        agregarTexto(c.tipoDeComponente);
+        bufer += '\t';
+        agregarNumero(c.valorNominal);
+        bufer += '\t';
+        agregarNumero(c.tolerancia);
+        bufer += '\t';
+        agregarNumero(c.voltajeDeTrabajo);
+        bufer += '\t';
+        agregarTexto(c.estado);
+        bufer += '\n';
+        break;
+    case formatoDeSalida::jsonl:
+        bufer += "{\"nombre\":\"";
+        agregarTexto(c.nombreDelComponente);
+        bufer += "\",\"tipo\":\"";
+        agregarTexto(c.tipoDeComponente);
+        bufer += "\",\"valorNominal\":";
+        agregarNumero(c.valorNominal);
+        bufer += ",\"tolerancia\":";
+        agregarNumero(c.tolerancia);
+        bufer += ",\"voltaje\":";
+        agregarNumero(c.voltajeDeTrabajo);
+        bufer += ",\"estado\":\"";
+        agregarTexto(c.estado);
+        bufer += "\"}\n";
+        break;
+    }
+    emitidas++;
+    if (bufer.size() >= CAPACIDAD_DEL_BUFER) vaciar();
+    return emitidas < limite;
+}
+
+/**
+ * @brief Escribe el contenido del búfer en la salida estándar y lo vacía
+ * 
+ * @post El búfer conserva su capacidad para las siguientes coincidencias
+ */
+void salidaDeResultados::vaciar(){
+    if (bufer.empty()) return;
+    cronometroDeEtapa cronometro(etapaMedida::presentacion);
+    if (flujoDeDatos) {
+        flujoDeDatos->write(bufer.data(), static_cast<std::streamsize>(bufer.size()));
+        bufer.clear();
+        return;
+    }
+    std::cout.flush();
+#if defined(SISTEMA_POSIX)
+    escribirCompleto(STDOUT_FILENO, bufer);
+#else
+    std::cout.write(bufer.data(), static_cast<std::streamsize>(bufer.size()));
+    std::cout.flush();
+#endif
+    bufer.clear();
+}
+
+/**
+ * @brief Cuántas coincidencias más puede recibir emitir() antes de devolver false
+ * 
+ * @return uint64_t Las que faltan por omitir más las que faltan por escribir
+ *         (SIN_LIMITE si no hay límite)
+ * 
+ * @details Permite a quien reúne coincidencias por adelantado (por ejemplo,
+ * en paralelo) no guardar más de las que se van a usar.
+ */
+uint64_t salidaDeResultados::restantes() const{
+    if (emitidas >= limite) return 0;
+    if (limite == SIN_LIMITE) return SIN_LIMITE;
+    const uint64_t porOmitir = vistas < desplazamiento ? desplazamiento - vistas : 0;
+    return porOmitir > SIN_LIMITE - (limite - emitidas) ? SIN_LIMITE : porOmitir + (limite - emitidas);
+}
+
+/**
+ * @brief Envía los resultados y los avisos a flujos propios en lugar de a la consola
+ * 
+ * @param datos Recibe los resultados formateados
+ * @param mensajes Se devuelve desde avisos(); puede ser el mismo flujo que
+ *                 'datos' para conservar el orden, como en formato humano
+ */
+void salidaDeResultados::redirigir(std::ostream& datos, std::ostream& mensajes){
+    vaciar();
+    flujoDeDatos = &datos;
+    flujoDeAvisos = &mensajes;
+}
+
+/**
+ * @brief Muestra los detalles de un componente electrónico en formato legible
+ * 
+ * @param c Componente a mostrar: componente o vistaComponente (referencia constante)
+ * 
+ * @details
+ * Esta función despliega todos los campos de un componente en un formato consistente:
+ * 
+ * --------------------------
+ * Componente encontrado:
+ * Nombre: [nombreDelComponente]
+ * Tipo: [tipoDeComponente]  
+ * Valor nominal: [valorNominal]
+ * Tolerancia: [tolerancia]%
+ * Voltaje: [voltajeDeTrabajo]V
+ * Estado: [estado]
+ * -----
+ * --------------------------
+ * 
+ * @post Genera salida estándar con el formato especificado
+ * @post No modifica el componente recibido
+ * 
+ * @note
+ * - Formato diseñado para máxima legibilidad
+ * - Incluye unidades donde es relevante (% y V)
+ * - Separador "-----" al final para delimitar visualmente
+ * - Campos alineados verticalmente para fácil escaneo
+ * - Se escribe con una sola llamada; para muchas coincidencias seguidas,
+ *   salidaDeResultados agrupa además varios componentes por escritura
+ * 
+ * @par Ejemplo de salida:
+ * @code
+ * Componente encontrado:
+ * Nombre: Resistor 1kΩ
+ * Tipo: Resistor de carbón
+ * Valor nominal: 1000
+ * Tolerancia: 5%
+ * Voltaje: 12.5V  
+ * Estado: Nuevo
+ * -----
+ * @endcode
+ * 
+ * @see componente Para la estructura de datos mostrada
+ * @see buscarPorNombre() Como una de las funciones que usa esta visualización
+ */
+template<class Registro>
+void mostrarComponente(const Registro& c) {
+    salidaDeResultados salida;
+    salida.emitir(c);
+}
+
+/**
+ * @brief Bytes máximos del texto de una búsqueda aproximada (una palabra de 64 bits)
+ */
+const size_t LARGO_MAXIMO_APROXIMADO = 64;
+
+/**
+ * @brief Número de resultados de una búsqueda aproximada cuando no se indica --limite
+ */
+const size_t CANTIDAD_DE_PARECIDOS = 10;
+
+/**
+ * @brief Distancia de edición admitida por defecto para un texto de 'largo' bytes
+ * 
+ * @details Una edición por cada cuatro bytes, con un mínimo de una: "Resitor 1k"
+ * (10 bytes) admite 2 y "Capacitor 100nF 50V" (19 bytes) admite 4.
+ */
+unsigned distanciaAproximadaPorDefecto(size_t largo){
+    return static_cast<unsigned>(std::max<size_t>(1, largo / 4));
+}
+
+/**
+ * @struct nombreParecido
+ * @brief Resultado de una búsqueda aproximada: el componente y su distancia
+ * 
+ * @tparam Registro componente o vistaComponente (válida mientras viva su colección)
+ */
+template<class Registro>
+struct nombreParecido
+{
+    unsigned distancia; ///< Ediciones del texto buscado al fragmento más parecido del nombre
+    uint64_t orden;     ///< Posición en que se encontró, para desempatar de forma estable
+    Registro registro;
+};
+
+/**
+ * @class seleccionDeParecidos
+ * @brief Conserva los 'cantidad' componentes cuyo nombre más se parece a un texto
+ * 
+ * @tparam Registro componente o vistaComponente
+ * 
+ * @details
+ * La distancia es la de Levenshtein (inserciones, borrados y sustituciones de
+ * bytes, sin distinguir mayúsculas ASCII) entre el texto y el fragmento del
+ * nombre que mejor le corresponde, como la búsqueda por subcadena de
+ * buscarPorNombre(): "Resitor 1k" está a distancia 1 de "Resistor 1kΩ #000123".
+ * 
+ * Se calcula con el algoritmo de vectores de bits de Myers (1999): la columna
+ * de la matriz de programación dinámica cabe en dos palabras de 64 bits
+ * (diferencias verticales +1 y -1) y cada byte del nombre la actualiza con
+ * unas pocas operaciones, de modo que comparar un nombre cuesta O(largo del
+ * nombre) sin importar el largo del texto (hasta LARGO_MAXIMO_APROXIMADO).
+ * 
+ * Dos podas evitan la mayor parte del trabajo:
+ * - Por largo: un nombre de n bytes está al menos a m - n de un texto de m
+ *   bytes, así que los nombres demasiado cortos no se recorren
+ * - Por cota: el puntaje solo baja un punto por byte, así que el recorrido de
+ *   un nombre se abandona cuando ni los bytes que faltan pueden llevarlo por
+ *   debajo del mejor puntaje ya visto. Con la selección llena, el umbral es
+ *   la distancia del peor de los elegidos, y baja a medida que aparecen
+ *   nombres más parecidos
+ * 
+ * Los elegidos se guardan en un montículo cuya raíz es el peor (mayor
+ * distancia y, a igualdad, encontrado más tarde); resultados() los devuelve
+ * ordenados de menor a mayor distancia y, a igualdad, por orden de aparición.
+ * 
+ * @par Ejemplo de uso:
+ * @code
+ * seleccionDeParecidos<vistaComponente> seleccion("Resitor 1k", 2, 5);
+ * for (const auto& c : mapa) seleccion.considerar(c);
+ * for (const auto& p : seleccion.resultados()) std::cout << p.distancia << " " << p.registro.nombreDelComponente << "\n";
+ * @endcode
+ * 
+ * @see buscarNombresParecidos()
+ */
+template<class Registro>
+class seleccionDeParecidos
+{
+public:
+    seleccionDeParecidos(std::string_view texto, unsigned distanciaMaxima, size_t cantidad)
+        : largo(texto.size()), distanciaMaxima(distanciaMaxima), cantidad(cantidad) {
+        if (largo == 0 || largo > LARGO_MAXIMO_APROXIMADO) return;
+        for (size_t i = 0; i < largo; ++i)
+        {
+            const unsigned char caracter = static_cast<unsigned char>(texto[i]);
+            igualdades[caracter] |= 1ull << i;
+            igualdades[std::tolower(caracter)] |= 1ull << i;
+            igualdades[std::toupper(caracter)] |= 1ull << i;
+        }
+    }
+
+    bool valido() const { return largo > 0 && largo <= LARGO_MAXIMO_APROXIMADO; } ///< false si el texto está vacío o es muy largo
+
+    /**
+     * @brief Calcula la distancia del nombre de 'c' y lo conserva si está entre los mejores
+     */
+    void considerar(const Registro& c) {
+        const uint64_t posicion = orden++;
+        if (cantidad == 0) return;
+        const bool lleno = elegidos.size() == cantidad;
+        if (lleno && elegidos.front().distancia == 0) return;
+        const unsigned umbral = lleno ? elegidos.front().distancia - 1 : distanciaMaxima;
+        const unsigned distancia = distanciaAlNombre(c.nombreDelComponente, umbral);
+        if (distancia > umbral) return;
+        if (lleno) {
+            std::pop_heap(elegidos.begin(), elegidos.end(), peor);
+            elegidos.pop_back();
+        }
+        elegidos.push_back({distancia, posicion, c});
+        std::push_heap(elegidos.begin(), elegidos.end(), peor);
+    }
+
+    /**
+     * @brief Devuelve los elegidos de menor a mayor distancia y vacía la selección
+     */
+    std::vector<nombreParecido<Registro>> resultados() {
+        std::sort_heap(elegidos.begin(), elegidos.end(), peor);
+        return std::move(elegidos);
+    }
+
+private:
+    /**
+     * @brief Distancia mínima del texto a un fragmento de 'nombre', o umbral + 1 si supera 'umbral'
+     */
+    unsigned distanciaAlNombre(std::string_view nombre, unsigned umbral) const {
+        if (nombre.size() + umbral < largo) return umbral + 1; // Poda por largo
+        const uint64_t ultimo = 1ull << (largo - 1);
+        uint64_t positivos = largo == 64 ? ~0ull : (1ull << largo) - 1; // Diferencias verticales +1
+        uint64_t negativos = 0;                                         // Diferencias verticales -1
+        unsigned puntaje = static_cast<unsigned>(largo);
+        unsigned mejor = std::min(puntaje, umbral + 1);
+        for (size_t j = 0; j < nombre.size(); ++j)
+        {
+            const uint64_t iguales = igualdades[static_cast<unsigned char>(nombre[j])];
+            const uint64_t xv = iguales | negativos;
+            const uint64_t xh = (((iguales & positivos) + positivos) ^ positivos) | iguales;
+            uint64_t horizontalesPositivas = negativos | ~(xh | positivos);
+            uint64_t horizontalesNegativas = positivos & xh;
+            if (horizontalesPositivas & ultimo) puntaje++;
+            else if (horizontalesNegativas & ultimo) puntaje--;
+            // Sin el "| 1" de la distancia global: el fragmento puede empezar en cualquier byte del nombre
+            horizontalesPositivas <<= 1;
+            horizontalesNegativas <<= 1;
+            positivos = horizontalesNegativas | ~(xv | horizontalesPositivas);
+            negativos = horizontalesPositivas & xv;
+            mejor = std::min(mejor, puntaje);
+            const size_t faltan = nombre.size() - j - 1;
+            if (mejor == 0 || puntaje >= mejor + faltan) break; // Poda por cota
+        }
+        return mejor;
+    }
+
+    static bool peor(const nombreParecido<Registro>& a, const nombreParecido<Registro>& b) {
+        return a.distancia != b.distancia ? a.distancia < b.distancia : a.orden < b.orden;
+    }
+
+    uint64_t igualdades[256]{}; ///< Bit i encendido si el byte coincide con el byte i del texto
+    size_t largo;
+    unsigned distanciaMaxima;
+    size_t cantidad;
+    uint64_t orden{0};
+    std::vector<nombreParecido<Registro>> elegidos; ///< Montículo con el peor elegido en la raíz
+};
+
+/**
+ * @brief Recorre una colección y devuelve los componentes de nombre más parecido a un texto
+ * 
+ * @param registros Colección recorrible (std::vector<componente>, registroEnArena, registroMapeado)
+ * @param seleccion Selección donde se acumulan los elegidos (puede venir de otra colección)
+ * 
+ * @see seleccionDeParecidos
+ */
+template<class Coleccion, class Registro>
+void buscarNombresParecidos(const Coleccion& registros, seleccionDeParecidos<Registro>& seleccion){
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    uint64_t recorridos = 0;
+    for (const auto& c : registros) {
+        recorridos++;
+        seleccion.considerar(c);
+    }
+    contarEstadistica(contadorMedido::registrosRecorridos, recorridos);
+}
+
+/**
+ * @brief Muestra los resultados de una búsqueda aproximada en orden de distancia
+ * 
+ * @param parecidos Resultados de seleccionDeParecidos::resultados()
+ * @param salida Destino; en formato humano cada componente escrito va precedido por su distancia
+ */
+template<class Registro>
+void mostrarNombresParecidos(const std::vector<nombreParecido<Registro>>& parecidos, salidaDeResultados& salida){
+    for (const auto& parecido : parecidos)
+    {
+        if (salida.formatoActual() == formatoDeSalida::humano && salida.escribiraLaSiguiente()) {
+            salida.vaciar();
+            salida.avisos() << "\nDistancia " << parecido.distancia << ":";
+        }
+        if (!salida.emitir(parecido.registro)) break;
+    }
+    salida.vaciar();
+}
+
+/**
+ * @brief Ofrece los nombres más parecidos cuando una búsqueda por nombre no encontró nada
+ * 
+ * @param registros Colección donde se buscó
+ * @param texto Texto buscado
+ * 
+ * @details Usa la distancia distanciaAproximadaPorDefecto() y muestra como
+ * máximo CANTIDAD_DE_PARECIDOS componentes.
+ */
+template<class Coleccion>
+void sugerirNombresParecidos(const Coleccion& registros, const std::string& texto){
+    using Registro = std::decay_t<decltype(*std::begin(registros))>;
+    seleccionDeParecidos<Registro> seleccion(texto, distanciaAproximadaPorDefecto(texto.size()), CANTIDAD_DE_PARECIDOS);
+    if (!seleccion.valido()) return;
+    buscarNombresParecidos(registros, seleccion);
+    const auto parecidos = seleccion.resultados();
+    if (parecidos.empty()) return;
+    std::cout << "Los nombres más parecidos son:\n";
+    salidaDeResultados salida;
+    mostrarNombresParecidos(parecidos, salida);
+}
+
+/**
+ * @brief Busca componentes por coincidencia parcial de nombre
+ * 
+ * @param registros Componentes donde buscar: std::vector<componente> o registroMapeado
+ * 
+ * @details
+ * Esta función implementa una búsqueda case-sensitive de subcadenas en los nombres:
+ * 1. Solicita al usuario el texto a buscar mediante solicitarTexto()
+ * 2. Recorre todos los componentes comparando nombres
+ * 3. Muestra cada coincidencia usando mostrarComponente()
+ * 4. Informa cuando no encuentra resultados y muestra los nombres más
+ *    parecidos con sugerirNombresParecidos() (ej: "Resitor 1k")
+ * 
+ * La comparación es por coincidencia parcial (subcadena):
+ * - "res" encontrará "Resistor 10kΩ" y "RESISTOR 1MΩ"
+ * - Búsqueda exacta requiere ingresar el nombre completo
+ * 
+ * @post Muestra por pantalla todos los componentes coincidentes
+ * @post No modifica el vector de registros
+ * 
+ * @throw Ninguno (errores manejados internamente)
+ * 
+ * @par Ejemplo de uso:
+ * @code
+ * vector<componente> inventario = {...};
+ * buscarPorNombre(inventario);
+ * // Usuario ingresa: "10k"
+ * // Muestra todos los componentes con "10k" en su nombre
+ * @endcode
+ * 
+ * @note
+ * - Sensible a mayúsculas/minúsculas (case-sensitive)
+ * - Muestra múltiples coincidencias si existen
+ * - Usa string::find() para búsqueda parcial
+ * 
+ * @see solicitarTexto() Para la entrada del usuario
+ * @see mostrarComponente() Para el formato de visualización
+ */
+template<class Coleccion>
+void buscarPorNombre(const Coleccion& registros){
+    std::string nombreComponente=solicitarTexto("Ingrese el nombre del componente que desea encontrar \n");
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    bool encontrado{false};
+    salidaDeResultados salida;
+    for (const auto& c : registros)
+    {
+        if (c.nombreDelComponente.find(nombreComponente)!=std::string::npos)
+        {
+            salida.emitir(c);
+            encontrado = true;
+        }
+    }
+    if (encontrado==false)
+    {
+        std::cout << "No se encontró ningún componente con ese nombre.\n";
+        sugerirNombresParecidos(registros, nombreComponente);
+    }
+}
+
+/**
+ * @brief Busca componentes por coincidencia parcial en el tipo
+ * 
+ * @param registros Componentes donde buscar: std::vector<componente> o registroMapeado
+ * 
+ * @details
+ * Implementa búsqueda de subcadena case-sensitive en el campo tipoDeComponente:
+ * 
+ * 1. Solicita el tipo a buscar usando solicitarTexto()
+ * 2. Recorre todos los componentes comparando tipos
+ * 3. Muestra coincidencias con mostrarComponente()
+ * 4. Informa si no hay resultados
+ * 
+ * La comparación es por subcadena:
+ * - "cap" encontrará "Capacitor" y "CAPACITOR"
+ * - Coincidencia en cualquier posición del texto
+ * 
+ * @post Muestra componentes con tipos coincidentes
+ * @post No modifica el vector original
+ * 
+ * @throw Ninguno (errores manejados internamente)
+ * 
+ * @par Ejemplo:
+ * @code
+ * vector<componente> inventario = {...};
+ * buscarPorTipo(inventario);
+ * // Usuario ingresa: "resis"
+ * // Muestra resistores con cualquier valor
+ * @endcode
+ * 
+ * @note 
+ * - Sensible a mayúsculas/minúsculas
+ * - Muestra múltiples coincidencias
+ * - Usa string::find() para búsqueda parcial
+ * 
+ * @see solicitarTexto() Para entrada validada
+ * @see mostrarComponente() Para formato de visualización
+ */
+template<class Coleccion>
+void buscarPorTipo(const Coleccion& registros){
+    std::string tipo=solicitarTexto("Ingrese el tipo del componente que desea encontrar \n");
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    bool encontrado{false};
+    salidaDeResultados salida;
+    for (const auto& c : registros)
+    {
+        if (c.tipoDeComponente.find(tipo)!=std::string::npos)
+        {
+            salida.emitir(c);
+            encontrado = true;
+        }
+    }
+    if (encontrado==false)
+    {
+        std::cout << "No se encontró ningún componente de ese tipo.\n";
+    }
+}
+
+/**
+ * @brief Busca componentes por tipo en una tabla columnar
+ * 
+ * @param registros Tabla donde buscar
+ * 
+ * @details
+ * Mismo resultado que la versión genérica, pero la subcadena se compara una
+ * vez por tipo distinto (codigosQueCumplen()) y las filas se filtran por
+ * código con seleccionarPorCodigos().
+ */
+void buscarPorTipo(const tablaDeComponentes& registros){
+    std::string tipo=solicitarTexto("Ingrese el tipo del componente que desea encontrar \n");
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    mascaraDeSeleccion mascara = seleccionarPorCodigos(registros.tipos, codigosQueCumplen(registros.diccionarioDeTipos, tipo));
+    salidaDeResultados salida;
+    if (recorrerSeleccion(mascara, [&registros, &salida](size_t fila) { return salida.emitir(registros.fila(fila)); }) == 0)
+    {
+        std::cout << "No se encontró ningún componente de ese tipo.\n";
+    }
+}
+
+/**
+ * @brief Busca componentes por un campo numérico con valor exacto, rango o valor más cercano
+ * 
+ * @param registros Componentes donde buscar: std::vector<componente>,
+ *                  tablaDeComponentes o registroMapeado
+ * @param campo valorNominal, tolerancia o voltaje
+ * @param descripcion Nombre del campo para los mensajes (ej: "el voltaje")
+ * @param mensajeNoEncontrado Mensaje cuando no hay resultados
+ * @param indices Índices del vector (nullptr para recorrido lineal)
+ * 
+ * @details
+ * Solicita la consulta con solicitarConsultaNumerica(). Si 'registros' es un
+ * vector o un registroEnArena y se proporcionan índices, la resuelve con consultarIndiceNumerico()
+ * en O(log n). Las tablas columnares y los archivos binarios proyectados se
+ * filtran columna a columna con seleccionarPorConsulta() (SSE2/AVX2). En otro
+ * caso recorre la colección (dos pasadas para el valor más cercano). Todos
+ * los caminos devuelven los mismos componentes, en el orden del archivo.
+ * 
+ * @see buscarPorValorNominal()
+ * @see buscarPorTolerancia()
+ * @see buscarPorVoltaje()
+ */
+template<class Coleccion>
+void buscarPorCampoNumerico(const Coleccion& registros, campoDeBusqueda campo, const std::string& descripcion, const char* mensajeNoEncontrado, indicesNumericos* indices){
+    consultaNumerica consulta = solicitarConsultaNumerica(descripcion);
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    bool encontrado{false};
+    salidaDeResultados salida;
+
+    if constexpr (std::is_same_v<Coleccion, std::vector<componente>> || std::is_same_v<Coleccion, registroEnArena>) {
+        const indiceNumerico* indice = indices != nullptr ? indiceDeCampo(*indices, registros, campo) : nullptr;
+        if (indice != nullptr) {
+            for (uint32_t posicion : consultarIndiceNumerico(*indice, consulta))
+            {
+                salida.emitir(registros[posicion]);
+                encontrado = true;
+            }
+            if (encontrado==false) std::cout << mensajeNoEncontrado;
+            return;
+        }
+    }
+
+    if constexpr (std::is_same_v<Coleccion, tablaDeComponentes>) {
+        const std::vector<float>& columna = registros.columna(campo);
+        mascaraDeSeleccion mascara = seleccionarPorConsulta(columna.data(), columna.size(), consulta);
+        if (recorrerSeleccion(mascara, [&registros, &salida](size_t fila) { return salida.emitir(registros.fila(fila)); }) == 0) {
+            std::cout << mensajeNoEncontrado;
+        }
+        return;
+    }
+    if constexpr (std::is_same_v<Coleccion, registroMapeado>) {
+        if (registros.esBinario()) {
+            uint64_t cantidad = registros.cabeceraDelArchivo().cantidad;
+            mascaraDeSeleccion mascara = seleccionarPorConsulta(columnaMapeada(registros, campo), cantidad, consulta);
+            if (recorrerSeleccion(mascara, [&registros, &salida](size_t fila) { return salida.emitir(registros.fila(fila)); }) == 0) {
+                std::cout << mensajeNoEncontrado;
+            }
+            return;
+        }
+    }
+
+    float mejorDistancia = std::numeric_limits<float>::infinity();
+    if (consulta.modo == modoNumerico::cercano) {
+        for (const auto& c : registros)
+        {
+            float distancia = std::abs(valorDeCampo(c, campo) - consulta.minimo);
+            if (distancia < mejorDistancia) mejorDistancia = distancia;
+        }
+    }
+    for (const auto& c : registros)
+    {
+        float valor = valorDeCampo(c, campo);
+        bool coincide = false;
+        switch (consulta.modo)
+        {
+        case modoNumerico::igual:
+            coincide = sonAproximadamenteIguales(valor, consulta.minimo);
+            break;
+        case modoNumerico::rango:
+            coincide = valor >= consulta.minimo && valor <= consulta.maximo;
+            break;
+        case modoNumerico::cercano:
+            coincide = std::abs(valor - consulta.minimo) == mejorDistancia;
+            break;
+        }
+        if (coincide)
+        {
+            salida.emitir(c);
+            encontrado = true;
+        }
+    }
+    if (encontrado==false) std::cout << mensajeNoEncontrado;
+}
+
+/**
+ * @brief Busca componentes por valor nominal exacto, por rango o por valor más cercano
+ * 
+ * @param registros Componentes donde buscar: std::vector<componente> o registroMapeado
+ * @param indices Índices numéricos del vector (opcional; nullptr recorre la colección)
+ * 
+ * @details
+ * Realiza una búsqueda por valor numérico en el campo valorNominal:
+ * 
+ * 1. Solicita el tipo de consulta y los valores con solicitarConsultaNumerica()
+ * 2. Compara con igualdad tolerante a redondeo, por rango o por cercanía
+ * 3. Muestra coincidencias con mostrarComponente()
+ * 4. Informa si no hay resultados
+ * 
+ * @post Muestra componentes que cumplen la consulta, en el orden del archivo
+ * @post No modifica el vector original
+ * 
+ * @par Ejemplo:
+ * @code
+ * vector<componente> inventario = {...};
+ * indicesNumericos indices;
+ * buscarPorValorNominal(inventario, &indices);
+ * // Usuario elige (2) Rango e ingresa: 100 y 1000
+ * // Muestra componentes con valor entre 100 y 1000
+ * @endcode
+ * 
+ * @note 
+ * - La igualdad tolera ULPS_DE_TOLERANCIA ULPs, de modo que 0.1 guardado en
+ *   texto y vuelto a leer sigue coincidiendo
+ * - Con índices, la consulta cuesta O(log n) más el número de resultados
+ * 
+ * @see buscarPorCampoNumerico() Para la implementación común
+ * @see solicitarNumero() Para entrada validada
+ * @see mostrarComponente() Para formato de visualización
+ */
+template<class Coleccion>
+void buscarPorValorNominal(const Coleccion& registros, indicesNumericos* indices = nullptr){
+    buscarPorCampoNumerico(registros, campoDeBusqueda::valorNominal, "el valor nominal",
+                           "No se encontró ningún componente con ese valor nominal.\n", indices);
+}
+
+/**
+ * @brief Busca componentes por tolerancia exacta, por rango o por valor más cercano
+ * 
+ * @param registros Componentes donde buscar: std::vector<componente> o registroMapeado
+ * @param indices Índices numéricos del vector (opcional; nullptr recorre la colección)
+ * 
+ * @details
+ * Realiza una búsqueda por el porcentaje de tolerancia:
+ * 
+ * 1. Solicita el tipo de consulta y los valores con solicitarConsultaNumerica()
+ * 2. Compara con igualdad tolerante a redondeo, por rango o por cercanía
+ * 3. Muestra coincidencias usando mostrarComponente()
+ * 4. Informa si no encuentra resultados
+ * 
+ * @post Muestra componentes que cumplen la consulta, en el orden del archivo
+ * @post No modifica el vector original
+ * 
+ * @warning
+ * - La tolerancia debe ingresarse como porcentaje (ej: 5 para 5%)
+ * 
+ * @par Ejemplo de uso:
+ * @code
+ * vector<componente> inventario = {...};
+ * buscarPorTolerancia(inventario);
+ * // Usuario ingresa: 5
+ * // Muestra componentes con ±5% de tolerancia
+ * @endcode
+ * 
+ * @note
+ * - Para resistores, valores comunes son: 1%, 5%, 10%
+ * - Para capacitores, típicamente 10%, 20%
+ * - El rango 0-5 encuentra todas las piezas de precisión
+ * 
+ * @see solicitarNumero() Para entrada validada
+ * @see mostrarComponente() Para formato de visualización
+ * @see buscarPorParametro() Para búsqueda parametrizada
+ */
+template<class Coleccion>
+void buscarPorTolerancia(const Coleccion& registros, indicesNumericos* indices = nullptr){
+    buscarPorCampoNumerico(registros, campoDeBusqueda::tolerancia, "la tolerancia",
+                           "No se encontró ningún componente con esa tolerancia.\n", indices);
+}
+
+/**
+ * @brief Busca componentes por voltaje de trabajo exacto, por rango o por valor más cercano
+ * 
+ * @param registros Componentes donde buscar: std::vector<componente> o registroMapeado
+ * @param indices Índices numéricos del vector (opcional; nullptr recorre la colección)
+ * 
+ * @details
+ * Realiza una búsqueda por el voltaje de trabajo especificado:
+ * 
+ * 1. Solicita el tipo de consulta y los valores con solicitarConsultaNumerica()
+ * 2. Compara con igualdad tolerante a redondeo, por rango o por cercanía
+ * 3. Muestra coincidencias con mostrarComponente()
+ * 4. Informa si no hay resultados
+ * 
+ * @post Muestra componentes que cumplen la consulta, en el orden del archivo
+ * @post No modifica el vector original
+ * 
+ * @warning
+ * - El voltaje debe ingresarse en voltios (ej: 12.5)
+ * 
+ * @par Ejemplo de uso:
+ * @code
+ * vector<componente> inventario = {...};
+ * buscarPorVoltaje(inventario);
+ * // Usuario elige (2) Rango e ingresa: 12 y 50
+ * // Muestra componentes para voltajes entre 12V y 50V
+ * @endcode
+ * 
+ * @note
+ * - Valores típicos: 3.3V, 5V, 12V, 24V, etc.
+ * - Para capacitores: voltaje máximo soportado
+ * - Para reguladores: voltaje de salida
+ * 
+ * @see solicitarNumero() Para entrada validada
+ * @see mostrarComponente() Para formato de visualización
+ */
+template<class Coleccion>
+void buscarPorVoltaje(const Coleccion& registros, indicesNumericos* indices = nullptr){
+    buscarPorCampoNumerico(registros, campoDeBusqueda::voltaje, "el voltaje",
+                           "No se encontró ningún componente con ese voltaje.\n", indices);
+}
+
+/**
+ * @brief Busca componentes por coincidencia parcial en el estado
+ * 
+ * @param registros Componentes donde buscar: std::vector<componente> o registroMapeado
+ * 
+ * @details
+ * Realiza una búsqueda de subcadena case-sensitive en el campo estado:
+ * 
+ * 1. Solicita el texto a buscar usando solicitarTexto()
+ * 2. Compara con el campo estado de cada componente
+ * 3. Muestra coincidencias con mostrarComponente()
+ * 4. Informa si no hay resultados
+ * 
+ * La comparación es por subcadena:
+ * - "nue" encontrará "Nuevo" y "nuevo"
+ * - Coincidencia en cualquier posición del texto
+ * 
+ * @post Muestra componentes con estados coincidentes
+ * @post No modifica el vector original
+ * 
+ * @warning
+ * - Sensible a mayúsculas/minúsculas
+ * - No realiza búsqueda fonética o aproximada
+ * 
+ * @par Ejemplo de uso:
+ * @code
+ * vector<componente> inventario = {...};
+ * buscarPorEstado(inventario);
+ * // Usuario ingresa: "usad"
+ * // Muestra componentes marcados como "Usado" o "usado"
+ * @endcode
+ * 
+ * @note
+ * - Estados comunes: "Nuevo", "Usado", "Dañado", "Reparado"
+ * - Considerar normalizar los estados (siempre misma capitalización)
+ * - Para búsqueda exacta, ingresar el estado completo
+ * 
+ * @see solicitarTexto() Para entrada validada
+ * @see mostrarComponente() Para formato de visualización
+ * @see buscarPorParametro() Para búsqueda parametrizada
+ */
+template<class Coleccion>
+void buscarPorEstado(const Coleccion& registros){
+    std::string estado=solicitarTexto("Ingrese el estado del componente que desea encontrar \n");
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    bool encontrado{false};
+    salidaDeResultados salida;
+    for (const auto& c : registros)
+    {
+        if (c.estado.find(estado)!=std::string::npos)
+        {
+            salida.emitir(c);
+            encontrado = true;
+        }
+    }
+    if (encontrado==false)
+    {
+        std::cout << "No se encontró ningún componente en ese estado.\n";
+    }
+}
+
+/**
+ * @brief Busca componentes por estado en una tabla columnar
+ * 
+ * @param registros Tabla donde buscar
+ * 
+ * @see buscarPorTipo(const tablaDeComponentes&)
+ */
+void buscarPorEstado(const tablaDeComponentes& registros){
+    std::string estado=solicitarTexto("Ingrese el estado del componente que desea encontrar \n");
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    mascaraDeSeleccion mascara = seleccionarPorCodigos(registros.estados, codigosQueCumplen(registros.diccionarioDeEstados, estado));
+    salidaDeResultados salida;
+    if (recorrerSeleccion(mascara, [&registros, &salida](size_t fila) { return salida.emitir(registros.fila(fila)); }) == 0)
+    {
+        std::cout << "No se encontró ningún componente en ese estado.\n";
+    }
+}
+
+/**
+ * @brief Función de despacho para búsquedas de componentes por diferentes parámetros
+ * 
+ * @param opcion Entero que especifica el tipo de búsqueda a realizar (1-7)
+ * @param registros Componentes donde buscar: std::vector<componente> o registroMapeado
+ * @param indices Índices numéricos del vector para las opciones 3-5 (opcional)
+ * 
+ * @details
+ * Esta función actúa como un router que dirige a las funciones específicas de búsqueda
+ * según la opción seleccionada en el menú de parámetros:
+ * 
+ * 1. Búsqueda por nombre (buscarPorNombre)
+ * 2. Búsqueda por tipo (buscarPorTipo)
+ * 3. Búsqueda por valor nominal (buscarPorValorNominal)
+ * 4. Búsqueda por tolerancia (buscarPorTolerancia)
+ * 5. Búsqueda por voltaje (buscarPorVoltaje)
+ * 6. Búsqueda por estado (buscarPorEstado)
+ * 8. Salir al menú principal
+ * 
+ * @post Ejecuta la función de búsqueda correspondiente
+ * @post Maneja opciones inválidas mostrando mensaje
+ * @post No modifica el vector de componentes
+ * 
+ * @throw Ninguno (los errores se manejan internamente)
+ * 
+ * @par Ejemplo de uso:
+ * @code
+ * vector<componente> inventario = {...};
+ * int opcion = 3; // Buscar por valor nominal
+ * buscarPorParametro(opcion, inventario);
+ * @endcode
+ * 
+ * @note
+ * - Debe usarse junto con menuParametro()
+ * - Las opciones deben coincidir con las mostradas en el menú
+ * - El caso default maneja entradas fuera de rango
+ * 
+ * @see menuParametro() Para el menú de opciones correspondiente
+ * @see buscarPorNombre() Para detalles de búsqueda por nombre
+ * @see buscarPorTipo() Para detalles de búsqueda por tipo
+ * @see buscarPorValorNominal() Para detalles de búsqueda por valor
+ * @see buscarPorTolerancia() Para detalles de búsqueda por tolerancia
+ * @see buscarPorVoltaje() Para detalles de búsqueda por voltaje
+ * @see buscarPorEstado() Para detalles de búsqueda por estado
+ */
+template<class Coleccion>
+void buscarPorParametro(const int& opcion, const Coleccion& registros, indicesNumericos* indices = nullptr){
+    switch (opcion)
+    {
+    case 1:
+        buscarPorNombre(registros);
+        break;
+    case 2:
+        buscarPorTipo(registros);
+        break;
+    case 3:
+        buscarPorValorNominal(registros, indices);
+        break;
+    case 4:
+        buscarPorTolerancia(registros, indices);
+        break;
+    case 5:
+        buscarPorVoltaje(registros, indices);
+        break;
+    case 6:
+        buscarPorEstado(registros);
+        break;
+    case 8:
+        std::cout<<"Volviendo al menú principal...";
+    default:
+        std::cout<<"Entrada inválida, volviendo al menú principal...";
+        break;
+    }
+}
+
+/**
+ * @brief Busca componentes leyendo un flujo de texto bloque a bloque
+ * 
+ * @param entrada Flujo con el formato de 7 líneas (archivo o std::cin)
+ * @param cumple Función que recibe cada componente y devuelve true si debe emitirse
+ * @param emitir Función llamada con cada componente que cumple la condición,
+ *               en cuanto se termina de leer su bloque; si devuelve false la
+ *               lectura se detiene
+ * @param errores Recibe los primeros 10 bloques dañados (con su desplazamiento)
+ * @param anulados Bloques anulados por lápidas (leerLapidas()), o nullptr
+ * @param limite Byte donde termina la instantánea a leer (ver longitudConfirmada());
+ *               los bloques que empiezan en o después de él no se leen
+ * @return uint64_t Número de bloques dañados encontrados en total
+ * 
+ * @details
+ * A diferencia de cargarDesdeArchivo(), nunca guarda más de un bloque en
+ * memoria: las siete líneas se leen en cadenas que se reutilizan, así que el
+ * consumo de memoria no depende del tamaño del archivo y el primer resultado
+ * se emite antes de terminar de leerlo. Sirve para archivos más grandes que
+ * la memoria y para datos que llegan por una tubería.
+ * 
+ * Los bloques dañados se tratan igual que en analizarSiguienteBloque(): se
+ * reportan y la lectura se sincroniza con el siguiente separador "-----".
+ * Las lápidas también se saltan; como un flujo no se puede leer dos veces,
+ * los bloques que anulan solo se omiten si 'anulados' se obtuvo antes.
+ * 
+ * @throw Ninguno
+ * 
+ * @see buscarEnArchivoSinCargar()
+ */
+template<class Condicion, class Funcion>
+uint64_t buscarEnFlujo(std::istream& entrada, Condicion cumple, Funcion emitir, std::vector<errorDeCarga>& errores,
+                       const std::vector<uint64_t>* anulados = nullptr, uint64_t limite = std::numeric_limits<uint64_t>::max()){
+    const size_t maximoErrores = 10;
+    std::string lineas[7];
+    int leidas = 0;
+    uint64_t inicioBloque = 0;
+    uint64_t desplazamiento = 0;
+    uint64_t cantidadErrores = 0;
+    uint64_t recorridos = 0;
+    componente temp;
+
+    auto reportar = [&](const char* motivo) {
+        if (errores.size() < maximoErrores) errores.push_back({inicioBloque, motivo});
+        cantidadErrores++;
+    };
+
+    while (inicioBloque < limite) {
+        while (leidas < 7 && std::getline(entrada, lineas[leidas])) {
+            desplazamiento += lineas[leidas].size() + 1;
+            leidas++;
+        }
+        if (leidas == 0) break;
+
+        uint64_t anulado;
+        if (leidas >= 3 && esLapida(lineas[0], lineas[1], lineas[2], anulado)) {
+            for (int i = 0; i < 3; i++) inicioBloque += lineas[i].size() + 1;
+            for (int i = 3; i < leidas; i++) lineas[i - 3].swap(lineas[i]);
+            leidas -= 3;
+            continue;
+        }
+        if (leidas < 7) {
+            reportar("bloque incompleto al final del archivo");
+            break;
+        }
+
+        const char* motivo = nullptr;
+        if (lineas[6] != "-----") motivo = "falta el separador \"-----\"";
+        else if (!convertirFlotante(lineas[2], temp.valorNominal)) motivo = "valor nominal inválido";
+        else if (!convertirFlotante(lineas[3], temp.tolerancia)) motivo = "tolerancia inválida";
+        else if (!convertirFlotante(lineas[4], temp.voltajeDeTrabajo)) motivo = "voltaje inválido";
+
+        if (motivo == nullptr) {
+            recorridos++;
+            temp.nombreDelComponente.swap(lineas[0]);
+            temp.tipoDeComponente.swap(lineas[1]);
+            temp.estado.swap(lineas[5]);
+            const bool seguir = estaAnulado(anulados, inicioBloque) || !cumple(temp) || emitir(temp);
+            // Devolver las cadenas para reutilizar su memoria en el siguiente bloque
+            temp.nombreDelComponente.swap(lineas[0]);
+            temp.tipoDeComponente.swap(lineas[1]);
+            temp.estado.swap(lineas[5]);
+            if (!seguir) break;
+            inicioBloque = desplazamiento;
+            leidas = 0;
+            continue;
+        }
+
+        // Bloque dañado: las líneas después del primer separador (desde la segunda) inician el siguiente bloque
+        reportar(motivo);
+        int separador = 1;
+        while (separador < 7 && lineas[separador] != "-----") separador++;
+        uint64_t consumidos = 0;
+        for (int i = 0; i < 7 && i <= separador; i++) consumidos += lineas[i].size() + 1;
+        if (separador == 7) {
+            std::string linea;
+            while (std::getline(entrada, linea)) {
+                desplazamiento += linea.size() + 1;
+                consumidos += linea.size() + 1;
+                if (linea == "-----") break;
+            }
+            leidas = 0;
+        } else {
+            for (int i = separador + 1; i < 7; i++) lineas[i - separador - 1].swap(lineas[i]);
+            leidas = 6 - separador;
+        }
+        inicioBloque += consumidos;
+    }
+    contarEstadistica(contadorMedido::bytesLeidos, desplazamiento);
+    contarEstadistica(contadorMedido::registrosInterpretados, recorridos);
+    contarEstadistica(contadorMedido::registrosRecorridos, recorridos);
+    return cantidadErrores;
+}
+
+/**
+ * @brief Reconstruye el índice secundario de un registro de texto recorriéndolo completo
+ * 
+ * @param nombreArchivo Ruta del registro de texto
+ * @param indice Salida: índice reconstruido
+ * @return true si el registro se pudo leer y el índice se guardó (o no hacía
+ *         falta guardarlo porque otro proceso está escribiendo)
+ * 
+ * @details
+ * Recorre el archivo proyectado con analizarSiguienteBloque() y registra el
+ * inicio de cada bloque válido bajo su tipo y su estado. Después guarda el
+ * índice completo con escribirIndiceSecundario(), lo que también compacta las
+ * entradas que continuarConArchivo() fue añadiendo.
+ * 
+ * Los índices solo se escriben con el bloqueoDeRegistro tomado. Si otro
+ * proceso está escribiendo el registro, no se espera: el índice reconstruido
+ * sirve para esta búsqueda y no se guarda.
+ * 
+ * @see obtenerIndiceSecundario()
+ */
+bool reconstruirIndiceSecundario(const std::string& nombreArchivo, indiceSecundario& indice){
+    indice = indiceSecundario();
+    bloqueoDeRegistro bloqueo(nombreArchivo, modoDeBloqueo::intentar);
+    archivoMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) {
+        std::cout << "No se pudo abrir el archivo.\n";
+        return false;
+    }
+    const std::vector<uint64_t> anulados = leerLapidas(mapa.datos(), mapa.tamano());
+    escanerDeLineas escaner(mapa.datos(), mapa.datos() + mapa.tamano());
+    vistaComponente vista;
+    while (analizarSiguienteBloque(escaner, mapa.datos(), vista, nullptr, &anulados)) {
+        const uint64_t desplazamiento = vista.nombreDelComponente.data() - mapa.datos();
+        indice.porTipo[std::string(vista.tipoDeComponente)].push_back(desplazamiento);
+        indice.porEstado[std::string(vista.estado)].push_back(desplazamiento);
+    }
+    indice.bytesCubiertos = mapa.tamano();
+    indice.huella = huellaDeCola(mapa.datos(), mapa.tamano());
+    if (!bloqueo.adquirido()) return true; // Otro proceso está escribiendo: el índice se usa solo en memoria
+    if (!escribirIndiceSecundario(nombreArchivo, indice)) {
+        std::cout << "No se pudo guardar el índice '" << rutaDeIndice(nombreArchivo) << "'.\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Obtiene un índice secundario al día, reconstruyéndolo si hace falta
+ * 
+ * @param nombreArchivo Ruta del registro de texto
+ * @param indice Salida: índice que cubre el registro completo
+ * @return true si se obtuvo un índice válido
+ * 
+ * @details
+ * Usa el índice guardado si su línea L coincide con el tamaño actual del
+ * registro y con la huella de su final; en otro caso (no existe, o el registro se modificó sin pasar por
+ * continuarConArchivo()) lo reconstruye.
+ */
+bool obtenerIndiceSecundario(const std::string& nombreArchivo, indiceSecundario& indice){
+    if (leerIndiceSecundario(nombreArchivo, indice) && indiceAlDia(nombreArchivo, indice.bytesCubiertos, indice.huella)) {
+        return true;
+    }
+    std::cout << "Reconstruyendo el índice de tipos y estados...\n";
+    return reconstruirIndiceSecundario(nombreArchivo, indice);
+}
+
+/**
+ * @brief Busca por tipo o estado saltando directamente a los bloques del índice
+ * 
+ * @param nombreArchivo Ruta del registro de texto
+ * @param indice Índice al día del registro
+ * @param criterio Criterio sobre campoDeBusqueda::tipo o campoDeBusqueda::estado
+ * @param emitir Función llamada con cada vistaComponente coincidente, en orden de
+ *               archivo; si devuelve false la búsqueda se detiene
+ * @return uint64_t Número de componentes encontrados
+ * 
+ * @details
+ * 1. Evalúa la subcadena una sola vez por cada valor distinto del índice
+ * 2. Une y ordena los desplazamientos de los valores que coinciden
+ * 3. Interpreta solo esos bloques sobre el archivo proyectado, omitiendo los
+ *    anulados por lápidas añadidas después de construir el índice
+ * 
+ * El resultado es el mismo que el de buscarPorTipo()/buscarPorEstado(), pero
+ * el costo depende del número de coincidencias y no del tamaño del registro
+ * (salvo la búsqueda de lápidas de leerLapidas(), un memchr() sobre el archivo).
+ * 
+ * @see obtenerIndiceSecundario()
+ */
+template<class Funcion>
+uint64_t buscarConIndiceSecundario(const std::string& nombreArchivo, const indiceSecundario& indice, const criterioDeBusqueda& criterio, Funcion emitir){
+    const auto& grupo = criterio.campo == campoDeBusqueda::tipo ? indice.porTipo : indice.porEstado;
+    std::vector<uint64_t> bloques;
+    for (const auto& [valor, desplazamientos] : grupo) {
+        if (valor.find(criterio.texto) != std::string::npos) {
+            bloques.insert(bloques.end(), desplazamientos.begin(), desplazamientos.end());
+        }
+    }
+    std::sort(bloques.begin(), bloques.end());
+
+    archivoMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) return 0;
+    const std::vector<uint64_t> anulados = leerLapidas(mapa.datos(), mapa.tamano());
+    const char* fin = mapa.datos() + mapa.tamano();
+    uint64_t encontrados = 0;
+    for (uint64_t desplazamiento : bloques)
+    {
+        if (desplazamiento >= mapa.tamano() || estaAnulado(&anulados, desplazamiento)) continue;
+        escanerDeLineas escaner(mapa.datos() + desplazamiento, fin);
+        vistaComponente vista;
+        if (analizarSiguienteBloque(escaner, mapa.datos(), vista, nullptr)) {
+            encontrados++;
+            if (!emitir(vista)) break;
+        }
+    }
+    return encontrados;
+}
+
+/**
+ * @brief Reconstruye el índice de trigramas de un registro de texto recorriéndolo completo
+ * 
+ * @param nombreArchivo Ruta del registro de texto
+ * @param indice Salida: índice reconstruido
+ * @return true si el registro se pudo leer (el índice se guarda si el
+ *         registro no se está escribiendo, como en reconstruirIndiceSecundario())
+ * 
+ * @see obtenerIndiceDeTrigramas()
+ */
+bool reconstruirIndiceDeTrigramas(const std::string& nombreArchivo, indiceDeTrigramas& indice){
+    indice = indiceDeTrigramas();
+    bloqueoDeRegistro bloqueo(nombreArchivo, modoDeBloqueo::intentar);
+    archivoMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) {
+        std::cout << "No se pudo abrir el archivo.\n";
+        return false;
+    }
+    const std::vector<uint64_t> anulados = leerLapidas(mapa.datos(), mapa.tamano());
+    escanerDeLineas escaner(mapa.datos(), mapa.datos() + mapa.tamano());
+    vistaComponente vista;
+    while (analizarSiguienteBloque(escaner, mapa.datos(), vista, nullptr, &anulados)) {
+        const uint64_t desplazamiento = vista.nombreDelComponente.data() - mapa.datos();
+        for (uint32_t trigrama : trigramasDe(vista.nombreDelComponente)) {
+            indice.listas[trigrama].push_back(desplazamiento);
+        }
+    }
+    indice.bytesCubiertos = mapa.tamano();
+    indice.huella = huellaDeCola(mapa.datos(), mapa.tamano());
+    if (!bloqueo.adquirido()) return true; // Otro proceso está escribiendo: el índice se usa solo en memoria
+    if (!escribirIndiceDeTrigramas(nombreArchivo, indice)) {
+        std::cout << "No se pudo guardar el índice '" << rutaDeTrigramas(nombreArchivo) << "'.\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Obtiene un índice de trigramas al día, reconstruyéndolo si hace falta
+ * 
+ * @param nombreArchivo Ruta del registro de texto
+ * @param indice Salida: índice que cubre el registro completo
+ * @return true si se obtuvo un índice válido
+ */
+bool obtenerIndiceDeTrigramas(const std::string& nombreArchivo, indiceDeTrigramas& indice){
+    if (leerIndiceDeTrigramas(nombreArchivo, indice) && indiceAlDia(nombreArchivo, indice.bytesCubiertos, indice.huella)) {
+        return true;
+    }
+    std::cout << "Reconstruyendo el índice de nombres...\n";
+    return reconstruirIndiceDeTrigramas(nombreArchivo, indice);
+}
+
+/**
+ * @brief Busca una subcadena del nombre leyendo solo los bloques candidatos
+ * 
+ * @param nombreArchivo Ruta del registro de texto
+ * @param indice Índice de trigramas al día del registro
+ * @param texto Subcadena buscada (mismo criterio que buscarPorNombre())
+ * @param emitir Función llamada con cada vistaComponente coincidente, en orden de
+ *               archivo; si devuelve false la búsqueda se detiene
+ * @return uint64_t Número de componentes encontrados
+ * 
+ * @details
+ * 1. Obtiene los trigramas de la subcadena y sus listas de desplazamientos
+ * 2. Las interseca empezando por la más corta, así el trabajo queda acotado
+ *    por el trigrama más selectivo
+ * 3. Interpreta cada bloque candidato y confirma con std::string_view::find(),
+ *    porque tener todos los trigramas no garantiza que aparezcan contiguos;
+ *    los candidatos anulados por lápidas se omiten
+ * 
+ * Una subcadena de menos de 3 bytes no tiene trigramas: en ese caso todos los
+ * bloques son candidatos y la búsqueda equivale a un recorrido completo.
+ */
+template<class Funcion>
+uint64_t buscarConIndiceDeTrigramas(const std::string& nombreArchivo, const indiceDeTrigramas& indice, const std::string& texto, Funcion emitir){
+    archivoMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) return 0;
+    const std::vector<uint64_t> anulados = leerLapidas(mapa.datos(), mapa.tamano());
+    const char* fin = mapa.datos() + mapa.tamano();
+    uint64_t encontrados = 0;
+
+    const std::vector<uint32_t> trigramas = trigramasDe(texto);
+    if (trigramas.empty()) {
+        escanerDeLineas escaner(mapa.datos(), fin);
+        vistaComponente vista;
+        while (analizarSiguienteBloque(escaner, mapa.datos(), vista, nullptr, &anulados)) {
+            if (vista.nombreDelComponente.find(texto) != std::string_view::npos) {
+                encontrados++;
+                if (!emitir(vista)) break;
+            }
+        }
+        return encontrados;
+    }
+
+    std::vector<const std::vector<uint64_t>*> listas;
+    for (uint32_t trigrama : trigramas)
+    {
+        auto entrada = indice.listas.find(trigrama);
+        if (entrada == indice.listas.end()) return 0;
+        listas.push_back(&entrada->second);
+    }
+    std::sort(listas.begin(), listas.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+
+    std::vector<uint64_t> candidatos = *listas.front();
+    std::vector<uint64_t> siguiente;
+    for (size_t i = 1; i < listas.size() && !candidatos.empty(); i++)
+    {
+        siguiente.clear();
+        std::set_intersection(candidatos.begin(), candidatos.end(), listas[i]->begin(), listas[i]->end(),
+                              std::back_inserter(siguiente));
+        candidatos.swap(siguiente);
+    }
+
+    for (uint64_t desplazamiento : candidatos)
+    {
+        if (desplazamiento >= mapa.tamano() || estaAnulado(&anulados, desplazamiento)) continue;
+        escanerDeLineas escaner(mapa.datos() + desplazamiento, fin);
+        vistaComponente vista;
+        if (analizarSiguienteBloque(escaner, mapa.datos(), vista, nullptr)
+            && vista.nombreDelComponente.find(texto) != std::string_view::npos) {
+            encontrados++;
+            if (!emitir(vista)) break;
+        }
+    }
+    return encontrados;
+}
+
+/**
+ * @brief Tamaño a partir del cual la búsqueda usa el archivo proyectado en memoria
+ * 
+ * Los archivos menores se cargan completos en un registroEnArena; los mayores
+ * se recorren con registroMapeado sin materializar los registros.
+ */
+const uint64_t UMBRAL_MAPEO = 64ull * 1024 * 1024;
+
+/**
+ * @struct cacheDeBusqueda
+ * @brief Último archivo buscado y las estructuras derivadas de él
+ * 
+ * @details
+ * Se conserva entre llamadas a buscarEnArchivo(), de modo que volver a buscar
+ * en el mismo archivo no lo interpreta de nuevo mientras no cambie su tamaño
+ * ni su fecha de modificación (ver registroEnArena::actualizar()). Guarda un
+ * solo archivo: buscar en otro reemplaza su contenido.
+ * 
+ * Los archivos de UMBRAL_MAPEO bytes o más no se copian a 'registros'. De
+ * ellos se memorizan las consultas compuestas ya resueltas: la ubicación de
+ * cada coincidencia (inicio del bloque en texto, fila en binario), con la
+ * misma validez por ruta, tamaño y fecha. Repetir una consulta solo vuelve a
+ * leer sus coincidencias (ver ejecutarConsulta()).
+ */
+struct cacheDeBusqueda
+{
+    registroEnArena registros; ///< Componentes del archivo
+    indicesNumericos indices;  ///< Índices numéricos sobre 'registros'
+    tablaDeComponentes tabla;  ///< Columnas de 'registros' (puede tener solo un prefijo)
+    bool tablaIncompleta{false}; ///< El diccionario de 'tabla' se llenó: no cubrirá todas las filas
+    std::string rutaProyectada; ///< Archivo proyectado de 'consultasProyectadas' (vacía: no se memoriza)
+    uint64_t tamanoProyectado{0}; ///< Tamaño de ese archivo al memorizar
+    std::filesystem::file_time_type fechaProyectada; ///< Fecha de modificación de ese archivo al memorizar
+    std::map<std::string, std::vector<uint64_t>> consultasProyectadas; ///< Ubicaciones de las coincidencias, por consulta
+};
+
+/**
+ * @brief Descarta las consultas memorizadas si el archivo proyectado no es el mismo o cambió
+ * 
+ * @param cache Caché de búsqueda
+ * @param nombreArchivo Archivo proyectado que se va a consultar
+ * 
+ * @see ejecutarConsulta()
+ */
+void ponerAlDiaConsultasProyectadas(cacheDeBusqueda& cache, const std::string& nombreArchivo){
+    std::error_code error;
+    const std::string ruta = std::filesystem::weakly_canonical(nombreArchivo, error).string();
+    const uint64_t tamano = tamanoDeArchivo(nombreArchivo);
+    const auto fecha = std::filesystem::last_write_time(nombreArchivo, error);
+    if (error || ruta != cache.rutaProyectada || tamano != cache.tamanoProyectado || fecha != cache.fechaProyectada) {
+        cache.consultasProyectadas.clear();
+        cache.rutaProyectada = error ? std::string() : ruta;
+        cache.tamanoProyectado = tamano;
+        cache.fechaProyectada = fecha;
+    }
+}
+
+/**
+ * @brief Pone la caché al día con el archivo e informa de lo que tuvo que leer
+ * 
+ * @param cache Caché de búsqueda
+ * @param nombreArchivo Ruta del archivo
+ * @param avisos Flujo para los mensajes
+ * @return false si las filas de la caché siguen siendo las mismas
+ * 
+ * @details Los índices numéricos se descartan siempre que cambian las filas; la
+ * tabla solo se descarta si el archivo se recargó, porque al ampliarse basta
+ * con añadirle las filas nuevas.
+ */
+bool actualizarCacheDeBusqueda(cacheDeBusqueda& cache, const std::string& nombreArchivo, std::ostream& avisos = std::cout){
+    const size_t anteriores = cache.registros.size();
+    std::vector<errorDeCarga> errores;
+    switch (cache.registros.actualizar(nombreArchivo, errores)) {
+    case registroEnArena::resultadoDeActualizacion::sinCambios:
+        avisos << "Usando los " << cache.registros.size() << " componentes ya cargados de este archivo.\n";
+        return false;
+    case registroEnArena::resultadoDeActualizacion::ampliado:
+        avisos << "El archivo creció: se leyeron " << cache.registros.size() - anteriores
+                  << " componentes nuevos.\n";
+        break;
+    case registroEnArena::resultadoDeActualizacion::recargado:
+    case registroEnArena::resultadoDeActualizacion::error:
+        cache.tabla = tablaDeComponentes();
+        cache.tablaIncompleta = false;
+        break;
+    }
+    cache.indices = indicesNumericos();
+    mostrarErroresDeCarga(errores, avisos);
+    return true;
+}
+
+/**
+ * @brief Pone la tabla columnar de la caché al día con sus registros
+ * 
+ * @param cache Caché de búsqueda ya actualizada con actualizarCacheDeBusqueda()
+ * @param avisos Flujo para el aviso de diccionario lleno
+ * @return const tablaDeComponentes& La tabla, con las filas que faltaban añadidas
+ * 
+ * @warning Si el archivo tiene más de diccionarioDeCadenas::CAPACIDAD tipos o
+ *          estados distintos, la tabla se detiene en la primera fila que no
+ *          cabe; quien la use debe comprobar que cubre todas las filas
+ *          (tabla.size() == cache.registros.size()) y, si no, recorrer los
+ *          registros. El aviso se muestra una vez; después la tabla ya no se
+ *          amplía hasta que el archivo se recargue
+ */
+const tablaDeComponentes& tablaAlDia(cacheDeBusqueda& cache, std::ostream& avisos = std::cout){
+    cronometroDeEtapa cronometro(etapaMedida::interpretacion);
+    tablaDeComponentes& tabla = cache.tabla;
+    const registroEnArena& registros = cache.registros;
+    if (cache.tablaIncompleta) return tabla;
+    if (tabla.size() < registros.size()) tabla.reservar(registros.size());
+    for (size_t i = tabla.size(); i < registros.size(); ++i)
+    {
+        if (!tabla.agregar(registros[i])) {
+            cache.tablaIncompleta = true;
+            avisos << "La tabla admite como máximo " << diccionarioDeCadenas::CAPACIDAD
+                   << " tipos y estados distintos: se recorren las filas.\n";
+            break;
+        }
+    }
+    return tabla;
+}
+
+/**
+ * @enum operadorDeConsulta
+ * @brief Comparación de un predicado de consulta
+ * 
+ * Los campos de texto admiten contiene, igual y distinto; los numéricos todos
+ * menos contiene.
+ */
+enum class operadorDeConsulta
+{
+    contiene,    ///< "~": subcadena (como buscarPorNombre())
+    igual,       ///< "=": texto idéntico, o número tolerante al redondeo
+    distinto,    ///< "!=": negación de igual
+    menor,       ///< "<"
+    menorOIgual, ///< "<="
+    mayor,       ///< ">"
+    mayorOIgual  ///< ">="
+};
+
+/**
+ * @struct predicadoDeConsulta
+ * @brief Condición sobre un campo de componente dentro de una consultaCompuesta
+ * 
+ * @details
+ * Los predicados numéricos se guardan como un intervalo cerrado
+ * [minimo, maximo], opcionalmente negado: "voltaje>=25" es [25, +inf],
+ * "valor<10" es [-inf, anterior(10)] y "tolerancia!=5" es la negación del
+ * intervalo de 16 ULPs alrededor de 5. Así se evalúan con una sola
+ * comparación doble y con los mismos núcleos que las búsquedas de rango
+ * (seleccionarEnRango()).
+ * 
+ * Si el valor de "valor" lleva prefijo SI o unidad ("valor>=1nF"), el
+ * predicado es canónico: el intervalo [minimoCanonico, maximoCanonico] se
+ * compara con el valor canónico de cada componente (magnitudCanonica()) y,
+ * si el predicado indica unidad, solo cumplen los componentes de esa unidad.
+ * 
+ * @see interpretarPredicado()
+ */
+struct predicadoDeConsulta
+{
+    std::string expresion; ///< Texto original, para mostrar el plan
+    campoDeBusqueda campo{campoDeBusqueda::nombre}; ///< Campo evaluado
+    operadorDeConsulta operador{operadorDeConsulta::igual}; ///< Comparación
+    std::string texto; ///< Valor comparado (campos de texto)
+    float minimo{0.00}; ///< Límite inferior del intervalo (campos numéricos)
+    float maximo{0.00}; ///< Límite superior del intervalo (campos numéricos)
+    bool negado{false}; ///< true si cumple quien queda fuera del intervalo
+    bool canonico{false}; ///< true si compara valores canónicos (valor con prefijo o unidad)
+    unidadElectrica unidad{unidadElectrica::ninguna}; ///< Unidad exigida (ninguna: cualquiera)
+    double minimoCanonico{0.0}; ///< Límite inferior en la unidad base (predicados canónicos)
+    double maximoCanonico{0.0}; ///< Límite superior en la unidad base (predicados canónicos)
+    double selectividad{1.0}; ///< Fracción estimada de filas que lo cumplen
+    double costo{1.0}; ///< Costo relativo de evaluarlo en una fila
+};
+
+/**
+ * @enum conectorLogico
+ * @brief Cómo se combinan los predicados de una consultaCompuesta
+ */
+enum class conectorLogico
+{
+    y, ///< Conjunción: deben cumplirse todos
+    o  ///< Disyunción: basta con uno
+};
+
+/**
+ * @struct consultaCompuesta
+ * @brief Conjunción o disyunción de predicados sobre los campos de componente
+ * 
+ * @see interpretarConsulta()
+ * @see ejecutarConsulta()
+ */
+struct consultaCompuesta
+{
+    std::vector<predicadoDeConsulta> predicados; ///< En orden de evaluación tras ordenarPredicados()
+    conectorLogico conector{conectorLogico::y}; ///< Combinación de los predicados
+};
+
+/**
+ * @brief Interpreta un predicado del tipo <campo><operador><valor>
+ * 
+ * @param expresion Texto como "voltaje>=25", "tipo=Capacitor" o "nombre~10k"
+ * @param predicado Salida: predicado interpretado
+ * @return std::string Vacía si es válido; si no, el motivo
+ * 
+ * @details Operadores: ~ (contiene), =, !=, <, <=, >, >=. Se admiten espacios
+ * alrededor del operador. Los campos son los de interpretarCampo().
+ * 
+ * "valor" admite prefijos SI y unidades ("valor>=1nF", "valor=4k7",
+ * "valor<10 kΩ"); los límites se amplían en TOLERANCIA_CANONICA para que
+ * "=" tolere el redondeo, igual que los 16 ULPs de un número sin sufijo.
+ */
+std::string interpretarPredicado(const std::string& expresion, predicadoDeConsulta& predicado){
+    const size_t posicion = expresion.find_first_of("~=!<>");
+    if (posicion == std::string::npos) return "falta el operador en '" + expresion + "'";
+
+    std::string nombre = expresion.substr(0, posicion);
+    nombre.erase(nombre.find_last_not_of(' ') + 1);
+    if (!interpretarCampo(nombre, predicado.campo)) return "campo desconocido '" + nombre + "'";
+
+    size_t longitud = 1;
+    const bool doble = posicion + 1 < expresion.size() && expresion[posicion + 1] == '=';
+    switch (expresion[posicion])
+    {
+    case '~': predicado.operador = operadorDeConsulta::contiene; break;
+    case '=': predicado.operador = operadorDeConsulta::igual; break;
+    case '!':
+        if (!doble) return "operador inválido en '" + expresion + "'";
+        predicado.operador = operadorDeConsulta::distinto;
+        break;
+    case '<': predicado.operador = doble ? operadorDeConsulta::menorOIgual : operadorDeConsulta::menor; break;
+    default: predicado.operador = doble ? operadorDeConsulta::mayorOIgual : operadorDeConsulta::mayor; break;
+    }
+    if (doble && expresion[posicion] != '=') longitud = 2;
+
+    predicado.expresion = expresion;
+    predicado.texto = expresion.substr(posicion + longitud);
+    predicado.texto.erase(0, predicado.texto.find_first_not_of(' '));
+    if (predicado.texto.empty()) return "falta el valor en '" + expresion + "'";
+
+    const bool numerico = predicado.campo == campoDeBusqueda::valorNominal || predicado.campo == campoDeBusqueda::tolerancia
+        || predicado.campo == campoDeBusqueda::voltaje;
+    if (!numerico) {
+        predicado.costo = predicado.campo == campoDeBusqueda::nombre ? 8.0 : 1.0;
+        if (predicado.operador != operadorDeConsulta::contiene && predicado.operador != operadorDeConsulta::igual
+            && predicado.operador != operadorDeConsulta::distinto) {
+            return "el campo '" + nombre + "' solo admite ~, = y !=";
+        }
+        return "";
+    }
+
+    magnitudElectrica magnitud;
+    bool conSufijo = false;
+    if (predicado.campo == campoDeBusqueda::valorNominal && predicado.operador != operadorDeConsulta::contiene
+        && interpretarMagnitud(predicado.texto, magnitud, &conSufijo) && conSufijo) {
+        const double infinito = std::numeric_limits<double>::infinity();
+        const double margen = std::abs(magnitud.valor) * TOLERANCIA_CANONICA;
+        predicado.canonico = true;
+        predicado.unidad = magnitud.unidad;
+        predicado.costo = 1.0;
+        switch (predicado.operador)
+        {
+        case operadorDeConsulta::menor:
+            predicado.minimoCanonico = -infinito;
+            predicado.maximoCanonico = std::nextafter(magnitud.valor - margen, -infinito);
+            break;
+        case operadorDeConsulta::menorOIgual:
+            predicado.minimoCanonico = -infinito;
+            predicado.maximoCanonico = magnitud.valor + margen;
+            break;
+        case operadorDeConsulta::mayor:
+            predicado.minimoCanonico = std::nextafter(magnitud.valor + margen, infinito);
+            predicado.maximoCanonico = infinito;
+            break;
+        case operadorDeConsulta::mayorOIgual:
+            predicado.minimoCanonico = magnitud.valor - margen;
+            predicado.maximoCanonico = infinito;
+            break;
+        default:
+            predicado.minimoCanonico = magnitud.valor - margen;
+            predicado.maximoCanonico = magnitud.valor + margen;
+            predicado.negado = predicado.operador == operadorDeConsulta::distinto;
+            break;
+        }
+        return "";
+    }
+
+    float valor;
+    if (!convertirFlotante(predicado.texto, valor)) return "valor numérico inválido '" + predicado.texto + "'";
+    const float infinito = std::numeric_limits<float>::infinity();
+    predicado.costo = 1.0;
+    switch (predicado.operador)
+    {
+    case operadorDeConsulta::contiene:
+        return "el campo '" + nombre + "' no admite ~";
+    case operadorDeConsulta::igual:
+    case operadorDeConsulta::distinto:
+        predicado.minimo = desplazarUlps(valor, -ULPS_DE_TOLERANCIA);
+        predicado.maximo = desplazarUlps(valor, ULPS_DE_TOLERANCIA);
+        predicado.negado = predicado.operador == operadorDeConsulta::distinto;
+        break;
+    case operadorDeConsulta::menor:
+        predicado.minimo = -infinito;
+        predicado.maximo = std::nextafter(valor, -infinito);
+        break;
+    case operadorDeConsulta::menorOIgual:
+        predicado.minimo = -infinito;
+        predicado.maximo = valor;
+        break;
+    case operadorDeConsulta::mayor:
+        predicado.minimo = std::nextafter(valor, infinito);
+        predicado.maximo = infinito;
+        break;
+    case operadorDeConsulta::mayorOIgual:
+        predicado.minimo = valor;
+        predicado.maximo = infinito;
+        break;
+    }
+    return "";
+}
+
+/**
+ * @brief Interpreta una consulta formada por predicados unidos por "y" o por "o"
+ * 
+ * @param texto Ej: "tipo=Capacitor y estado=Nuevo y voltaje>=25"
+ * @param consulta Salida: consulta interpretada
+ * @return std::string Vacía si es válida; si no, el motivo
+ * 
+ * @details
+ * Las palabras "y" y "o" aisladas separan predicados, así que no pueden
+ * aparecer dentro de un valor; los espacios repetidos de un valor se reducen
+ * a uno. No se admite mezclar "y" con "o" en la misma consulta.
+ */
+std::string interpretarConsulta(const std::string& texto, consultaCompuesta& consulta){
+    consulta = consultaCompuesta();
+    std::istringstream palabras(texto);
+    std::string palabra;
+    std::string actual;
+    bool conectorVisto = false;
+    auto cerrarPredicado = [&]() -> std::string {
+        if (actual.empty()) return "falta un criterio antes o después de 'y'/'o'";
+        predicadoDeConsulta predicado;
+        std::string motivo = interpretarPredicado(actual, predicado);
+        if (!motivo.empty()) return motivo;
+        consulta.predicados.push_back(std::move(predicado));
+        actual.clear();
+        return "";
+    };
+    while (palabras >> palabra) {
+        if (palabra == "y" || palabra == "o") {
+            conectorLogico conector = palabra == "y" ? conectorLogico::y : conectorLogico::o;
+            if (conectorVisto && conector != consulta.conector) return "no se pueden mezclar 'y' y 'o' en la misma consulta";
+            consulta.conector = conector;
+            conectorVisto = true;
+            std::string motivo = cerrarPredicado();
+            if (!motivo.empty()) return motivo;
+        } else {
+            if (!actual.empty()) actual += ' ';
+            actual += palabra;
+        }
+    }
+    return cerrarPredicado();
+}
+
+/**
+ * @brief Evalúa un predicado de texto sobre el valor de un campo
+ */
+template<class Texto>
+bool cumpleTexto(const Texto& valor, const predicadoDeConsulta& predicado){
+    switch (predicado.operador)
+    {
+    case operadorDeConsulta::contiene:
+        return valor.find(predicado.texto) != Texto::npos;
+    case operadorDeConsulta::distinto:
+        return valor != predicado.texto;
+    default:
+        return valor == predicado.texto;
+    }
+}
+
+/**
+ * @brief Evalúa un predicado numérico (intervalo, posiblemente negado) sobre un valor
+ */
+inline bool cumpleIntervalo(float valor, const predicadoDeConsulta& predicado){
+    return (valor >= predicado.minimo && valor <= predicado.maximo) != predicado.negado;
+}
+
+/**
+ * @brief Evalúa un predicado canónico sobre el valor canónico de un componente
+ */
+inline bool cumpleCanonico(double valor, unidadElectrica unidad, const predicadoDeConsulta& predicado){
+    const bool dentro = (predicado.unidad == unidadElectrica::ninguna || unidad == predicado.unidad)
+        && valor >= predicado.minimoCanonico && valor <= predicado.maximoCanonico;
+    return dentro != predicado.negado;
+}
+
+/**
+ * @brief Recorre los tramos de un indiceCanonico que caen dentro del intervalo de un predicado canónico
+ * 
+ * @param indice Índice canónico
+ * @param predicado Predicado canónico (se ignora 'negado')
+ * @param funcion Llamada como funcion(desde, hasta) con cada tramo de entradas coincidentes
+ * 
+ * @details Un tramo por unidad: solo el de predicado.unidad, o uno por cada
+ * unidad si el predicado no indica ninguna.
+ */
+template<class Funcion>
+void recorrerIndiceCanonico(const indiceCanonico& indice, const predicadoDeConsulta& predicado, Funcion funcion){
+    const auto& entradas = indice.entradas;
+    for (uint8_t u = 0; u < static_cast<uint8_t>(unidadElectrica::cantidad); u++)
+    {
+        const unidadElectrica unidad = static_cast<unidadElectrica>(u);
+        if (predicado.unidad != unidadElectrica::ninguna && unidad != predicado.unidad) continue;
+        auto desde = std::lower_bound(entradas.begin(), entradas.end(), std::make_pair(unidad, predicado.minimoCanonico),
+            [](const entradaCanonica& e, const std::pair<unidadElectrica, double>& clave) {
+                return e.unidad != clave.first ? e.unidad < clave.first : e.valor < clave.second;
+            });
+        auto hasta = std::upper_bound(desde, entradas.end(), std::make_pair(unidad, predicado.maximoCanonico),
+            [](const std::pair<unidadElectrica, double>& clave, const entradaCanonica& e) {
+                return clave.first != e.unidad ? clave.first < e.unidad : clave.second < e.valor;
+            });
+        funcion(desde, hasta);
+    }
+}
+
+/**
+ * @brief Evalúa un predicado sobre un componente
+ * 
+ * @param c Componente (componente o vistaComponente)
+ * @param predicado Predicado a evaluar
+ */
+template<class Registro>
+bool cumplePredicado(const Registro& c, const predicadoDeConsulta& predicado){
+    switch (predicado.campo)
+    {
+    case campoDeBusqueda::nombre:
+        return cumpleTexto(c.nombreDelComponente, predicado);
+    case campoDeBusqueda::tipo:
+        return cumpleTexto(c.tipoDeComponente, predicado);
+    case campoDeBusqueda::estado:
+        return cumpleTexto(c.estado, predicado);
+    default:
+        if (predicado.canonico) {
+            const magnitudElectrica magnitud = magnitudCanonica(c.nombreDelComponente, c.tipoDeComponente, c.valorNominal);
+            return cumpleCanonico(magnitud.valor, magnitud.unidad, predicado);
+        }
+        return cumpleIntervalo(valorDeCampo(c, predicado.campo), predicado);
+    }
+}
+
+/**
+ * @brief Búsqueda única sobre un archivo sin cargarlo en memoria
+ * 
+ * @param nombreArchivo Ruta del archivo, o "-" para leer la entrada estándar
+ * @param predicado Predicado que deben cumplir los componentes (ver consultaDeBusqueda())
+ * @param salida Destino de las coincidencias (formato y paginación)
+ * @return uint64_t Número de componentes encontrados antes de detenerse
+ * 
+ * @details
+ * Cada componente se evalúa con cumplePredicado(), igual que en --consultar,
+ * en el servidor y en los registros particionados, así que "valor 10uF"
+ * compara valores canónicos (magnitudCanonica()) en todos ellos.
+ * 
+ * Las búsquedas por tipo o estado usan el índice secundario si existe y está
+ * al día (buscarConIndiceSecundario()), y las búsquedas por nombre el índice
+ * de trigramas en las mismas condiciones (buscarConIndiceDeTrigramas()). En otro caso, los archivos de texto
+ * (y la entrada estándar) se leen con buscarEnFlujo() y los binarios se
+ * recorren con registroMapeado, que tampoco materializa los registros. Las
+ * coincidencias se entregan a 'salida', que las escribe en bloques; en cuanto
+ * alcanza su límite, la lectura del archivo se detiene.
+ * 
+ * Antes de leer un archivo de texto se reúnen sus lápidas con leerLapidas()
+ * para omitir los componentes borrados, y la lectura se detiene al final de
+ * esa misma instantánea (ver longitudConfirmada()), así que no ve lo que otro
+ * proceso esté añadiendo mientras tanto. La entrada estándar no se puede
+ * releer: en ella las lápidas se saltan pero los bloques que anulan se
+ * muestran (hay que compactar el registro antes de enviarlo por una tubería).
+ * 
+ * @par Ejemplo de uso:
+ * @code{.sh}
+ * ./registroDeComponentes --buscar inventario.txt tipo Capacitor
+ * cat inventario.txt | ./registroDeComponentes --buscar - estado Nuevo --formato jsonl --limite 10
+ * @endcode
+ * 
+ * @see buscarEnFlujo()
+ */
+uint64_t buscarEnArchivoSinCargar(const std::string& nombreArchivo, const predicadoDeConsulta& predicado, salidaDeResultados& salida){
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    uint64_t encontrados = 0;
+    auto emitir = [&encontrados, &salida](const auto& c) {
+        encontrados++;
+        return salida.emitir(c);
+    };
+    auto cumple = [&predicado](const auto& c) { return cumplePredicado(c, predicado); };
+
+    // Los índices resuelven subcadenas ("~"), que es lo que consultaDeBusqueda() produce en los textos
+    criterioDeBusqueda criterio;
+    criterio.campo = predicado.campo;
+    criterio.texto = predicado.texto;
+    const bool porSubcadena = predicado.operador == operadorDeConsulta::contiene;
+    const bool porTipoOEstado = porSubcadena && (criterio.campo == campoDeBusqueda::tipo || criterio.campo == campoDeBusqueda::estado);
+    indiceSecundario indice;
+    if (nombreArchivo != "-" && porTipoOEstado && leerIndiceSecundario(nombreArchivo, indice)
+        && indiceAlDia(nombreArchivo, indice.bytesCubiertos, indice.huella)) {
+        return buscarConIndiceSecundario(nombreArchivo, indice, criterio, emitir);
+    }
+    indiceDeTrigramas trigramas;
+    if (nombreArchivo != "-" && porSubcadena && criterio.campo == campoDeBusqueda::nombre && leerIndiceDeTrigramas(nombreArchivo, trigramas)
+        && indiceAlDia(nombreArchivo, trigramas.bytesCubiertos, trigramas.huella)) {
+        return buscarConIndiceDeTrigramas(nombreArchivo, trigramas, criterio.texto, emitir);
+    }
+
+    if (nombreArchivo != "-" && esArchivoBinario(nombreArchivo)) {
+        registroMapeado mapa(nombreArchivo);
+        uint64_t recorridos = 0;
+        for (const auto& c : mapa) {
+            recorridos++;
+            if (cumple(c) && !emitir(c)) break;
+        }
+        contarEstadistica(contadorMedido::registrosRecorridos, recorridos);
+        return encontrados;
+    }
+
+    std::vector<errorDeCarga> errores;
+    uint64_t cantidadErrores = 0;
+    if (nombreArchivo == "-") {
+        cantidadErrores = buscarEnFlujo(std::cin, cumple, emitir, errores);
+    } else {
+        std::ifstream archivo(nombreArchivo);
+        if (!archivo.is_open()) {
+            salida.avisos() << "No se pudo abrir el archivo.\n";
+            return 0;
+        }
+        std::vector<uint64_t> anulados;
+        uint64_t limite = 0;
+        {
+            archivoMapeado mapa(nombreArchivo);
+            if (mapa.abierto()) anulados = leerLapidas(mapa.datos(), mapa.tamano());
+            limite = mapa.tamano();
+        }
+        cantidadErrores = buscarEnFlujo(archivo, cumple, emitir, errores, &anulados, limite);
+    }
+    salida.vaciar();
+    mostrarErroresDeCarga(errores, salida.avisos());
+    if (cantidadErrores > errores.size()) {
+        salida.avisos() << "Total de bloques dañados: " << cantidadErrores << "\n";
+    }
+    return encontrados;
+}
+
+/// Número máximo de filas que se evalúan para estimar la selectividad sin estadísticas
+const size_t MUESTRA_DE_SELECTIVIDAD = 1024;
+
+/**
+ * @brief Ordena los predicados para evaluar primero los que más filas descartan por unidad de costo
+ * 
+ * @param consulta Consulta con la selectividad y el costo de cada predicado ya estimados
+ * 
+ * @details
+ * Con "y", una fila deja de evaluarse en cuanto falla un predicado, así que
+ * conviene empezar por el de menor costo / (1 - selectividad). Con "o" se
+ * detiene en cuanto uno se cumple, y el orden es por costo / selectividad.
+ */
+void ordenarPredicados(consultaCompuesta& consulta){
+    const bool conjuncion = consulta.conector == conectorLogico::y;
+    auto rango = [conjuncion](const predicadoDeConsulta& p) {
+        double util = conjuncion ? 1.0 - p.selectividad : p.selectividad;
+        return p.costo / std::max(util, 1e-9);
+    };
+    std::stable_sort(consulta.predicados.begin(), consulta.predicados.end(),
+        [&rango](const predicadoDeConsulta& a, const predicadoDeConsulta& b) { return rango(a) < rango(b); });
+}
+
+/**
+ * @brief Muestra el orden en que se evaluarán los predicados y su selectividad estimada
+ */
+void mostrarPlan(const consultaCompuesta& consulta, std::ostream& salida){
+    salida << "Orden de evaluación (" << (consulta.conector == conectorLogico::y ? "deben cumplirse todos"
+                                                                                    : "basta con uno") << "):\n";
+    for (size_t i = 0; i < consulta.predicados.size(); i++)
+    {
+        salida << "  " << i + 1 << ". " << consulta.predicados[i].expresion << "  (~"
+                  << std::round(consulta.predicados[i].selectividad * 1000) / 10 << "% de las filas)\n";
+    }
+}
+
+/**
+ * @brief Estima la selectividad de cada predicado evaluándolo sobre las primeras filas
+ * 
+ * @param registros Colección recorrible (ej: registroMapeado)
+ * @param consulta Consulta cuyos predicados reciben su selectividad
+ * 
+ * @note Se usa cuando no hay estadísticas (archivos proyectados); las primeras
+ *       MUESTRA_DE_SELECTIVIDAD filas pueden no representar el resto
+ */
+template<class Coleccion>
+void estimarPorMuestreo(const Coleccion& registros, consultaCompuesta& consulta){
+    std::vector<size_t> aciertos(consulta.predicados.size(), 0);
+    size_t muestra = 0;
+    for (const auto& c : registros) {
+        if (muestra == MUESTRA_DE_SELECTIVIDAD) break;
+        for (size_t k = 0; k < consulta.predicados.size(); k++) aciertos[k] += cumplePredicado(c, consulta.predicados[k]);
+        muestra++;
+    }
+    for (size_t k = 0; k < consulta.predicados.size(); k++)
+    {
+        consulta.predicados[k].selectividad = (aciertos[k] + 1.0) / (muestra + 2.0);
+    }
+}
+
+/**
+ * @brief Estima la selectividad de cada predicado con las estadísticas de la tabla
+ * 
+ * @param tabla Tabla consultada
+ * @param indices Índices numéricos de las mismas filas (puede ser nullptr)
+ * @param aceptados aceptados[k][codigo]: códigos que cumplen el predicado k (tipo o estado)
+ * @param consulta Consulta cuyos predicados reciben su selectividad
+ * 
+ * @details
+ * - tipo y estado: exacta, sumando diccionarioDeCadenas::apariciones de los
+ *   códigos aceptados (sin recorrer la columna)
+ * - numéricos con índice ya construido (el canónico, para los predicados
+ *   canónicos): exacta, con dos búsquedas binarias
+ * - el resto: evaluando MUESTRA_DE_SELECTIVIDAD filas repartidas por la tabla
+ */
+void estimarEnTabla(const tablaDeComponentes& tabla, const indicesNumericos* indices,
+                    const std::vector<std::vector<uint8_t>>& aceptados, consultaCompuesta& consulta){
+    const size_t n = tabla.size();
+    if (n == 0) return;
+    const size_t paso = std::max<size_t>(1, n / MUESTRA_DE_SELECTIVIDAD);
+    auto porValor = [](const std::pair<float, uint32_t>& entrada, float valor) { return entrada.first < valor; };
+    auto valorAntes = [](float valor, const std::pair<float, uint32_t>& entrada) { return valor < entrada.first; };
+    for (size_t k = 0; k < consulta.predicados.size(); k++)
+    {
+        predicadoDeConsulta& p = consulta.predicados[k];
+        if (p.campo == campoDeBusqueda::tipo || p.campo == campoDeBusqueda::estado) {
+            const diccionarioDeCadenas& diccionario = p.campo == campoDeBusqueda::tipo ? tabla.diccionarioDeTipos : tabla.diccionarioDeEstados;
+            uint64_t filas = 0;
+            for (size_t codigo = 0; codigo < aceptados[k].size(); codigo++)
+            {
+                if (aceptados[k][codigo]) filas += diccionario.apariciones[codigo];
+            }
+            p.selectividad = std::min(1.0, static_cast<double>(filas) / n);
+            continue;
+        }
+        if (p.canonico && indices && indices->canonicoConstruido) {
+            size_t filas = 0;
+            recorrerIndiceCanonico(indices->canonico, p, [&filas](auto desde, auto hasta) { filas += hasta - desde; });
+            double dentro = static_cast<double>(filas) / n;
+            p.selectividad = p.negado ? 1.0 - dentro : dentro;
+            continue;
+        }
+        const int i = p.campo == campoDeBusqueda::valorNominal ? 0 : (p.campo == campoDeBusqueda::tolerancia ? 1 : 2);
+        if (p.campo != campoDeBusqueda::nombre && !p.canonico && indices && indices->construido[i]) {
+            const auto& entradas = indices->porCampo[i].entradas;
+            auto desde = std::lower_bound(entradas.begin(), entradas.end(), p.minimo, porValor);
+            auto hasta = std::upper_bound(desde, entradas.end(), p.maximo, valorAntes);
+            double dentro = static_cast<double>(hasta - desde) / n;
+            p.selectividad = p.negado ? 1.0 - dentro : dentro;
+            continue;
+        }
+        size_t aciertos = 0;
+        size_t muestra = 0;
+        for (size_t fila = 0; fila < n; fila += paso, muestra++)
+        {
+            aciertos += p.canonico ? cumpleCanonico(tabla.magnitudes[fila], tabla.unidades[fila], p) : cumplePredicado(tabla.fila(fila), p);
+        }
+        p.selectividad = (aciertos + 1.0) / (muestra + 2.0);
+    }
+}
+
+/**
+ * @brief Evalúa un predicado sobre una fila de la tabla sin reconstruir la fila
+ */
+inline bool cumplePredicadoEnTabla(const tablaDeComponentes& tabla, size_t fila, const predicadoDeConsulta& predicado,
+                                   const std::vector<uint8_t>& aceptados){
+    switch (predicado.campo)
+    {
+    case campoDeBusqueda::nombre:
+        return cumpleTexto(std::string_view(tabla.nombres[fila]), predicado);
+    case campoDeBusqueda::tipo:
+        return aceptados[tabla.tipos[fila]];
+    case campoDeBusqueda::estado:
+        return aceptados[tabla.estados[fila]];
+    default:
+        if (predicado.canonico) return cumpleCanonico(tabla.magnitudes[fila], tabla.unidades[fila], predicado);
+        return cumpleIntervalo(tabla.columna(predicado.campo)[fila], predicado);
+    }
+}
+
+/**
+ * @brief Calcula la máscara completa de un predicado usando el mejor acceso disponible
+ * 
+ * @details
+ * - tipo y estado: seleccionarPorCodigos() con los códigos aceptados
+ * - numéricos: el índice ordenado si ya existe (solo se recorren las
+ *   coincidencias); si no, seleccionarEnRango(); la negación invierte la máscara
+ * - canónicos: el indiceCanonico si ya existe; si no, recorrido de las
+ *   columnas magnitudes y unidades
+ * - nombre: recorrido de la columna
+ */
+mascaraDeSeleccion mascaraDePredicado(const tablaDeComponentes& tabla, const indicesNumericos* indices,
+                                      const predicadoDeConsulta& predicado, const std::vector<uint8_t>& aceptados){
+    const size_t n = tabla.size();
+    if (predicado.campo == campoDeBusqueda::tipo) return seleccionarPorCodigos(tabla.tipos, aceptados);
+    if (predicado.campo == campoDeBusqueda::estado) return seleccionarPorCodigos(tabla.estados, aceptados);
+
+    mascaraDeSeleccion mascara((n + 63) / 64, 0);
+    if (predicado.canonico && !predicado.negado && indices && indices->canonicoConstruido) {
+        recorrerIndiceCanonico(indices->canonico, predicado, [&mascara, n](auto desde, auto hasta) {
+            for (auto it = desde; it != hasta; ++it)
+            {
+                if (it->fila < n) mascara[it->fila / 64] |= uint64_t{1} << (it->fila % 64);
+            }
+        });
+        return mascara;
+    }
+    if (predicado.campo == campoDeBusqueda::nombre || predicado.canonico) {
+        for (size_t i = 0; i < n; i++)
+        {
+            if (cumplePredicadoEnTabla(tabla, i, predicado, aceptados)) mascara[i / 64] |= uint64_t{1} << (i % 64);
+        }
+        return mascara;
+    }
+
+    const int campo = predicado.campo == campoDeBusqueda::valorNominal ? 0 : (predicado.campo == campoDeBusqueda::tolerancia ? 1 : 2);
+    if (!predicado.negado && indices && indices->construido[campo]) {
+        consultaNumerica consulta;
+        consulta.modo = modoNumerico::rango;
+        consulta.minimo = predicado.minimo;
+        consulta.maximo = predicado.maximo;
+        for (uint32_t i : consultarIndiceNumerico(indices->porCampo[campo], consulta))
+        {
+            if (i < n) mascara[i / 64] |= uint64_t{1} << (i % 64);
+        }
+        return mascara;
+    }
+    mascara = seleccionarEnRango(tabla.columna(predicado.campo).data(), n, predicado.minimo, predicado.maximo);
+    if (predicado.negado) {
+        for (uint64_t& palabra : mascara) palabra = ~palabra;
+        if (n % 64 != 0) mascara.back() &= (uint64_t{1} << (n % 64)) - 1;
+    }
+    return mascara;
+}
+
+/**
+ * @brief Evalúa una consulta compuesta sobre una tabla columnar
+ * 
+ * @param tabla Tabla consultada
+ * @param indices Índices numéricos de las mismas filas (puede ser nullptr)
+ * @param consulta Consulta; sus predicados se estiman y reordenan
+ * @param avisos Flujo donde se muestra el plan (mostrarPlan())
+ * @return mascaraDeSeleccion Filas que cumplen la consulta
+ * 
+ * @details
+ * 1. Estima la selectividad de cada predicado (estimarEnTabla()) y los
+ *    ordena (ordenarPredicados())
+ * 2. El primer predicado se evalúa sobre toda la tabla con mascaraDePredicado()
+ * 3. Con "y", los demás se evalúan solo en las filas aún seleccionadas, en
+ *    orden, abandonando la fila en el primer predicado que falla; con "o",
+ *    solo en las filas aún no seleccionadas, hasta el primero que se cumple
+ */
+mascaraDeSeleccion evaluarEnTabla(const tablaDeComponentes& tabla, const indicesNumericos* indices, consultaCompuesta& consulta,
+                                  std::ostream& avisos){
+    const size_t n = tabla.size();
+    auto aceptadosDe = [&tabla](std::vector<std::vector<uint8_t>>& aceptados, const consultaCompuesta& c) {
+        aceptados.clear();
+        for (const predicadoDeConsulta& p : c.predicados) {
+            std::vector<uint8_t> codigos;
+            if (p.campo == campoDeBusqueda::tipo || p.campo == campoDeBusqueda::estado) {
+                const diccionarioDeCadenas& diccionario = p.campo == campoDeBusqueda::tipo ? tabla.diccionarioDeTipos : tabla.diccionarioDeEstados;
+                codigos.resize(diccionario.valores.size());
+                for (size_t codigo = 0; codigo < codigos.size(); codigo++) codigos[codigo] = cumpleTexto(diccionario.valores[codigo], p);
+            }
+            aceptados.push_back(std::move(codigos));
+        }
+    };
+    std::vector<std::vector<uint8_t>> aceptados;
+    aceptadosDe(aceptados, consulta);
+    estimarEnTabla(tabla, indices, aceptados, consulta);
+    ordenarPredicados(consulta);
+    aceptadosDe(aceptados, consulta);
+    mostrarPlan(consulta, avisos);
+
+    if (consulta.predicados.empty()) return mascaraDeSeleccion((n + 63) / 64, 0);
+    mascaraDeSeleccion mascara = mascaraDePredicado(tabla, indices, consulta.predicados[0], aceptados[0]);
+    if (consulta.predicados.size() == 1) return mascara;
+
+    const bool conjuncion = consulta.conector == conectorLogico::y;
+    for (size_t palabra = 0; palabra < mascara.size(); palabra++)
+    {
+        const size_t filasEnPalabra = std::min<size_t>(64, n - palabra * 64);
+        uint64_t pendientes = conjuncion ? mascara[palabra] : ~mascara[palabra];
+        if (filasEnPalabra < 64) pendientes &= (uint64_t{1} << filasEnPalabra) - 1;
+        for (; pendientes != 0; pendientes &= pendientes - 1)
+        {
+            const unsigned bit = primerBitActivo(pendientes);
+            const size_t fila = palabra * 64 + bit;
+            bool resultado = conjuncion;
+            for (size_t k = 1; k < consulta.predicados.size(); k++)
+            {
+                if (cumplePredicadoEnTabla(tabla, fila, consulta.predicados[k], aceptados[k]) != conjuncion) {
+                    resultado = !conjuncion;
+                    break;
+                }
+            }
+            if (resultado) mascara[palabra] |= uint64_t{1} << bit;
+            else mascara[palabra] &= ~(uint64_t{1} << bit);
+        }
+    }
+    return mascara;
+}
+
+/**
+ * @brief Evalúa una consulta compuesta recorriendo las filas una vez
+ * 
+ * @param registros Colección recorrible (ej: registroMapeado proyectado)
+ * @param consulta Consulta; sus predicados se estiman y reordenan
+ * @param emitir Función llamada con cada componente que cumple la consulta (y,
+ *               si la acepta, su posición en el recorrido); si devuelve false
+ *               el recorrido se detiene
+ * @param avisos Flujo donde se muestra el plan (mostrarPlan())
+ * @return uint64_t Número de coincidencias
+ * 
+ * @details Estima por muestreo (estimarPorMuestreo()) y evalúa cada fila en el
+ * orden resultante, deteniéndose en el primer predicado que decide el resultado.
+ */
+template<class Coleccion, class Funcion>
+uint64_t evaluarPorFilas(const Coleccion& registros, consultaCompuesta& consulta, Funcion emitir, std::ostream& avisos){
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    estimarPorMuestreo(registros, consulta);
+    ordenarPredicados(consulta);
+    mostrarPlan(consulta, avisos);
+
+    const bool conjuncion = consulta.conector == conectorLogico::y;
+    uint64_t encontrados = 0;
+    uint64_t recorridos = 0;
+    for (const auto& c : registros) {
+        recorridos++;
+        bool resultado = conjuncion;
+        for (const predicadoDeConsulta& p : consulta.predicados) {
+            if (cumplePredicado(c, p) != conjuncion) {
+                resultado = !conjuncion;
+                break;
+            }
+        }
+        if (resultado && !consulta.predicados.empty()) {
+            encontrados++;
+            bool seguir;
+            if constexpr (std::is_invocable_v<Funcion, decltype(c), uint64_t>) seguir = emitir(c, recorridos - 1);
+            else seguir = emitir(c);
+            if (!seguir) break;
+        }
+    }
+    contarEstadistica(contadorMedido::registrosRecorridos, recorridos);
+    return encontrados;
+}
+
+/**
+ * @brief Ejecuta una consulta compuesta sobre el último archivo buscado y muestra las coincidencias
+ * 
+ * @param cache Caché ya actualizada con el archivo (se ignora si 'proyectado' no es nullptr)
+ * @param proyectado Archivo proyectado cuando supera UMBRAL_MAPEO; nullptr si se usa la caché
+ * @param consulta Consulta a ejecutar
+ * @param salida Destino de las coincidencias (formato y paginación)
+ * @return uint64_t Número de coincidencias antes de detenerse
+ * 
+ * @details
+ * Con la caché, la consulta se evalúa sobre su tablaDeComponentes con
+ * evaluarEnTabla(), aprovechando los diccionarios de tipos y estados y los
+ * índices numéricos que ya se hayan construido; si la tabla no cubre todas
+ * las filas (diccionario lleno, ver tablaAlDia()), se recorren los registros
+ * de la caché con evaluarPorFilas(). Los archivos proyectados se recorren
+ * también con evaluarPorFilas(). Si la caché memoriza el archivo proyectado
+ * (ponerAlDiaConsultasProyectadas()), el recorrido guarda la ubicación de
+ * todas las coincidencias, y una consulta repetida solo interpreta esas.
+ * 
+ * @see interpretarConsulta()
+ */
+uint64_t ejecutarConsulta(cacheDeBusqueda& cache, const registroMapeado* proyectado, consultaCompuesta& consulta, salidaDeResultados& salida){
+    auto emitir = [&salida](const auto& c) { return salida.emitir(c); };
+    if (proyectado && cache.rutaProyectada.empty()) return evaluarPorFilas(*proyectado, consulta, emitir, salida.avisos());
+    if (proyectado) {
+        std::string clave(1, consulta.conector == conectorLogico::y ? 'y' : 'o');
+        for (const predicadoDeConsulta& p : consulta.predicados) clave.append(1, '\0').append(p.expresion);
+        auto memorizada = cache.consultasProyectadas.find(clave);
+        if (memorizada != cache.consultasProyectadas.end()) {
+            salida.avisos() << "El archivo no cambió: se reutilizan las " << memorizada->second.size()
+                            << " coincidencias de esta misma consulta.\n";
+            const char* fin = proyectado->datos() + proyectado->tamano();
+            for (uint64_t ubicacion : memorizada->second)
+            {
+                vistaComponente vista;
+                if (proyectado->esBinario()) {
+                    vista = proyectado->fila(ubicacion);
+                } else {
+                    escanerDeLineas escaner(proyectado->datos() + ubicacion, fin);
+                    if (!analizarSiguienteBloque(escaner, proyectado->datos(), vista, nullptr)) continue;
+                }
+                if (!salida.emitir(vista)) break;
+            }
+            return memorizada->second.size();
+        }
+        // Se recorre todo aunque 'salida' se detenga, para memorizar la consulta completa
+        std::vector<uint64_t> ubicaciones;
+        bool emitiendo = true;
+        const uint64_t encontrados = evaluarPorFilas(*proyectado, consulta, [&](const vistaComponente& c, uint64_t fila) {
+            ubicaciones.push_back(proyectado->esBinario() ? fila : static_cast<uint64_t>(c.nombreDelComponente.data() - proyectado->datos()));
+            if (emitiendo) emitiendo = salida.emitir(c);
+            return true;
+        }, salida.avisos());
+        cache.consultasProyectadas[clave] = std::move(ubicaciones);
+        return encontrados;
+    }
+
+    const tablaDeComponentes& tabla = tablaAlDia(cache, salida.avisos());
+    if (tabla.size() < cache.registros.size()) return evaluarPorFilas(cache.registros, consulta, emitir, salida.avisos());
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    mascaraDeSeleccion mascara = evaluarEnTabla(tabla, &cache.indices, consulta, salida.avisos());
+    contarEstadistica(contadorMedido::registrosRecorridos, cache.registros.size());
+    return recorrerSeleccion(mascara, [&cache, &salida](size_t fila) { return salida.emitir(cache.registros[fila]); });
+}
+
+/**
+ * @brief Solicita al usuario una consulta compuesta hasta que sea válida
+ * 
+ * @param consulta Salida: consulta interpretada
+ * @return false si el usuario deja la línea vacía
+ * 
+ * @par Ejemplo de flujo:
+ * @code{.sh}
+ * Escriba los criterios unidos por 'y' (todos) u 'o' (alguno).
+ * Operadores: ~ contiene, =, !=, <, <=, >, >=  (ej: tipo=Capacitor y estado=Nuevo y voltaje>=25)
+ * 'valor' admite prefijos y unidades (ej: valor>=1nF y valor<=100nF)
+ * > tipo=Capacitor y voltaje>=25
+ * @endcode
+ */
+bool solicitarConsultaCompuesta(consultaCompuesta& consulta){
+    std::cout << "Escriba los criterios unidos por 'y' (todos) u 'o' (alguno).\n";
+    std::cout << "Operadores: ~ contiene, =, !=, <, <=, >, >=  (ej: tipo=Capacitor y estado=Nuevo y voltaje>=25)\n";
+    std::cout << "'valor' admite prefijos y unidades (ej: valor>=1nF y valor<=100nF)\n";
+    std::string linea;
+    while (std::getline(std::cin, linea) && !linea.empty()) {
+        std::string motivo = interpretarConsulta(linea, consulta);
+        if (motivo.empty()) return true;
+        std::cout << "Consulta inválida: " << motivo << ". Intente de nuevo (línea vacía para cancelar):\n";
+    }
+    return false;
+}
+
+/**
+ * @brief Carga un archivo de componentes y ejecuta una búsqueda sobre él
+ * 
+ * @param cache Caché del último archivo buscado (se reutiliza si es el mismo)
+ * @param nombreArchivo Ruta del archivo (texto o binario)
+ * 
+ * @details
+ * 1. Proyecta el archivo con registroMapeado y muestra menuParametro()
+ * 2. Las búsquedas por tipo o estado en archivos de texto usan el índice
+ *    secundario (obtenerIndiceSecundario()) y las búsquedas por nombre el de
+ *    trigramas (obtenerIndiceDeTrigramas()); ambas solo leen los bloques candidatos
+ * 3. Si el archivo ocupa al menos UMBRAL_MAPEO bytes, la búsqueda se ejecuta
+ *    directamente sobre la proyección (modo sin copia)
+ * 4. En otro caso pone al día la caché con actualizarCacheDeBusqueda() (solo
+ *    la primera vez; lee el archivo únicamente si cambió desde la última
+ *    búsqueda) y despacha con buscarPorParametro(), reutilizando los índices
+ *    numéricos; las búsquedas por tipo o estado (archivos binarios) usan una
+ *    tablaDeComponentes con diccionarios, ampliada solo con las filas nuevas
+ *    (tablaAlDia())
+ * 5. La opción 7 combina varios criterios con ejecutarConsulta(), sobre la
+ *    caché o, en modo proyectado, recorriendo la proyección; en ese modo la
+ *    caché memoriza las coincidencias de cada consulta mientras el archivo no
+ *    cambie, así que repetirla no vuelve a recorrerlo
+ * 6. Ofrece repetir la búsqueda sobre el mismo archivo sin volver a cargarlo
+ * 
+ * @post En modo proyectado, de 'cache' solo cambian las consultas memorizadas
+ * 
+ * @see registroMapeado
+ * @see cacheDeBusqueda
+ */
+void buscarEnArchivo(cacheDeBusqueda& cache, const std::string& nombreArchivo){
+    registroMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) return;
+
+    const bool proyectado = mapa.tamano() >= UMBRAL_MAPEO;
+    bool cargado = false;
+    registroEnArena& registros = cache.registros;
+    int continuar = 1;
+    while (continuar == 1) {
+        int opcion;
+        menuParametro();
+        std::cin>>opcion;
+        std::cin.ignore();
+        if (opcion < 1 || opcion > 7) {
+            buscarPorParametro(opcion, registros);
+            return;
+        }
+
+        if (opcion == 7) {
+            consultaCompuesta consulta;
+            if (solicitarConsultaCompuesta(consulta)) {
+                if (!proyectado && !cargado) {
+                    actualizarCacheDeBusqueda(cache, nombreArchivo);
+                    cargado = true;
+                }
+                if (proyectado) ponerAlDiaConsultasProyectadas(cache, nombreArchivo);
+                salidaDeResultados salida;
+                if (ejecutarConsulta(cache, proyectado ? &mapa : nullptr, consulta, salida) == 0) {
+                    std::cout << "Ningún componente cumple la consulta.\n";
+                }
+            }
+        } else if (!mapa.esBinario() && opcion == 1) {
+            std::string texto = solicitarTexto("Ingrese el nombre del componente que desea encontrar \n");
+            indiceDeTrigramas trigramas;
+            if (!obtenerIndiceDeTrigramas(nombreArchivo, trigramas)) return;
+            salidaDeResultados salida;
+            auto mostrar = [&salida](const vistaComponente& c) { return salida.emitir(c); };
+            if (buscarConIndiceDeTrigramas(nombreArchivo, trigramas, texto, mostrar) == 0) {
+                std::cout << "No se encontró ningún componente con ese nombre.\n";
+                sugerirNombresParecidos(mapa, texto);
+            }
+        } else if (!mapa.esBinario() && (opcion == 2 || opcion == 6)) {
+            criterioDeBusqueda criterio;
+            criterio.campo = opcion == 2 ? campoDeBusqueda::tipo : campoDeBusqueda::estado;
+            criterio.texto = solicitarTexto(opcion == 2 ? "Ingrese el tipo del componente que desea encontrar \n"
+                                                        : "Ingrese el estado del componente que desea encontrar \n");
+            indiceSecundario indice;
+            if (!obtenerIndiceSecundario(nombreArchivo, indice)) return;
+            salidaDeResultados salida;
+            auto mostrar = [&salida](const vistaComponente& c) { return salida.emitir(c); };
+            if (buscarConIndiceSecundario(nombreArchivo, indice, criterio, mostrar) == 0) {
+                std::cout << (opcion == 2 ? "No se encontró ningún componente de ese tipo.\n"
+                                          : "No se encontró ningún componente en ese estado.\n");
+            }
+        } else if (proyectado) {
+            buscarPorParametro(opcion, mapa);
+        } else {
+            if (!cargado) {
+                actualizarCacheDeBusqueda(cache, nombreArchivo);
+                cargado = true;
+            }
+            if (opcion == 2 || opcion == 6) {
+                const tablaDeComponentes& tabla = tablaAlDia(cache);
+                const bool completa = tabla.size() == registros.size();
+                if (opcion == 2) completa ? buscarPorTipo(tabla) : buscarPorTipo(registros);
+                else completa ? buscarPorEstado(tabla) : buscarPorEstado(registros);
+            } else {
+                buscarPorParametro(opcion, registros, &cache.indices);
+            }
+        }
+
+        std::cout << "¿Deseas realizar otra búsqueda en este archivo? (1 = Sí, 2 = No): ";
+        std::cin >> continuar;
+        std::cin.ignore();
+    }
+}
+
+/**
+ * @brief Solicita y valida la selección del menú principal del usuario
+ * 
+ * @return int Opción válida seleccionada por el usuario (1-8)
+ * 
+ * @details
+ * Esta función implementa un bucle robusto de validación que:
+ * 1. Muestra el menú principal mediante mostrarMenu()
+ * 2. Solicita la entrada del usuario
+ * 3. Valida que la entrada sea un número entero
+ * 4. Verifica que esté en el rango válido (1-9)
+ * 5. Continúa solicitando hasta recibir una entrada válida
+ * 
+ * El proceso de validación incluye:
+ * - Manejo de errores de entrada con cin.fail()
+ * - Limpieza del buffer de entrada con cin.ignore()
+ * - Reinicio del estado de cin con cin.clear()
+ * - Verificación de rango numérico
+ * 
+ * @post Garantiza que el valor retornado es siempre una opción válida del menú
+ * @post No modifica ningún estado global del programa
+ * 
+ * @throw Nunca lanza excepciones (el manejo de errores es interno)
+ * 
+ * @note
+ * - Las opciones válidas corresponden a las mostradas por mostrarMenu()
+ * - El mensaje de error es informativo pero genérico
+ * - Usa 10000 como límite arbitrario para ignore() (suficiente para limpieza)
+ * 
+ * @par Ejemplo de flujo:
+ * @code
+ * int opcion = eleccionMenuprincipal();
+ * // Si usuario ingresa "a":
+ * // Muestra: "Entrada inválida. Por favor, ingresa un número del 1 al 9."
+ * // Si usuario ingresa "10":
+ * // Muestra: "Opción fuera de rango. Ingresa un número entre 1 y 9."
+ * // Cuando ingresa 3: retorna 3
+ * @endcode
+ * 
+ * @see mostrarMenu() Para el menú que se presenta al usuario
+ * @see std::cin.fail() Para el manejo de errores de entrada
+ * @see std::cin.ignore() Para la limpieza del buffer de entrada
+ */
+int eleccionMenuprincipal(){
+    int eleccion{0};
+    while (true) {
+        mostrarMenu();
+        std::cin >> eleccion;
+
+        if (std::cin.fail()) {
+            std::cin.clear(); // limpiar el estado de error
+            std::cin.ignore(10000, '\n'); // limpiar el búfer de entrada
+            std::cout << "Entrada inválida. Por favor, ingresa un número del 1 al 9.\n";
+            continue;
+        }
+
+        if (eleccion >= 1 && eleccion <= 9) break;
+        std::cout << "Opción fuera de rango. Ingresa un número entre 1 y 9.\n";
+        std::cin.ignore(10000, '\n');
+    }
+    return eleccion;
+}
+
+/**
+ * @brief Maneja el proceso completo de registro de componentes en archivos
+ * 
+ * @param registros Referencia al vector donde se almacenan temporalmente los componentes
+ * @param nombreArchivo Referencia al string que almacenará el nombre del archivo
+ * @param sobrescribir Flag que determina el modo de operación:
+ *                     - true: Sobrescribe archivos existentes
+ *                     - false: Añade a archivos existentes
+ * 
+ * @details
+ * Esta función coordina el flujo completo de registro de componentes:
+ * 1. Solicita el nombre del archivo (debe incluir .txt)
+ * 2. Valida la existencia del archivo según el modo:
+ *    - Modo sobrescritura: Pide confirmación si el archivo existe
+ *    - Modo continuación: Verifica que el archivo exista
+ * 3. Limpia el vector de registros temporal
+ * 4. Ciclo de registro de componentes:
+ *    - Usa registroDeComponentes() para capturar datos
+ *    - En modo nuevo, acumula la sesión y la guarda al final con guardarSesion()
+ *      (una escritura, reemplazo atómico); al continuar, usa un
+ *      escritorDeRegistro que mantiene el archivo abierto durante toda la sesión
+ *    - Permite registrar múltiples componentes
+ * 
+ * @post El archivo especificado contendrá los componentes registrados (en modo
+ *       sobrescritura, todos los de la sesión; el archivo no cambia hasta el final)
+ * @post El vector 'registros' contiene los componentes de la sesión
+ * @post Muestra mensajes de estado/error durante el proceso
+ * 
+ * @warning
+ * - En modo sobrescritura, los datos existentes se perderán sin confirmación
+ * - El nombre de archivo debe incluir la extensión .txt explícitamente
+ * 
+ * @throw Ninguno (los errores se manejan con mensajes y retornos tempranos)
+ * 
+ * @par Ejemplo 1 (Modo sobrescritura):
+ * @code
+ * vector<componente> reg;
+ * string archivo;
+ * iniciarRegistro(reg, archivo, true);
+ * // Si archivo existe: pregunta antes de sobrescribir
+ * // Si no existe: crea nuevo archivo
+ * @endcode
+ * 
+ * @par Ejemplo 2 (Modo continuación):
+ * @code
+ * vector<componente> reg;
+ * string archivo;
+ * iniciarRegistro(reg, archivo, false);
+ * // Si archivo no existe: muestra error y aborta
+ * // Si existe: añade nuevos componentes al final
+ * @endcode
+ * 
+ * @note
+ * - Usa funciones auxiliares para operaciones específicas
+ * - El ciclo continúa hasta que el usuario elija salir
+ * - Siempre limpia el vector antes de comenzar
+ * 
+ * @see registroDeComponentes() Para el ingreso de datos
+ * @see guardarSesion() Para guardado en modo sobrescritura
+ * @see escritorDeRegistro Para guardado en modo añadir
+ */
+void iniciarRegistro(std::vector<componente>& registros, std::string& nombreArchivo, bool sobrescribir) {
+    std::cin.ignore();
+    std::cout << "Ingresa el nombre del archivo (agrega .txt al final): \n";
+    std::getline(std::cin, nombreArchivo);
+
+    std::ifstream test(nombreArchivo);
+    if (sobrescribir && test.is_open()) {
+        int seleccion{0};
+        std::cout << "El archivo ya existe y será sobrescrito\n";
+        std::cout << "¿Continuar?\nSi(1) No(2)\n";
+        std::cin >> seleccion;
+        std::cin.ignore();
+        if (seleccion != 1) return;
+    }
+
+    if (!sobrescribir && !test.is_open()) {
+        std::cout << "El archivo no existe. No se puede continuar\n";
+        return;
+    }
+
+    if (!sobrescribir && esArchivoBinario(nombreArchivo)) {
+        std::cout << "El archivo está en formato binario. Conviértelo a texto (opción 6) para continuar el registro\n";
+        return;
+    }
+
+    registros.clear();
+    std::optional<escritorDeRegistro> escritor;
+    if (!sobrescribir) {
+        escritor.emplace(nombreArchivo, politicaDeDurabilidad::sinSincronizar, 1);
+        if (!escritor->abierto()) return;
+    }
+    int continuar = 1;
+    while (continuar == 1) {
+        registroDeComponentes(registros);
+        if (sobrescribir) {
+            std::cout << "Componente agregado a la sesión; se guardará al terminar.\n";
+        } else {
+            escritor->agregar(registros.back());
+            std::cout << "Componente guardado correctamente.\n";
+        }
+        std::cout << "¿Deseas ingresar otro componente? (1 = Sí, 2 = No): ";
+        std::cin >> continuar;
+        std::cin.ignore();
+    }
+    if (sobrescribir && !guardarSesion(registros, nombreArchivo)) return;
+    std::cout << "Archivo guardado correctamente.\n";
+}
+
+/**
+ * @struct componenteUbicado
+ * @brief Componente vigente de un registro junto con su ubicación en el archivo
+ */
+struct componenteUbicado
+{
+    uint64_t ubicacion{0}; ///< Texto: byte donde empieza su bloque. Binario: número de fila
+    componente datos;      ///< Copia de sus campos
+};
+
+/**
+ * @brief Localiza los componentes vigentes cuyo nombre es exactamente 'nombre'
+ * 
+ * @param nombreArchivo Ruta del registro (texto o binario)
+ * @param nombre Nombre completo del componente (comparación exacta)
+ * @return std::vector<componenteUbicado> Coincidencias en orden de archivo
+ * 
+ * @details
+ * Recorre el archivo con registroMapeado, que ya omite los componentes
+ * borrados, y guarda la ubicación que necesita editarComponentes().
+ */
+std::vector<componenteUbicado> localizarPorNombre(const std::string& nombreArchivo, const std::string& nombre){
+    std::vector<componenteUbicado> encontrados;
+    registroMapeado mapa(nombreArchivo);
+    uint64_t fila = 0;
+    for (const vistaComponente& vista : mapa) {
+        if (vista.nombreDelComponente == nombre) {
+            componenteUbicado& c = encontrados.emplace_back();
+            c.ubicacion = mapa.esBinario() ? fila : static_cast<uint64_t>(vista.nombreDelComponente.data() - mapa.datos());
+            c.datos.nombreDelComponente = vista.nombreDelComponente;
+            c.datos.tipoDeComponente = vista.tipoDeComponente;
+            c.datos.valorNominal = vista.valorNominal;
+            c.datos.tolerancia = vista.tolerancia;
+            c.datos.voltajeDeTrabajo = vista.voltajeDeTrabajo;
+            c.datos.estado = vista.estado;
+        }
+        fila++;
+    }
+    return encontrados;
+}
+
+/**
+ * @brief Fracción de bytes muertos a partir de la cual se compacta un registro de texto
+ * 
+ * Bytes muertos son los de los bloques anulados más los de las propias
+ * lápidas: todo lo que compactarRegistro() eliminaría.
+ */
+const double UMBRAL_DE_COMPACTACION = 0.25;
+
+/**
+ * @struct espacioDelRegistro
+ * @brief Bytes totales y bytes muertos de un registro de texto
+ */
+struct espacioDelRegistro
+{
+    uint64_t bytesTotales{0}; ///< Tamaño del archivo
+    uint64_t bytesMuertos{0}; ///< Bloques anulados y lápidas
+    uint64_t anulados{0};     ///< Componentes anulados
+
+    /// Fracción del archivo que ocupan los bytes muertos (0 si está vacío)
+    double fraccionMuerta() const { return bytesTotales == 0 ? 0.0 : static_cast<double>(bytesMuertos) / bytesTotales; }
+};
+
+/**
+ * @brief Mide cuánto del registro ocupan los componentes borrados y sus lápidas
+ * 
+ * @param nombreArchivo Ruta del registro de texto
+ * @return espacioDelRegistro Medida (vacía si no se pudo abrir)
+ * 
+ * @details Localiza las lápidas con leerLapidas() y mide cada bloque anulado
+ * interpretándolo en su desplazamiento; no recorre los bloques vigentes.
+ */
+espacioDelRegistro medirEspacioDelRegistro(const std::string& nombreArchivo){
+    espacioDelRegistro espacio;
+    archivoMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) return espacio;
+    espacio.bytesTotales = mapa.tamano();
+    const std::vector<uint64_t> anulados = leerLapidas(mapa.datos(), mapa.tamano(), &espacio.bytesMuertos);
+    for (uint64_t desplazamiento : anulados)
+    {
+        if (desplazamiento >= mapa.tamano()) continue;
+        escanerDeLineas escaner(mapa.datos() + desplazamiento, mapa.datos() + mapa.tamano());
+        vistaComponente vista;
+        if (analizarSiguienteBloque(escaner, mapa.datos(), vista, nullptr)
+            && vista.nombreDelComponente.data() == mapa.datos() + desplazamiento) {
+            espacio.bytesMuertos += escaner.posicion() - (mapa.datos() + desplazamiento);
+            espacio.anulados++;
+        }
+    }
+    return espacio;
+}
+
+/**
+ * @brief Reescribe un registro de texto solo con sus componentes vigentes
+ * 
+ * @param nombreArchivo Ruta del registro de texto
+ * @return true si el registro quedó compactado
+ * 
+ * @details
+ * Carga los componentes vigentes con cargarDesdeArchivoRapido() (que ya omite
+ * los anulados y las lápidas) y los guarda con guardarSesion(), que escribe un
+ * temporal y lo renombra sobre el registro: un lector ve el archivo anterior
+ * o el compactado, nunca uno a medias. El bloqueoDeRegistro se mantiene
+ * desde la carga hasta el rename(), para que ningún componente añadido por
+ * otro proceso entre medias se pierda. Como las ubicaciones de los bloques
+ * cambian, los índices ".idx" y ".tri" se descartan y se reconstruyen en la
+ * siguiente búsqueda que los use.
+ * 
+ * @warning Si el registro tiene bloques dañados no se compacta, porque
+ *          reescribirlo los eliminaría sin dejar rastro
+ * 
+ * @see compactarSiHaceFalta()
+ */
+bool compactarRegistro(const std::string& nombreArchivo){
+    bloqueoDeRegistro bloqueo(nombreArchivo);
+    if (esArchivoBinario(nombreArchivo)) {
+        std::cout << "Los registros binarios no tienen componentes borrados que compactar.\n";
+        return false;
+    }
+    const uint64_t tamanoPrevio = tamanoDeArchivo(nombreArchivo);
+    std::vector<componente> registros;
+    std::vector<errorDeCarga> errores;
+    if (!cargarDesdeArchivoRapido(registros, nombreArchivo, errores)) return false;
+    if (!errores.empty()) {
+        mostrarErroresDeCarga(errores);
+        std::cout << "El registro tiene bloques dañados; no se compacta para no perderlos.\n";
+        return false;
+    }
+    if (!guardarSesion(registros, nombreArchivo)) return false;
+    std::cout << "Registro compactado: " << registros.size() << " componentes, " << tamanoPrevio
+              << " -> " << tamanoDeArchivo(nombreArchivo) << " bytes.\n";
+    return true;
+}
+
+/**
+ * @brief Compacta el registro si sus bytes muertos alcanzan UMBRAL_DE_COMPACTACION
+ * 
+ * @param nombreArchivo Ruta del registro de texto
+ * 
+ * @details Se llama después de cada borrado o modificación, así que la
+ * compactación ocurre en el mismo hilo al cruzar el umbral y su costo se
+ * reparte entre muchas ediciones.
+ */
+void compactarSiHaceFalta(const std::string& nombreArchivo){
+    const espacioDelRegistro espacio = medirEspacioDelRegistro(nombreArchivo);
+    if (espacio.fraccionMuerta() < UMBRAL_DE_COMPACTACION) return;
+    std::cout << "El " << std::lround(espacio.fraccionMuerta() * 100) << "% del registro son componentes borrados; compactando...\n";
+    compactarRegistro(nombreArchivo);
+}
+
+/**
+ * @brief Reescribe un registro binario aplicando una edición sobre sus componentes
+ * 
+ * @param nombreArchivo Ruta del registro binario
+ * @param editar Función que recibe el std::vector<componente> completo y lo modifica
+ * @return true si el registro se reescribió
+ * 
+ * @details El formato columnar no admite añadir bloques, así que borrar o
+ * modificar en binario carga el archivo completo y lo vuelve a guardar con
+ * guardarEnBinario(), que lo reemplaza de forma atómica (temporal y rename()).
+ */
+template<class Funcion>
+bool editarRegistroBinario(const std::string& nombreArchivo, Funcion editar){
+    std::vector<componente> registros;
+    if (!cargarDesdeBinario(registros, nombreArchivo)) return false;
+    editar(registros);
+    return guardarEnBinario(registros, nombreArchivo);
+}
+
+/**
+ * @brief Comprueba que las ubicaciones siguen señalando a los mismos componentes vigentes
+ * 
+ * @param nombreArchivo Ruta del registro (texto o binario)
+ * @param ubicados Componentes tal como los devolvió localizarPorNombre()
+ * @return true si todos siguen en su ubicación, sin borrar y sin cambios
+ * 
+ * @details
+ * Entre localizar un componente y editarlo puede pasar tiempo (el menú espera
+ * al usuario) y otro proceso puede haberlo borrado o haber compactado el
+ * registro, con lo que el desplazamiento señalaría a otro bloque. Se llama con
+ * el bloqueoDeRegistro tomado, justo antes de escribir.
+ * 
+ * @pre El proceso tiene el bloqueoDeRegistro del registro
+ */
+bool siguenVigentes(const std::string& nombreArchivo, const std::vector<componenteUbicado>& ubicados){
+    registroMapeado mapa(nombreArchivo);
+    if (!mapa.abierto()) return false;
+    // Se comparan los bits: con != un valor NaN nunca seguiría vigente
+    auto mismosBits = [](float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; };
+    for (const componenteUbicado& c : ubicados)
+    {
+        vistaComponente vista;
+        if (mapa.esBinario()) {
+            if (c.ubicacion >= mapa.cabeceraDelArchivo().cantidad) return false;
+            vista = mapa.fila(c.ubicacion);
+        } else {
+            if (c.ubicacion >= mapa.tamano() || estaAnulado(&mapa.anulados(), c.ubicacion)) return false;
+            escanerDeLineas escaner(mapa.datos() + c.ubicacion, mapa.datos() + mapa.tamano());
+            if (!analizarSiguienteBloque(escaner, mapa.datos(), vista, nullptr)
+                || vista.nombreDelComponente.data() != mapa.datos() + c.ubicacion) {
+                return false;
+            }
+        }
+        if (vista.nombreDelComponente != c.datos.nombreDelComponente || vista.tipoDeComponente != c.datos.tipoDeComponente
+            || vista.estado != c.datos.estado || !mismosBits(vista.valorNominal, c.datos.valorNominal)
+            || !mismosBits(vista.tolerancia, c.datos.tolerancia) || !mismosBits(vista.voltajeDeTrabajo, c.datos.voltajeDeTrabajo)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Reemplaza o borra componentes de un registro
+ * 
+ * @param nombreArchivo Ruta del registro (texto o binario)
+ * @param originales Componentes a cambiar, tal como los devolvió localizarPorNombre()
+ * @param nuevos Versión nueva de cada uno, en el mismo orden; vacío para borrarlos
+ * @return true si la edición quedó escrita
+ * 
+ * @details
+ * Con el bloqueoDeRegistro tomado, comprueba con siguenVigentes() que nadie
+ * cambió esos componentes desde que se localizaron y después:
+ * - En texto añade, por cada uno, su versión nueva (si la hay) seguida de una
+ *   lápida para la anterior, todo en una sola escritura sincronizada con
+ *   fsync(); los componentes modificados pasan al final del registro
+ * - En binario reescribe el archivo con las filas cambiadas o sin ellas
+ * 
+ * Al terminar llama a compactarSiHaceFalta(). Todo se edita en una llamada
+ * porque la compactación cambia las ubicaciones.
+ * 
+ * @see escritorDeRegistro::anular()
+ */
+bool editarComponentes(const std::string& nombreArchivo, const std::vector<componenteUbicado>& originales, const std::vector<componente>& nuevos){
+    if (originales.empty()) return true;
+    const bool borrar = nuevos.empty();
+    bool escrito = false;
+    {
+        bloqueoDeRegistro bloqueo(nombreArchivo);
+        if (!siguenVigentes(nombreArchivo, originales)) {
+            std::cout << "El registro cambió desde que se buscaron los componentes; vuelve a buscarlos.\n";
+            return false;
+        }
+        if (esArchivoBinario(nombreArchivo)) {
+            return editarRegistroBinario(nombreArchivo, [&](std::vector<componente>& registros) {
+                std::vector<uint64_t> filas;
+                for (size_t i = 0; i < originales.size(); i++) {
+                    if (borrar) filas.push_back(originales[i].ubicacion);
+                    else registros[originales[i].ubicacion] = nuevos[i];
+                }
+                std::sort(filas.begin(), filas.end());
+                filas.erase(std::unique(filas.begin(), filas.end()), filas.end());
+                for (auto fila = filas.rbegin(); fila != filas.rend(); ++fila) registros.erase(registros.begin() + *fila);
+            });
+        }
+        escritorDeRegistro escritor(nombreArchivo, politicaDeDurabilidad::sincronizarPorLote);
+        if (!escritor.abierto()) return false;
+        for (size_t i = 0; i < originales.size(); i++)
+        {
+            if (!borrar) escritor.agregar(nuevos[i]);
+            escritor.anular(originales[i].ubicacion);
+        }
+        escrito = escritor.vaciar();
+    }
+    if (escrito) compactarSiHaceFalta(nombreArchivo);
+    return escrito;
+}
+
+/**
+ * @brief Asigna a un campo de un componente un valor escrito como texto
+ * 
+ * @param x Componente a modificar
+ * @param campo Campo a cambiar
+ * @param valor Nuevo valor (se valida como en importarComponentes())
+ * @return std::string Motivo del rechazo, o vacío si se asignó
+ */
+std::string asignarCampo(componente& x, campoDeBusqueda campo, std::string valor){
+    switch (campo) {
+    case campoDeBusqueda::nombre:
+    case campoDeBusqueda::tipo:
+    case campoDeBusqueda::estado: {
+        const char* error = validarTexto(valor);
+        if (error != nullptr) return error;
+        if (campo == campoDeBusqueda::nombre) x.nombreDelComponente = valor;
+        else if (campo == campoDeBusqueda::tipo) x.tipoDeComponente = valor;
+        else x.estado = valor;
+        return "";
+    }
+    case campoDeBusqueda::valorNominal:
+        return convertirValorNominal(valor, x.valorNominal) && std::isfinite(x.valorNominal) ? "" : "valor nominal inválido";
+    case campoDeBusqueda::tolerancia:
+        return convertirFlotante(valor, x.tolerancia) && std::isfinite(x.tolerancia) ? "" : "tolerancia inválida";
+    case campoDeBusqueda::voltaje:
+        return convertirFlotante(valor, x.voltajeDeTrabajo) && std::isfinite(x.voltajeDeTrabajo) ? "" : "voltaje inválido";
+    }
+    return "campo desconocido";
+}
+
+/**
+ * @brief Borra o modifica un componente elegido por su nombre (opción 7 del menú principal)
+ * 
+ * @details
+ * 1. Solicita el archivo y el nombre exacto del componente
+ * 2. Muestra las coincidencias numeradas (puede haber varias con el mismo nombre)
+ * 3. Permite elegir una y borrarla, o volver a capturar todos sus campos
+ *    con registroDeComponentes()
+ * 
+ * @see editarComponentes()
+ */
+void editarComponente(){
+    std::cin.ignore();
+    std::cout << "Ingresa el nombre del archivo (agrega .txt al final): \n";
+    std::string nombreArchivo;
+    std::getline(std::cin, nombreArchivo);
+    if (!std::filesystem::exists(nombreArchivo)) {
+        std::cout << "El archivo no existe.\n";
+        return;
+    }
+    const std::string nombre = solicitarTexto("Ingrese el nombre exacto del componente: ");
+    const std::vector<componenteUbicado> encontrados = localizarPorNombre(nombreArchivo, nombre);
+    if (encontrados.empty()) {
+        std::cout << "No se encontró ningún componente con ese nombre.\n";
+        return;
+    }
+    for (size_t i = 0; i < encontrados.size(); i++)
+    {
+        std::cout << "(" << i + 1 << ")\n";
+        mostrarComponente(encontrados[i].datos);
+    }
+
+    size_t eleccion = 1;
+    if (encontrados.size() > 1) {
+        std::cout << "¿Cuál de ellos? (1-" << encontrados.size() << "): ";
+        std::cin >> eleccion;
+        if (std::cin.fail()) {
+            std::cin.clear();
+            eleccion = 0;
+        }
+        std::cin.ignore(10000, '\n');
+        if (eleccion < 1 || eleccion > encontrados.size()) {
+            std::cout << "Entrada inválida, volviendo al menú principal...\n";
+            return;
+        }
+    }
+    const componenteUbicado& elegido = encontrados[eleccion - 1];
+
+    int accion{0};
+    std::cout << "(1)Eliminar (2)Modificar (3)Cancelar\n";
+    std::cin >> accion;
+    std::cin.ignore();
+    if (accion == 1) {
+        if (editarComponentes(nombreArchivo, {elegido}, {})) std::cout << "Componente eliminado.\n";
+    } else if (accion == 2) {
+        std::vector<componente> nuevo;
+        registroDeComponentes(nuevo);
+        if (editarComponentes(nombreArchivo, {elegido}, nuevo)) std::cout << "Componente modificado.\n";
+    } else {
+        std::cout << "Volviendo al menú principal...\n";
+    }
+}
+
+/**
+ * @brief Número de componentes que importarComponentes() acumula antes de escribir
+ */
+const size_t LOTE_DE_IMPORTACION = 16384;
+
+/**
+ * @brief Separa una línea CSV o TSV en campos
+ * 
+ * @param linea Línea sin el salto final
+ * @param separador ',' (CSV) o '\t' (TSV)
+ * @param campos Salida: campos de la línea
+ * @return false si una comilla queda sin cerrar o va seguida de algo que no es el separador
+ * 
+ * @details
+ * En CSV un campo puede ir entre comillas dobles para contener comas; dentro
+ * de él, "" representa una comilla. En TSV el tabulador siempre separa.
+ */
+bool separarCampos(std::string_view linea, char separador, std::vector<std::string>& campos){
+    campos.clear();
+    size_t i = 0;
+    while (true) {
+        std::string& campo = campos.emplace_back();
+        if (separador == ',' && i < linea.size() && linea[i] == '"') {
+            i++;
+            while (true) {
+                size_t comilla = linea.find('"', i);
+                if (comilla == std::string_view::npos) return false;
+                campo.append(linea.substr(i, comilla - i));
+                i = comilla + 1;
+                if (i < linea.size() && linea[i] == '"') {
+                    campo.push_back('"');
+                    i++;
+                    continue;
+                }
+                break;
+            }
+            if (i < linea.size() && linea[i] != separador) return false;
+        } else {
+            size_t fin = linea.find(separador, i);
+            if (fin == std::string_view::npos) fin = linea.size();
+            campo.assign(linea.substr(i, fin - i));
+            i = fin;
+        }
+        if (i >= linea.size()) return true;
+        i++; // separador
+    }
+}
+
+/**
+ * @brief Valida una fila importada y la convierte en componente
+ * 
+ * @param campos nombre, tipo, valor nominal, tolerancia, voltaje y estado
+ * @param x Salida: componente validado
+ * @return std::string Vacío si la fila es válida; en otro caso, el motivo del rechazo
+ * 
+ * @details
+ * Aplica las mismas reglas que registroDeComponentes(): los textos pasan por
+ * validarTexto() y los números deben empezar por un número válido, como con
+ * solicitarNumero(). Se usa convertirFlotante(), que también acepta "inf" y
+ * "nan"; como std::cin >> float no los acepta, se rechazan los valores que no
+ * son finitos. El valor nominal admite además prefijos SI y unidad ("10uF" se
+ * guarda como 1e-05; ver convertirValorNominal()).
+ */
+std::string validarFilaImportada(std::vector<std::string>& campos, componente& x){
+    static const char* const nombres[] = {"nombre", "tipo", "valor nominal", "tolerancia", "voltaje", "estado"};
+    if (campos.size() != 6) {
+        return "se esperaban 6 columnas y hay " + std::to_string(campos.size());
+    }
+    for (int i : {0, 1, 5})
+    {
+        if (const char* error = validarTexto(campos[i])) return std::string(nombres[i]) + ": " + error;
+    }
+    float numeros[3];
+    for (int i = 0; i < 3; i++)
+    {
+        if (!(i == 0 ? convertirValorNominal(campos[2], numeros[0]) : convertirFlotante(campos[2 + i], numeros[i]))
+            || !std::isfinite(numeros[i])) {
+            return std::string(nombres[2 + i]) + ": Debe ingresar un número válido.";
+        }
+    }
+    x.nombreDelComponente = std::move(campos[0]);
+    x.tipoDeComponente = std::move(campos[1]);
+    x.valorNominal = numeros[0];
+    x.tolerancia = numeros[1];
+    x.voltajeDeTrabajo = numeros[2];
+    x.estado = std::move(campos[5]);
+    return "";
+}
+
+/**
+ * @struct segmentoDeTipo
+ * @brief Archivo de un registro particionado que contiene los componentes de un tipo
+ */
+struct segmentoDeTipo
+{
+    std::string tipo;    ///< tipoDeComponente de todos sus componentes
+    std::string archivo; ///< Ruta del segmento (registro de texto normal)
+};
+
+const char CABECERA_DE_MANIFIESTO[] = "#registro particionado por tipo 1"; ///< Primera línea del manifiesto
+
+/**
+ * @brief Ruta del manifiesto de un registro particionado
+ * 
+ * @param directorio Directorio del registro
+ * @return std::string "<directorio>/manifiesto.tsv"
+ */
+std::string rutaDeManifiesto(const std::string& directorio){
+    return (std::filesystem::path(directorio) / "manifiesto.tsv").string();
+}
+
+/**
+ * @brief Indica si una ruta es un registro particionado (directorio con manifiesto)
+ */
+bool esRegistroParticionado(const std::string& nombre){
+    std::error_code error;
+    return std::filesystem::is_directory(nombre, error) && std::filesystem::is_regular_file(rutaDeManifiesto(nombre), error);
+}
+
+/**
+ * @brief Lee el manifiesto de un registro particionado
+ * 
+ * @param directorio Directorio del registro
+ * @param segmentos Salida: un segmento por tipo, en el orden en que se crearon
+ * @return false si el manifiesto no existe o su cabecera no es válida
+ * 
+ * @details
+ * El manifiesto es un archivo de texto: la línea CABECERA_DE_MANIFIESTO y
+ * después una línea "<archivo>\t<tipo>" por segmento, con el nombre del
+ * archivo relativo al directorio. Como el tipo puede tener cualquier carácter
+ * que acepte validarTexto(), el nombre del archivo no se deriva de él: se
+ * guarda aquí.
+ */
+bool leerManifiesto(const std::string& directorio, std::vector<segmentoDeTipo>& segmentos){
+    segmentos.clear();
+    std::ifstream manifiesto(rutaDeManifiesto(directorio));
+    std::string linea;
+    if (!std::getline(manifiesto, linea) || linea != CABECERA_DE_MANIFIESTO) return false;
+    while (std::getline(manifiesto, linea)) {
+        const size_t tabulador = linea.find('\t');
+        if (tabulador == std::string::npos) continue;
+        segmentos.push_back({linea.substr(tabulador + 1), (std::filesystem::path(directorio) / linea.substr(0, tabulador)).string()});
+    }
+    return true;
+}
+
+/**
+ * @brief Devuelve el segmento de un tipo, creándolo en el manifiesto si no existe
+ * 
+ * @param directorio Directorio del registro particionado
+ * @param tipo tipoDeComponente
+ * @param avisos Flujo para los mensajes de error
+ * @return std::string Ruta del segmento; vacía si no se pudo actualizar el manifiesto
+ * 
+ * @details
+ * El manifiesto se relee y se reescribe con el bloqueoDeRegistro del
+ * manifiesto tomado, con reemplazarArchivo() (temporal, fsync() y rename()), así que
+ * dos procesos que añaden a la vez el primer componente de un tipo obtienen
+ * el mismo segmento y un lector nunca ve un manifiesto a medias. El archivo
+ * se llama "<número>_<tipo>.txt", con el tipo reducido a letras y dígitos
+ * ASCII.
+ */
+std::string segmentoParaTipo(const std::string& directorio, const std::string& tipo, std::ostream& avisos = std::cout){
+    const std::string ruta = rutaDeManifiesto(directorio);
+    bloqueoDeRegistro bloqueo(ruta);
+    std::vector<segmentoDeTipo> segmentos;
+    if (!leerManifiesto(directorio, segmentos)) {
+        avisos << "El manifiesto de '" << directorio << "' no es válido.\n";
+        return "";
+    }
+    for (const segmentoDeTipo& segmento : segmentos)
+    {
+        if (segmento.tipo == tipo) return segmento.archivo;
+    }
+
+    std::string nombre = std::to_string(segmentos.size()) + "_";
+    for (char caracter : tipo) nombre += std::isalnum(static_cast<unsigned char>(caracter)) && static_cast<unsigned char>(caracter) < 0x80 ? caracter : '_';
+    nombre += ".txt";
+    std::string contenido;
+    {
+        std::ifstream anterior(ruta, std::ios::binary);
+        contenido.assign(std::istreambuf_iterator<char>(anterior), std::istreambuf_iterator<char>());
+    }
+    if (!contenido.empty() && contenido.back() != '\n') contenido += '\n';
+    contenido += nombre + "\t" + tipo + "\n";
+
+    if (!reemplazarArchivo(ruta, [&contenido](std::ostream& salida) { salida << contenido; })) {
+        avisos << "No se pudo escribir el manifiesto de '" << directorio << "'.\n";
+        return "";
+    }
+    return (std::filesystem::path(directorio) / nombre).string();
+}
+
+/**
+ * @brief Crea un registro particionado vacío
+ * 
+ * @param directorio Directorio a crear (puede existir si está vacío)
+ * @return true si quedó creado
+ */
+bool crearRegistroParticionado(const std::string& directorio){
+    std::error_code error;
+    if (esRegistroParticionado(directorio)) return true;
+    if (std::filesystem::exists(directorio, error) && !std::filesystem::is_empty(directorio, error)) {
+        std::cout << "'" << directorio << "' existe y no es un registro particionado.\n";
+        return false;
+    }
+    std::filesystem::create_directories(directorio, error);
+    std::ofstream manifiesto(rutaDeManifiesto(directorio), std::ios::trunc);
+    manifiesto << CABECERA_DE_MANIFIESTO << "\n";
+    if (error || !manifiesto.flush()) {
+        std::cout << "No se pudo crear el registro particionado '" << directorio << "'.\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @class escritorPorTipo
+ * @brief escritorDeRegistro que, en un registro particionado, envía cada componente al segmento de su tipo
+ * 
+ * @details
+ * Mantiene un escritorDeRegistro por segmento, abierto la primera vez que
+ * llega un componente de ese tipo (segmentoParaTipo()), con la misma
+ * política y tamaño de lote para todos. Si el destino es un registro de
+ * texto normal, todos los componentes van a ese archivo, así que quien añade
+ * componentes no necesita distinguir ambos casos.
+ * 
+ * @see importarComponentes()
+ */
+class escritorPorTipo
+{
+public:
+    escritorPorTipo(const std::string& destino, politicaDeDurabilidad politica = politicaDeDurabilidad::sinSincronizar,
+                    size_t registrosPorLote = 4096, std::ostream& avisos = std::cout);
+
+    bool abierto() const { return valido; } ///< true si el destino se pudo abrir
+    bool agregar(const componente& x);
+    bool vaciar();
+    uint64_t escritos() const; ///< Componentes ya volcados, sumando todos los segmentos
+
+private:
+    std::string destino;
+    politicaDeDurabilidad politica;
+    size_t registrosPorLote;
+    std::ostream* avisos; ///< Destino de los mensajes de error de todos los segmentos
+    bool particionado{false};
+    bool valido{false};
+    std::map<std::string, std::unique_ptr<escritorDeRegistro>> escritores; ///< Por tipo ("" en un registro normal)
+};
+
+escritorPorTipo::escritorPorTipo(const std::string& destino, politicaDeDurabilidad politica, size_t registrosPorLote, std::ostream& avisos)
+    : destino(destino), politica(politica), registrosPorLote(registrosPorLote), avisos(&avisos), particionado(esRegistroParticionado(destino)){
+    if (particionado) {
+        valido = true;
+        return;
+    }
+    auto escritor = std::make_unique<escritorDeRegistro>(destino, politica, registrosPorLote, avisos);
+    valido = escritor->abierto();
+    escritores.emplace("", std::move(escritor));
+}
+
+/**
+ * @brief Agrega un componente al escritor de su segmento
+ * 
+ * @return false si no se pudo crear o escribir el segmento
+ */
+bool escritorPorTipo::agregar(const componente& x){
+    if (!valido) return false;
+    const std::string& clave = particionado ? x.tipoDeComponente : std::string();
+    auto encontrado = escritores.find(clave);
+    if (encontrado == escritores.end()) {
+        const std::string segmento = segmentoParaTipo(destino, x.tipoDeComponente, *avisos);
+        if (segmento.empty()) return false;
+        auto escritor = std::make_unique<escritorDeRegistro>(segmento, politica, registrosPorLote, *avisos);
+        if (!escritor->abierto()) return false;
+        encontrado = escritores.emplace(clave, std::move(escritor)).first;
+    }
+    return encontrado->second->agregar(x);
+}
+
+/**
+ * @brief Vuelca lo pendiente de todos los segmentos
+ */
+bool escritorPorTipo::vaciar(){
+    bool correcto = valido;
+    for (auto& [tipo, escritor] : escritores) correcto = escritor->vaciar() && correcto;
+    return correcto;
+}
+
+uint64_t escritorPorTipo::escritos() const{
+    uint64_t total = 0;
+    for (const auto& [tipo, escritor] : escritores) total += escritor->escritos();
+    return total;
+}
+
+/**
+ * @brief Crea un registro particionado, opcionalmente con los componentes de un registro normal
+ * 
+ * @param directorio Directorio del registro particionado
+ * @param origen Registro de texto o binario a repartir; vacío para crearlo vacío
+ * @return true si todos los componentes quedaron escritos
+ * 
+ * @par Ejemplo de uso:
+ * @code{.sh}
+ * ./registroDeComponentes --particionar inventario.d inventario.txt
+ * ./registroDeComponentes --buscar inventario.d tipo Capacitor   # solo lee el segmento de Capacitor
+ * @endcode
+ */
+bool particionarRegistro(const std::string& directorio, const std::string& origen){
+    std::vector<componente> registros;
+    if (!origen.empty()) {
+        std::vector<errorDeCarga> errores;
+        const bool cargado = esArchivoBinario(origen) ? cargarDesdeBinario(registros, origen)
+                                                      : cargarDesdeArchivoParalelo(registros, origen, errores);
+        if (!cargado) return false;
+        mostrarErroresDeCarga(errores);
+    }
+    if (!crearRegistroParticionado(directorio)) return false;
+    escritorPorTipo escritor(directorio, politicaDeDurabilidad::sincronizarPorLote, LOTE_DE_IMPORTACION);
+    for (const componente& x : registros)
+    {
+        if (!escritor.agregar(x)) return false;
+    }
+    if (!escritor.vaciar()) return false;
+    std::vector<segmentoDeTipo> segmentos;
+    leerManifiesto(directorio, segmentos);
+    std::cout << "Registro particionado '" << directorio << "': " << escritor.escritos() << " componentes añadidos, "
+              << segmentos.size() << " segmentos.\n";
+    return true;
+}
+
+/**
+ * @brief Convierte un criterio de --buscar en una consulta de un solo predicado
+ * 
+ * @param campo Nombre del campo (ver interpretarCampo())
+ * @param valor Valor buscado
+ * @param consulta Salida: "campo~valor" en texto o "campo=valor" en números
+ * @return std::string Vacía si es válido; si no, el motivo
+ * 
+ * @details Es la única interpretación de --buscar: la usan la línea de
+ * comandos (buscarEnArchivoSinCargar()), el servidor y los registros
+ * particionados. Los textos se comparan por subcadena y los números por
+ * igualdad tolerante al redondeo, como cumpleCriterio(), salvo "valor" con
+ * prefijo o unidad ("10uF"), que compara el valor canónico
+ * (magnitudCanonica()) y solo coincide con componentes de esa unidad. El
+ * predicado se construye sin pasar por interpretarConsulta(), así que el
+ * valor puede contener las palabras "y" y "o".
+ */
+std::string consultaDeBusqueda(const std::string& campo, const std::string& valor, consultaCompuesta& consulta){
+    consulta = consultaCompuesta();
+    campoDeBusqueda interpretado;
+    if (!interpretarCampo(campo, interpretado)) return "campo desconocido '" + campo + "'";
+    const bool numerico = interpretado == campoDeBusqueda::valorNominal || interpretado == campoDeBusqueda::tolerancia
+        || interpretado == campoDeBusqueda::voltaje;
+    predicadoDeConsulta predicado;
+    std::string motivo = interpretarPredicado(campo + (numerico ? "=" : "~") + valor, predicado);
+    consulta.predicados.push_back(std::move(predicado));
+    return motivo;
+}
+
+/**
+ * @brief Ejecuta una consulta sobre un registro particionado leyendo solo los segmentos necesarios
+ * 
+ * @param directorio Directorio del registro particionado
+ * @param consulta Consulta a ejecutar
+ * @param salida Destino de las coincidencias (formato y paginación)
+ * @return uint64_t Número de coincidencias entregadas a 'salida'
+ * 
+ * @details
+ * 1. Poda: como todos los componentes de un segmento tienen el mismo tipo,
+ *    los predicados sobre el tipo se evalúan una vez por segmento con el
+ *    tipo del manifiesto. Con "y", un segmento cuyo tipo no los cumple no se
+ *    abre; con "o", uno cuyo tipo cumple alguno coincide entero. Los
+ *    predicados de tipo ya decididos se quitan del resto de la evaluación
+ * 2. Los segmentos que quedan se proyectan con registroMapeado y se recorren
+ *    en paralelo (un hilo por segmento, como máximo uno por núcleo) con
+ *    evaluarPorFilas(); cada hilo guarda vistas de sus coincidencias, sin
+ *    copiarlas, hasta las que 'salida' puede llegar a escribir
+ * 3. Las coincidencias se entregan a 'salida' en el orden del manifiesto, así
+ *    que el resultado y la paginación no dependen de los hilos
+ * 
+ * Cada segmento es un registro de texto normal: sus lápidas, su longitud
+ * confirmada y su bloqueo se respetan igual que en un registro sin particionar.
+ */
+uint64_t consultarParticionado(const std::string& directorio, const consultaCompuesta& consulta, salidaDeResultados& salida){
+    cronometroDeEtapa cronometro(etapaMedida::filtrado);
+    std::vector<segmentoDeTipo> segmentos;
+    if (!leerManifiesto(directorio, segmentos)) {
+        salida.avisos() << "El manifiesto de '" << directorio << "' no es válido.\n";
+        return 0;
+    }
+
+    struct tareaDeSegmento
+    {
+        std::string archivo;
+        consultaCompuesta restante; ///< La consulta sin los predicados de tipo
+        bool todos{false};          ///< El tipo del segmento ya decide que todos cumplen
+        std::unique_ptr<registroMapeado> mapa;
+        std::vector<vistaComponente> coincidencias;
+    };
+    const bool conjuncion = consulta.conector == conectorLogico::y;
+    std::vector<tareaDeSegmento> tareas;
+    std::string tiposLeidos;
+    for (const segmentoDeTipo& segmento : segmentos)
+    {
+        tareaDeSegmento tarea;
+        tarea.archivo = segmento.archivo;
+        tarea.restante.conector = consulta.conector;
+        bool descartado = false;
+        for (const predicadoDeConsulta& p : consulta.predicados)
+        {
+            if (p.campo != campoDeBusqueda::tipo) {
+                tarea.restante.predicados.push_back(p);
+                continue;
+            }
+            const bool cumple = cumpleTexto(segmento.tipo, p);
+            if (conjuncion && !cumple) descartado = true;
+            if (!conjuncion && cumple) tarea.todos = true;
+        }
+        if (conjuncion && tarea.restante.predicados.empty()) tarea.todos = true;
+        if (descartado || (!tarea.todos && tarea.restante.predicados.empty())) continue;
+        tiposLeidos += (tiposLeidos.empty() ? "" : ", ") + segmento.tipo;
+        tareas.push_back(std::move(tarea));
+    }
+    salida.avisos() << "Segmentos leídos: " << tareas.size() << " de " << segmentos.size()
+                    << (tareas.empty() ? "" : " (" + tiposLeidos + ")") << ".\n";
+
+    const uint64_t maximo = salida.restantes();
+    std::atomic<size_t> siguiente{0};
+    auto trabajar = [&]() {
+        std::ostringstream planDescartado;
+        for (size_t i = siguiente++; i < tareas.size(); i = siguiente++)
+        {
+            tareaDeSegmento& tarea = tareas[i];
+            tarea.mapa = std::make_unique<registroMapeado>(tarea.archivo);
+            if (!tarea.mapa->abierto() || maximo == 0) continue;
+            auto guardar = [&tarea, maximo](const vistaComponente& c) {
+                tarea.coincidencias.push_back(c);
+                return tarea.coincidencias.size() < maximo;
+            };
+            if (tarea.todos) {
+                uint64_t recorridos = 0;
+                for (const vistaComponente& c : *tarea.mapa) {
+                    recorridos++;
+                    if (!guardar(c)) break;
+                }
+                contarEstadistica(contadorMedido::registrosRecorridos, recorridos);
+            } else {
+                evaluarPorFilas(*tarea.mapa, tarea.restante, guardar, planDescartado);
+            }
+        }
+    };
+    const unsigned hilos = static_cast<unsigned>(std::min<size_t>(tareas.size(), std::max(1u, std::thread::hardware_concurrency())));
+    std::vector<std::thread> trabajadores;
+    for (unsigned i = 1; i < hilos; i++) trabajadores.emplace_back(trabajar);
+    trabajar();
+    for (auto& t : trabajadores) t.join();
+
+    uint64_t encontrados = 0;
+    for (const tareaDeSegmento& tarea : tareas)
+    {
+        for (const vistaComponente& c : tarea.coincidencias) {
+            encontrados++;
+            if (!salida.emitir(c)) return encontrados;
+        }
+    }
+    return encontrados;
+}
+
+/**
+ * @brief Importa componentes desde CSV o TSV sin ninguna pregunta por registro
+ * 
+ * @param origen Ruta del archivo CSV/TSV, o "-" para leer la entrada estándar
+ * @param destino Registro de texto al que se añaden los componentes (se crea si no existe)
+ * @return true si se pudieron abrir ambos archivos y escribir todos los lotes
+ * 
+ * @details
+ * Cada línea es un componente con las columnas de registroDeComponentes():
+ * nombre, tipo, valor nominal, tolerancia, voltaje y estado.
+ * 
+ * 1. El separador es el tabulador si el origen termina en ".tsv" o si la
+ *    primera línea contiene un tabulador; en otro caso, la coma
+ * 2. Si ninguna de las tres columnas numéricas de la primera línea es un
+ *    número, se toma como encabezado y se omite
+ * 3. Cada fila se valida con validarFilaImportada(); las inválidas se
+ *    rechazan indicando su número de línea y el motivo (se muestran las
+ *    primeras 20 y el total)
+ * 4. Los componentes válidos se escriben con un escritorPorTipo en lotes de
+ *    LOTE_DE_IMPORTACION, una sola escritura por lote; si el destino es un
+ *    registro particionado, cada uno va al segmento de su tipo
+ * 
+ * @post Los índices (".idx", ".tri") del destino que estuvieran al día
+ *       incluyen los componentes importados
+ * 
+ * @par Ejemplo de uso:
+ * @code{.sh}
+ * ./registroDeComponentes --importar catalogo.csv inventario.txt
+ * cut -f1-6 proveedor.tsv | ./registroDeComponentes --importar - inventario.txt
+ * @endcode
+ * 
+ * @see validarFilaImportada()
+ */
+bool importarComponentes(const std::string& origen, const std::string& destino){
+    if (esArchivoBinario(destino)) {
+        std::cout << "El archivo está en formato binario. Conviértelo a texto (opción 6) para continuar el registro\n";
+        return false;
+    }
+    std::ifstream archivoOrigen;
+    if (origen != "-") {
+        archivoOrigen.open(origen);
+        if (!archivoOrigen.is_open()) {
+            std::cout << "No se pudo abrir el archivo '" << origen << "'.\n";
+            return false;
+        }
+    }
+    std::istream& entrada = origen == "-" ? std::cin : archivoOrigen;
+    cronometroDeEtapa cronometro(etapaMedida::interpretacion); // Las escrituras de los lotes cuentan aparte
+    escritorPorTipo escritor(destino, politicaDeDurabilidad::sinSincronizar, LOTE_DE_IMPORTACION);
+    if (!escritor.abierto()) return false;
+
+    const bool extensionTsv = origen.size() >= 4 && origen.compare(origen.size() - 4, 4, ".tsv") == 0;
+    char separador = extensionTsv ? '\t' : ',';
+    std::string linea;
+    std::vector<std::string> campos;
+    uint64_t numeroDeLinea = 0;
+    uint64_t rechazados = 0;
+    uint64_t bytesDeOrigen = 0;
+    const uint64_t RECHAZOS_MOSTRADOS = 20;
+
+    componente x;
+    while (std::getline(entrada, linea)) {
+        numeroDeLinea++;
+        bytesDeOrigen += linea.size() + 1;
+        if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+        if (linea.find_first_not_of(" \t") == std::string::npos) continue;
+        if (numeroDeLinea == 1 && !extensionTsv && linea.find('\t') != std::string::npos) separador = '\t';
+
+        std::string motivo;
+        if (!separarCampos(linea, separador, campos)) {
+            motivo = "comillas sin cerrar o mal ubicadas";
+        } else {
+            if (numeroDeLinea == 1 && campos.size() == 6) {
+                float descartado;
+                if (!convertirFlotante(campos[2], descartado) && !convertirFlotante(campos[3], descartado)
+                    && !convertirFlotante(campos[4], descartado)) {
+                    std::cout << "Línea 1: encabezado omitido.\n";
+                    continue;
+                }
+            }
+            motivo = validarFilaImportada(campos, x);
+        }
+        if (!motivo.empty()) {
+            if (rechazados < RECHAZOS_MOSTRADOS) {
+                std::cout << "Línea " << numeroDeLinea << " rechazada: " << motivo << "\n";
+            }
+            rechazados++;
+            continue;
+        }
+
+        if (!escritor.agregar(x)) {
+            std::cout << "Se importaron " << escritor.escritos() << " componentes.\n";
+            return false;
+        }
+    }
+    if (!escritor.vaciar()) {
+        std::cout << "Se importaron " << escritor.escritos() << " componentes.\n";
+        return false;
+    }
+
+    contarEstadistica(contadorMedido::bytesLeidos, bytesDeOrigen);
+    contarEstadistica(contadorMedido::registrosInterpretados, escritor.escritos() + rechazados);
+    if (rechazados > RECHAZOS_MOSTRADOS) {
+        std::cout << "... y " << rechazados - RECHAZOS_MOSTRADOS << " filas rechazadas más.\n";
+    }
+    std::cout << "Importados " << escritor.escritos() << " componentes en '" << destino << "'; "
+              << rechazados << " filas rechazadas.\n";
+    return true;
+}
+
+/**
+ * @brief Genera un archivo de texto con componentes sintéticos para pruebas de rendimiento
+ * 
+ * @param nombreArchivo Ruta del archivo a crear (se reemplaza con reemplazarArchivo())
+ * @param cantidad Número de componentes a generar
+ * @return true si el archivo se escribió completo
+ * 
+ * @details
+ * Usa un generador pseudoaleatorio con semilla fija, por lo que la misma
+ * cantidad produce siempre el mismo archivo. Cada componente se escribe con
+ * escribirComponente(), en el mismo formato que produce el programa.
+ * 
+ * @see compararCargadores()
+ */
+bool generarArchivoDePrueba(const std::string& nombreArchivo, uint64_t cantidad){
+    static const char* const tipos[] = {"Resistor", "Capacitor", "Inductor", "Diodo", "Transistor", "LED"};
+    static const char* const estados[] = {"Nuevo", "Usado", "Dañado"};
+    bloqueoDeRegistro bloqueo(nombreArchivo);
+    const bool escrito = reemplazarArchivo(nombreArchivo, [cantidad](std::ostream& archivo) {
+        uint64_t semilla = 0x9E3779B97F4A7C15ull;
+        componente c;
+        for (uint64_t i = 0; i < cantidad; i++)
+        {
+            semilla = semilla * 6364136223846793005ull + 1442695040888963407ull;
+            uint32_t azar = static_cast<uint32_t>(semilla >> 32);
+            c.tipoDeComponente = tipos[azar % 6];
+            c.estado = estados[(azar >> 8) % 3];
+            c.valorNominal = static_cast<float>((azar >> 12) % 1000 + 1);
+            c.tolerancia = static_cast<float>((azar >> 4) % 20 + 1);
+            c.voltajeDeTrabajo = static_cast<float>((azar >> 20) % 100) / 2.0f;
+            c.nombreDelComponente = c.tipoDeComponente + " " + std::to_string(i);
+            escribirComponente(archivo, c);
+        }
+    });
+    if (!escrito) {
+        std::cout << "No se pudo abrir el archivo para guardar \n";
+        return false;
+    }
+    registrarLongitudConfirmada(nombreArchivo, tamanoDeArchivo(nombreArchivo));
+    descartarIndices(nombreArchivo);
+    return true;
+}
+
+/**
+ * @brief Genera un registro de texto con componentes de distribución parecida a un inventario real
+ * 
+ * @param nombreArchivo Ruta del archivo a crear (se reemplaza con reemplazarArchivo())
+ * @param cantidad Número de componentes a generar
+ * @param semilla Semilla del generador; la misma semilla y cantidad producen el mismo archivo
+ * @return true si el archivo se escribió completo
+ * 
+ * @details
+ * A diferencia de generarArchivoDePrueba(), cuyos campos son uniformes, aquí:
+ * - Los tipos siguen pesos desiguales: resistores 38%, capacitores 27%,
+ *   diodos 10%, transistores 9%, LED 7%, inductores 6% y circuitos
+ *   integrados 3%
+ * - Resistores, capacitores e inductores toman valores de la serie E12 en
+ *   unidades del SI (ohmios, faradios, henrios), con tolerancias y voltajes
+ *   de las series comerciales de su tipo
+ * - Los demás tipos salen de un pequeño catálogo de referencias reales, con
+ *   las primeras más frecuentes que las últimas
+ * - Los estados son Nuevo 70%, Usado 22% y Dañado 8%
+ * - El nombre combina la referencia o el valor con el número del
+ *   componente (ej: "R 4.7K #000123" o "C 100n #000124"), así que es único y tiene prefijos
+ *   compartidos, como en un inventario
+ * 
+ * @see medirRendimiento()
+ */
+bool generarRegistroRealista(const std::string& nombreArchivo, uint64_t cantidad, uint64_t semilla = 1){
+    struct referencia { const char* nombre; float valor; float voltaje; };
+    struct familia { const char* tipo; unsigned peso; std::vector<referencia> catalogo; };
+    static const familia familias[] = {
+        {"Resistor", 38, {}},
+        {"Capacitor", 27, {}},
+        {"Diodo", 10, {{"1N4148", 0.2f, 100}, {"1N4007", 1, 1000}, {"BAT54", 0.2f, 30}, {"SS14", 1, 40}, {"1N5819", 1, 40}}},
+        {"Transistor", 9, {{"BC547", 0.1f, 45}, {"2N2222", 0.8f, 40}, {"2N3904", 0.2f, 40}, {"IRLZ44N", 47, 55}, {"BD139", 1.5f, 80}}},
+        {"LED", 7, {{"LED rojo 5mm", 0.02f, 2}, {"LED verde 3mm", 0.02f, 3.2f}, {"LED blanco 5mm", 0.02f, 3.2f}, {"LED azul 3mm", 0.02f, 3.2f}}},
+        {"Inductor", 6, {}},
+        {"Circuito integrado", 3, {{"NE555", 0.2f, 16}, {"LM358", 0.04f, 32}, {"74HC595", 0.07f, 6}, {"ATmega328P", 0.2f, 5.5f}}},
+    };
+    static const float serieE12[] = {1.0f, 1.2f, 1.5f, 1.8f, 2.2f, 2.7f, 3.3f, 3.9f, 4.7f, 5.6f, 6.8f, 8.2f};
+
+    bloqueoDeRegistro bloqueo(nombreArchivo);
+    const bool escrito = reemplazarArchivo(nombreArchivo, [&](std::ostream& archivo) {
+        uint64_t estadoAzar = semilla * 0x9E3779B97F4A7C15ull + 0x632BE59BD9B4E019ull;
+        auto azar = [&estadoAzar](uint32_t n) {
+            estadoAzar = estadoAzar * 6364136223846793005ull + 1442695040888963407ull;
+            return static_cast<uint32_t>((estadoAzar >> 32) % n);
+        };
+        auto sesgado = [&azar](uint32_t n) { return std::min(azar(n), azar(n)); }; // Favorece los primeros
+        auto elegir = [&azar](std::initializer_list<float> opciones) { return *(opciones.begin() + azar(static_cast<uint32_t>(opciones.size()))); };
+
+        componente c;
+        char numero[32];
+        for (uint64_t i = 0; i < cantidad; i++)
+        {
+            uint32_t tirada = azar(100);
+            const familia* f = familias;
+            while (tirada >= f->peso) tirada -= (f++)->peso;
+            c.tipoDeComponente = f->tipo;
+            std::snprintf(numero, sizeof(numero), " #%06llu", static_cast<unsigned long long>(i));
+
+            if (!f->catalogo.empty()) {
+                const referencia& r = f->catalogo[sesgado(static_cast<uint32_t>(f->catalogo.size()))];
+                c.nombreDelComponente = std::string(r.nombre) + numero;
+                c.valorNominal = r.valor;
+                c.voltajeDeTrabajo = r.voltaje;
+                c.tolerancia = elegir({5, 10, 20});
+            } else {
+                struct prefijo { float escala; const char* simbolo; };
+                auto codigoDeValor = [](float valor, std::initializer_list<prefijo> prefijos) {
+                    const prefijo* elegido = prefijos.end() - 1;
+                    for (const prefijo& p : prefijos) {
+                        if (valor >= p.escala * 0.999f) {
+                            elegido = &p;
+                            break;
+                        }
+                    }
+                    char texto[32];
+                    std::snprintf(texto, sizeof(texto), "%g%s", valor / elegido->escala, elegido->simbolo);
+                    return std::string(texto);
+                };
+                float valor = serieE12[azar(12)];
+                if (f->tipo[0] == 'R') { // 1 ohmio a 8.2 megaohmios
+                    valor *= std::pow(10.0f, static_cast<float>(sesgado(7)));
+                    c.nombreDelComponente = "R " + codigoDeValor(valor, {{1e6f, "M"}, {1e3f, "K"}, {1, ""}});
+                    c.tolerancia = elegir({1, 1, 1, 5, 5, 0.1f});
+                    c.voltajeDeTrabajo = elegir({50, 150, 200});
+                } else if (f->tipo[0] == 'C') { // 1 pF a 820 uF
+                    valor *= 1e-12f * std::pow(10.0f, static_cast<float>(azar(9)));
+                    c.nombreDelComponente = "C " + codigoDeValor(valor, {{1e-6f, "u"}, {1e-9f, "n"}, {1e-12f, "p"}});
+                    c.tolerancia = elegir({5, 10, 10, 20});
+                    c.voltajeDeTrabajo = elegir({6.3f, 10, 16, 16, 25, 50, 50, 100});
+                } else { // 1 uH a 8.2 mH
+                    valor *= 1e-6f * std::pow(10.0f, static_cast<float>(azar(4)));
+                    c.nombreDelComponente = "L " + codigoDeValor(valor, {{1e-3f, "m"}, {1e-6f, "u"}});
+                    c.tolerancia = elegir({10, 20});
+                    c.voltajeDeTrabajo = elegir({25, 50});
+                }
+                c.valorNominal = valor;
+                c.nombreDelComponente += numero;
+            }
+            const uint32_t estado = azar(100);
+            c.estado = estado < 70 ? "Nuevo" : (estado < 92 ? "Usado" : "Dañado");
+            escribirComponente(archivo, c);
+        }
+    });
+    if (!escrito) {
+        std::cout << "No se pudo abrir el archivo para guardar \n";
+        return false;
+    }
+    registrarLongitudConfirmada(nombreArchivo, tamanoDeArchivo(nombreArchivo));
+    descartarIndices(nombreArchivo);
+    return true;
+}
+
+/**
+ * @brief Compara el cargador original con el parser rápido en registros por segundo
+ * 
+ * @param cantidad Número de componentes del archivo de prueba
+ * @param nombreArchivo Ruta del archivo de prueba (se genera de nuevo)
+ * 
+ * @details
+ * 1. Genera el archivo con generarArchivoDePrueba()
+ * 2. Mide cargarDesdeArchivo() (std::getline + std::stof)
+ * 3. Mide cargarDesdeArchivoRapido() (proyección + escáner SSE2 + std::from_chars)
+ * 4. Mide cargarDesdeArchivoParalelo() con todos los núcleos disponibles
+ * 5. Muestra registros por segundo de cada uno y la aceleración
+ * 6. Verifica que la carga paralela produzca los mismos registros en el mismo orden
+ * 
+ * Entre ambas mediciones se libera el vector para que las dos cargas partan
+ * de las mismas condiciones de memoria. La primera medición también calienta
+ * la caché de páginas del sistema, así que ninguna de las dos incluye lectura
+ * desde disco frío (salvo la primera).
+ * 
+ * @par Ejemplo de uso:
+ * @code{.sh}
+ * ./registroDeComponentes --comparar-cargadores 10000000 prueba.txt
  * @endcode
+ */
+void compararCargadores(uint64_t cantidad, const std::string& nombreArchivo){
+    std::cout << "Generando " << cantidad << " componentes en '" << nombreArchivo << "'...\n";
+    if (!generarArchivoDePrueba(nombreArchivo, cantidad)) return;
+
+    std::vector<componente> registros;
+    auto inicio = std::chrono::steady_clock::now();
+    try {
+        cargarDesdeArchivo(registros, nombreArchivo);
+    } catch (const std::exception& e) {
+        std::cout << "cargarDesdeArchivo falló: " << e.what() << "\n";
+        return;
+    }
+    double segundosOriginal = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    size_t cargadosOriginal = registros.size();
+    registros.clear();
+    registros.shrink_to_fit();
+
+    std::vector<errorDeCarga> errores;
+    inicio = std::chrono::steady_clock::now();
+    cargarDesdeArchivoRapido(registros, nombreArchivo, errores);
+    double segundosRapido = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::cout << "cargarDesdeArchivo:       " << cargadosOriginal << " registros en " << segundosOriginal
+              << " s (" << static_cast<uint64_t>(cargadosOriginal / segundosOriginal) << " registros/s)\n";
+    std::cout << "cargarDesdeArchivoRapido: " << registros.size() << " registros en " << segundosRapido
+              << " s (" << static_cast<uint64_t>(registros.size() / segundosRapido) << " registros/s)\n";
+    std::cout << "Aceleración: " << segundosOriginal / segundosRapido << "x\n";
+    if (cargadosOriginal != registros.size() || !errores.empty()) {
+        std::cout << "Advertencia: los cargadores no coinciden en el número de registros.\n";
+    }
+
+    std::vector<componente> paralelos;
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+    inicio = std::chrono::steady_clock::now();
+    cargarDesdeArchivoParalelo(paralelos, nombreArchivo, errores, hilos);
+    double segundosParalelo = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    std::cout << "cargarDesdeArchivoParalelo (" << hilos << " hilos): " << paralelos.size() << " registros en " << segundosParalelo
+              << " s (" << static_cast<uint64_t>(paralelos.size() / segundosParalelo) << " registros/s)\n";
+
+    bool mismoOrden = paralelos.size() == registros.size();
+    for (size_t i = 0; mismoOrden && i < paralelos.size(); i++)
+    {
+        const componente& a = paralelos[i];
+        const componente& b = registros[i];
+        mismoOrden = a.nombreDelComponente == b.nombreDelComponente && a.tipoDeComponente == b.tipoDeComponente
+            && a.valorNominal == b.valorNominal && a.tolerancia == b.tolerancia
+            && a.voltajeDeTrabajo == b.voltajeDeTrabajo && a.estado == b.estado;
+    }
+    std::cout << (mismoOrden ? "La carga paralela coincide con la secuencial.\n"
+                             : "Advertencia: la carga paralela no coincide con la secuencial.\n");
+}
+
+/**
+ * @brief Compara el filtrado escalar sobre std::vector<componente> con los núcleos columnares
  * 
- * @note
- * - Estados comunes: "Nuevo", "Usado", "Dañado", "Reparado"
- * - Considerar normalizar los estados (siempre misma capitalización)
- * - Para búsqueda exacta, ingresar el estado completo
+ * @param cantidad Número de componentes del archivo de prueba
+ * @param nombreArchivo Ruta del archivo de prueba (se genera de nuevo)
  * 
- * @see solicitarTexto() Para entrada validada
- * @see mostrarComponente() Para formato de visualización
- * @see buscarPorParametro() Para búsqueda parametrizada
+ * @details
+ * 1. Genera el archivo con generarArchivoDePrueba() y lo carga con cargarDesdeArchivoRapido()
+ * 2. Mide la conversión a tablaDeComponentes y de vuelta a std::vector<componente>
+ * 3. Para una consulta de cada modo (igual, rango, cercano) mide el
+ *    recorrido escalar por registros y seleccionarPorConsulta() sobre la
+ *    columna, y verifica que seleccionen las mismas filas
+ * 4. Compara la memoria de tipo y estado como std::string y como códigos, y
+ *    el filtro de tipo por subcadena con seleccionarPorCodigos()
+ * 
+ * Cada consulta se repite varias veces y se informa el mejor tiempo, en
+ * millones de registros por segundo.
+ * 
+ * @par Ejemplo de uso:
+ * @code{.sh}
+ * ./registroDeComponentes --comparar-filtros 10000000 prueba.txt
+ * @endcode
  */
-void buscarPorEstado(const std::vector<componente>& registros){
-    std::string estado=solicitarTexto("Ingrese el estado del componente que desea encontrar \n");
-    bool encontrado{false};
-    for (const auto& c : registros)
+void compararFiltros(uint64_t cantidad, const std::string& nombreArchivo){
+    std::cout << "Generando " << cantidad << " componentes en '" << nombreArchivo << "'...\n";
+    if (!generarArchivoDePrueba(nombreArchivo, cantidad)) return;
+    std::vector<componente> registros;
+    std::vector<errorDeCarga> errores;
+    cargarDesdeArchivoRapido(registros, nombreArchivo, errores);
+
+    auto inicio = std::chrono::steady_clock::now();
+    tablaDeComponentes tabla = tablaDesdeRegistros(registros);
+    double segundosATabla = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    if (tabla.size() < registros.size()) return; // Los filtros por columnas no verían todas las filas
+    inicio = std::chrono::steady_clock::now();
+    std::vector<componente> reconvertidos = registrosDesdeTabla(tabla);
+    double segundosARegistros = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    std::cout << "Conversión a tabla: " << segundosATabla << " s; de vuelta a registros: " << segundosARegistros << " s\n";
+    reconvertidos.clear();
+    reconvertidos.shrink_to_fit();
+
+#if defined(__AVX2__)
+    std::cout << "Núcleos: AVX2\n";
+#elif defined(__SSE2__)
+    std::cout << "Núcleos: SSE2\n";
+#else
+    std::cout << "Núcleos: escalares\n";
+#endif
+
+    struct caso { const char* descripcion; campoDeBusqueda campo; consultaNumerica consulta; };
+    const caso casos[] = {
+        {"valor nominal igual a 470", campoDeBusqueda::valorNominal, {modoNumerico::igual, 470.0f, 470.0f}},
+        {"voltaje entre 12 y 24", campoDeBusqueda::voltaje, {modoNumerico::rango, 12.0f, 24.0f}},
+        {"tolerancia más cercana a 7.3", campoDeBusqueda::tolerancia, {modoNumerico::cercano, 7.3f, 7.3f}},
+    };
+    const int repeticiones = 5;
+    for (const caso& c : casos)
     {
-        if (c.estado.find(estado)!=std::string::npos)
+        double mejorEscalar = std::numeric_limits<double>::infinity();
+        double mejorColumnar = mejorEscalar;
+        std::vector<size_t> filasEscalar;
+        mascaraDeSeleccion mascara;
+        for (int r = 0; r < repeticiones; r++)
         {
-            mostrarComponente(c);
-            encontrado = true;
+            filasEscalar.clear();
+            inicio = std::chrono::steady_clock::now();
+            float mejorDistancia = std::numeric_limits<float>::infinity();
+            if (c.consulta.modo == modoNumerico::cercano) {
+                for (const componente& x : registros) mejorDistancia = std::min(mejorDistancia, std::abs(valorDeCampo(x, c.campo) - c.consulta.minimo));
+            }
+            for (size_t i = 0; i < registros.size(); i++)
+            {
+                float valor = valorDeCampo(registros[i], c.campo);
+                bool coincide = c.consulta.modo == modoNumerico::igual ? sonAproximadamenteIguales(valor, c.consulta.minimo)
+                              : c.consulta.modo == modoNumerico::rango ? valor >= c.consulta.minimo && valor <= c.consulta.maximo
+                              : std::abs(valor - c.consulta.minimo) == mejorDistancia;
+                if (coincide) filasEscalar.push_back(i);
+            }
+            mejorEscalar = std::min(mejorEscalar, std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count());
+
+            inicio = std::chrono::steady_clock::now();
+            const std::vector<float>& columna = tabla.columna(c.campo);
+            mascara = seleccionarPorConsulta(columna.data(), columna.size(), c.consulta);
+            mejorColumnar = std::min(mejorColumnar, std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count());
+        }
+
+        std::vector<size_t> filasColumnar;
+        recorrerSeleccion(mascara, [&filasColumnar](size_t fila) { filasColumnar.push_back(fila); return true; });
+        std::cout << c.descripcion << ": " << filasColumnar.size() << " coincidencias\n";
+        std::cout << "  escalar:   " << static_cast<uint64_t>(registros.size() / mejorEscalar / 1e6) << " M registros/s\n";
+        std::cout << "  columnar:  " << static_cast<uint64_t>(registros.size() / mejorColumnar / 1e6) << " M registros/s ("
+                  << mejorEscalar / mejorColumnar << "x)\n";
+        if (filasColumnar != filasEscalar) {
+            std::cout << "Advertencia: el filtro columnar no coincide con el escalar.\n";
         }
     }
-    if (encontrado==false)
+
+    std::cout << "Memoria de tipo y estado: " << registros.size() * 2 * sizeof(std::string) / 1024 << " KiB como std::string, "
+              << (tabla.tipos.size() + tabla.estados.size()) * sizeof(uint16_t) / 1024 << " KiB como códigos ("
+              << tabla.diccionarioDeTipos.valores.size() << " tipos y " << tabla.diccionarioDeEstados.valores.size()
+              << " estados distintos)\n";
+    const std::string tipoBuscado = "Capacitor";
+    double mejorEscalar = std::numeric_limits<double>::infinity();
+    double mejorColumnar = mejorEscalar;
+    std::vector<size_t> filasEscalar;
+    mascaraDeSeleccion mascara;
+    for (int r = 0; r < repeticiones; r++)
     {
-        std::cout << "No se encontró ningún componente en ese estado.\n";
+        filasEscalar.clear();
+        inicio = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < registros.size(); i++)
+        {
+            if (registros[i].tipoDeComponente.find(tipoBuscado) != std::string::npos) filasEscalar.push_back(i);
+        }
+        mejorEscalar = std::min(mejorEscalar, std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count());
+
+        inicio = std::chrono::steady_clock::now();
+        mascara = seleccionarPorCodigos(tabla.tipos, codigosQueCumplen(tabla.diccionarioDeTipos, tipoBuscado));
+        mejorColumnar = std::min(mejorColumnar, std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count());
+    }
+    std::vector<size_t> filasColumnar;
+    recorrerSeleccion(mascara, [&filasColumnar](size_t fila) { filasColumnar.push_back(fila); return true; });
+    std::cout << "tipo que contiene \"" << tipoBuscado << "\": " << filasColumnar.size() << " coincidencias\n";
+    std::cout << "  escalar:     " << static_cast<uint64_t>(registros.size() / mejorEscalar / 1e6) << " M registros/s\n";
+    std::cout << "  diccionario: " << static_cast<uint64_t>(registros.size() / mejorColumnar / 1e6) << " M registros/s ("
+              << mejorEscalar / mejorColumnar << "x)\n";
+    if (filasColumnar != filasEscalar) {
+        std::cout << "Advertencia: el filtro por diccionario no coincide con el escalar.\n";
     }
 }
 
 /**
- * @brief Función de despacho para búsquedas de componentes por diferentes parámetros
+ * @brief Número de reservas y liberaciones de memoria dinámica del programa
  * 
- * @param opcion Entero que especifica el tipo de búsqueda a realizar (1-7)
- * @param registros Vector de componentes donde buscar (referencia constante)
+ * Los incrementa el operator new/delete global de abajo; compararAsignaciones()
+ * los lee antes y después de cada operación. Solo se cuentan con
+ * estadisticasActivas o midiendoReservas encendidos: así, en el uso normal
+ * (y en el servidor, donde todos los hilos reservan a la vez) cada reserva
+ * cuesta leer dos bool en lugar de un incremento atómico compartido.
+ */
+std::atomic<uint64_t> reservasDinamicas{0};
+std::atomic<uint64_t> liberacionesDinamicas{0}; ///< @see reservasDinamicas
+
+/**
+ * @brief Reemplazo del operator new global que cuenta las reservas
+ */
+void* operator new(std::size_t bytes){
+    void* memoria = std::malloc(bytes == 0 ? 1 : bytes);
+    if (memoria == nullptr) throw std::bad_alloc();
+    if (estadisticasActivas || midiendoReservas) reservasDinamicas.fetch_add(1, std::memory_order_relaxed);
+    return memoria;
+}
+
+/**
+ * @brief Reemplazo del operator delete global que cuenta las liberaciones
+ */
+void operator delete(void* memoria) noexcept{
+    if (memoria == nullptr) return;
+    if (estadisticasActivas || midiendoReservas) liberacionesDinamicas.fetch_add(1, std::memory_order_relaxed);
+    std::free(memoria);
+}
+
+/**
+ * @brief Variante con tamaño de operator delete; delega en la anterior
+ */
+void operator delete(void* memoria, std::size_t) noexcept{
+    operator delete(memoria);
+}
+
+#if defined(SISTEMA_POSIX)
+/**
+ * @brief Reemplazo del operator new alineado (lo usa std::pmr::new_delete_resource())
+ */
+void* operator new(std::size_t bytes, std::align_val_t alineacion){
+    const std::size_t alineado = static_cast<std::size_t>(alineacion);
+    void* memoria = std::aligned_alloc(alineado, ((bytes == 0 ? 1 : bytes) + alineado - 1) / alineado * alineado);
+    if (memoria == nullptr) throw std::bad_alloc();
+    if (estadisticasActivas || midiendoReservas) reservasDinamicas.fetch_add(1, std::memory_order_relaxed);
+    return memoria;
+}
+
+/**
+ * @brief Reemplazo del operator delete alineado
+ */
+void operator delete(void* memoria, std::align_val_t) noexcept{
+    operator delete(memoria);
+}
+
+/**
+ * @brief Variante con tamaño del operator delete alineado
+ */
+void operator delete(void* memoria, std::size_t, std::align_val_t) noexcept{
+    operator delete(memoria);
+}
+#endif
+
+/**
+ * @brief Compara las reservas de memoria de la carga en std::vector<componente> y en registroEnArena
+ * 
+ * @param cantidad Número de componentes del archivo de prueba
+ * @param nombreArchivo Ruta del archivo de prueba (se genera de nuevo)
  * 
  * @details
- * Esta función actúa como un router que dirige a las funciones específicas de búsqueda
- * según la opción seleccionada en el menú de parámetros:
+ * Genera el archivo con generarArchivoDePrueba() y, para cada forma de
+ * almacenamiento, cuenta las reservas y liberaciones (ver reservasDinamicas)
+ * y el tiempo de:
+ * 1. Cargar el archivo (cargarDesdeArchivoRapido() o registroEnArena::cargar())
+ * 2. Liberarlo (clear() + shrink_to_fit() o registroEnArena::liberar())
  * 
- * 1. Búsqueda por nombre (buscarPorNombre)
- * 2. Búsqueda por tipo (buscarPorTipo)
- * 3. Búsqueda por valor nominal (buscarPorValorNominal)
- * 4. Búsqueda por tolerancia (buscarPorTolerancia)
- * 5. Búsqueda por voltaje (buscarPorVoltaje)
- * 6. Búsqueda por estado (buscarPorEstado)
- * 7. Salir al menú principal
+ * @par Ejemplo de uso:
+ * @code{.sh}
+ * ./registroDeComponentes --comparar-asignaciones 1000000 prueba.txt
+ * @endcode
+ */
+void compararAsignaciones(uint64_t cantidad, const std::string& nombreArchivo){
+    std::cout << "Generando " << cantidad << " componentes en '" << nombreArchivo << "'...\n";
+    if (!generarArchivoDePrueba(nombreArchivo, cantidad)) return;
+
+    auto medir = [](const char* descripcion, auto operacion) {
+        uint64_t reservas = reservasDinamicas.load();
+        uint64_t liberaciones = liberacionesDinamicas.load();
+        auto inicio = std::chrono::steady_clock::now();
+        operacion();
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        std::cout << "  " << descripcion << reservasDinamicas.load() - reservas << " reservas, "
+                  << liberacionesDinamicas.load() - liberaciones << " liberaciones, " << segundos << " s\n";
+    };
+
+    midiendoReservas = true;
+    std::vector<errorDeCarga> errores;
+    errores.reserve(16);
+    std::vector<componente> registros;
+    std::cout << "std::vector<componente>:\n";
+    medir("carga:      ", [&]() { cargarDesdeArchivoRapido(registros, nombreArchivo, errores); });
+    size_t cargadosVector = registros.size();
+    medir("liberación: ", [&]() { registros.clear(); registros.shrink_to_fit(); });
+
+    registroEnArena arena;
+    std::cout << "registroEnArena:\n";
+    medir("carga:      ", [&]() { arena.cargar(nombreArchivo, errores); });
+    size_t cargadosArena = arena.size();
+    medir("liberación: ", [&]() { arena.liberar(); });
+    midiendoReservas = false;
+
+    if (cargadosVector != cargadosArena) {
+        std::cout << "Advertencia: las cargas no coinciden en el número de registros.\n";
+    }
+}
+
+/**
+ * @brief Compara el rendimiento de continuarConArchivo() y de escritorDeRegistro con cada política
  * 
- * @post Ejecuta la función de búsqueda correspondiente
- * @post Maneja opciones inválidas mostrando mensaje
- * @post No modifica el vector de componentes
+ * @param cantidad Número de componentes a escribir
+ * @param nombreArchivo Ruta del registro de prueba (se sobrescribe en cada medición)
  * 
- * @throw Ninguno (los errores se manejan internamente)
+ * @details
+ * Genera los componentes con generarArchivoDePrueba(), los carga y los añade
+ * a un registro vacío de cuatro formas, mostrando componentes por segundo:
+ * 1. continuarConArchivo() (abrir, escribir y cerrar por componente)
+ * 2. escritorDeRegistro sin sincronizar, en lotes de 4096
+ * 3. escritorDeRegistro con fsync() por lote
+ * 4. escritorDeRegistro con fsync() por componente
+ * 
+ * Las mediciones 1 y 4 usan como máximo 20000 y 2000 componentes,
+ * respectivamente, para que la prueba termine en un tiempo razonable.
  * 
  * @par Ejemplo de uso:
- * @code
- * vector<componente> inventario = {...};
- * int opcion = 3; // Buscar por valor nominal
- * buscarPorParametro(opcion, inventario);
+ * @code{.sh}
+ * ./registroDeComponentes --comparar-escritura 100000 prueba.txt
  * @endcode
+ */
+void compararEscritura(uint64_t cantidad, const std::string& nombreArchivo){
+    std::cout << "Generando " << cantidad << " componentes...\n";
+    if (!generarArchivoDePrueba(nombreArchivo, cantidad)) return;
+    std::vector<componente> registros;
+    std::vector<errorDeCarga> errores;
+    cargarDesdeArchivoRapido(registros, nombreArchivo, errores);
+
+    auto medir = [&](const char* descripcion, size_t limite, auto escribir) {
+        const size_t n = std::min(limite, registros.size());
+        std::error_code error;
+        std::filesystem::remove(nombreArchivo, error);
+        descartarIndices(nombreArchivo);
+        auto inicio = std::chrono::steady_clock::now();
+        escribir(n);
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        std::cout << descripcion << n << " componentes en " << segundos << " s ("
+                  << static_cast<uint64_t>(n / segundos) << " componentes/s)\n";
+    };
+
+    medir("continuarConArchivo:             ", 20000, [&](size_t n) {
+        for (size_t i = 0; i < n; i++) continuarConArchivo(registros[i], nombreArchivo);
+    });
+    const std::pair<const char*, politicaDeDurabilidad> politicas[] = {
+        {"escritor sin sincronizar:        ", politicaDeDurabilidad::sinSincronizar},
+        {"escritor con fsync por lote:     ", politicaDeDurabilidad::sincronizarPorLote},
+        {"escritor con fsync por registro: ", politicaDeDurabilidad::sincronizarPorRegistro},
+    };
+    for (const auto& [descripcion, politica] : politicas)
+    {
+        size_t limite = politica == politicaDeDurabilidad::sincronizarPorRegistro ? 2000 : registros.size();
+        medir(descripcion, limite, [&, politica = politica](size_t n) {
+            escritorDeRegistro escritor(nombreArchivo, politica);
+            for (size_t i = 0; i < n; i++) escritor.agregar(registros[i]);
+            escritor.vaciar();
+        });
+    }
+}
+
+/**
+ * @brief Mide carga, búsqueda y escritura a varias escalas y escribe los resultados en JSON por líneas
  * 
- * @note
- * - Debe usarse junto con menuParametro()
- * - Las opciones deben coincidir con las mostradas en el menú
- * - El caso default maneja entradas fuera de rango
+ * @param cantidades Tamaños de registro a medir
+ * @param directorio Directorio para los archivos generados (se borran al terminar cada tamaño)
+ * @param semilla Semilla de generarRegistroRealista()
  * 
- * @see menuParametro() Para el menú de opciones correspondiente
- * @see buscarPorNombre() Para detalles de búsqueda por nombre
- * @see buscarPorTipo() Para detalles de búsqueda por tipo
- * @see buscarPorValorNominal() Para detalles de búsqueda por valor
- * @see buscarPorTolerancia() Para detalles de búsqueda por tolerancia
- * @see buscarPorVoltaje() Para detalles de búsqueda por voltaje
- * @see buscarPorEstado() Para detalles de búsqueda por estado
+ * @details
+ * Para cada tamaño genera un registro con generarRegistroRealista() y mide:
+ * 1. Carga: cargarDesdeArchivo() (referencia), cargarDesdeArchivoRapido() y
+ *    cargarDesdeArchivoParalelo(), en registros por segundo
+ * 2. Búsqueda por cada campo, con valores tomados de componentes al azar del
+ *    propio registro (un nombre completo, un tipo, un valor...): latencia p50
+ *    y p99 de
+ *    - "registros": el recorrido de cumpleCriterio() sobre
+ *      std::vector<componente> que hacen las funciones buscarPor*()
+ *    - "tabla": evaluarEnTabla() sobre la tablaDeComponentes, sin índices
+ *    - "archivo": buscarEnArchivoSinCargar() sin índices auxiliares
+ *    El número de consultas baja con el tamaño para acotar la duración; se
+ *    informa en "muestras" (con pocas muestras el p99 es el máximo)
+ * 3. Escritura: continuarConArchivo() (hasta 20000 componentes) y
+ *    escritorDeRegistro sin sincronizar y con fsync por lote (hasta 1000000),
+ *    en registros por segundo
+ * 
+ * Cada medición es una línea JSON en la salida estándar, precedida por una
+ * línea "entorno" con el número de hilos, las extensiones vectoriales y el
+ * compilador, para poder comparar ejecuciones de distintas versiones. Una
+ * medición que no es un número finito (ej: registros por segundo de una etapa
+ * que tardó menos que la resolución del reloj) se escribe como null. El
+ * progreso se muestra en la salida de errores.
+ * 
+ * @par Ejemplo de uso:
+ * @code{.sh}
+ * ./registroDeComponentes --medir-rendimiento 10000,1000000 /tmp > rendimiento.jsonl
+ * @endcode
+ * 
+ * @par Ejemplo de línea:
+ * @code
+ * {"medicion":"busqueda","cantidad":1000000,"metodo":"tabla","campo":"tipo","muestras":100,"p50Microsegundos":812,"p99Microsegundos":1034,"coincidenciasMedias":270112}
+ * @endcode
  */
-void buscarPorParametro(const int& opcion, const std::vector<componente>& registros){
-    switch (opcion)
+void medirRendimiento(const std::vector<uint64_t>& cantidades, const std::string& directorio, uint64_t semilla = 1){
+    auto linea = [](std::initializer_list<std::pair<const char*, std::string>> campos) {
+        std::string texto = "{";
+        for (const auto& [clave, valor] : campos) {
+            if (texto.size() > 1) texto += ',';
+            texto += std::string("\"") + clave + "\":" + valor;
+        }
+        std::cout << texto << "}\n" << std::flush;
+    };
+    auto cadena = [](const std::string& texto) {
+        std::string escapado = "\"";
+        for (char caracter : texto) {
+            if (caracter == '"' || caracter == '\\') escapado += '\\';
+            escapado += caracter;
+        }
+        return escapado + "\"";
+    };
+    auto numero = [](double valor) {
+        if (!std::isfinite(valor)) return std::string("null"); // JSON no admite inf ni nan
+        std::ostringstream texto;
+        texto << valor;
+        return texto.str();
+    };
+    auto segundosDesde = [](std::chrono::steady_clock::time_point inicio) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    };
+
+#if defined(__AVX2__)
+    const char* vectorial = "avx2";
+#elif defined(__SSE2__)
+    const char* vectorial = "sse2";
+#else
+    const char* vectorial = "ninguna";
+#endif
+#if defined(__VERSION__)
+    const std::string compilador = __VERSION__;
+#else
+    const std::string compilador = "desconocido";
+#endif
+    linea({{"medicion", cadena("entorno")}, {"version", "1"}, {"hilos", std::to_string(std::max(1u, std::thread::hardware_concurrency()))},
+           {"vectorial", cadena(vectorial)}, {"compilador", cadena(compilador)}, {"semilla", std::to_string(semilla)},
+           {"fecha", std::to_string(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count())}});
+
+    std::ostream descarte(nullptr); // Recibe los planes y resultados que no se quieren ver
+    for (uint64_t cantidad : cantidades)
     {
-    case 1:
-        buscarPorNombre(registros);
-        break;
-    case 2:
-        buscarPorTipo(registros);
-        break;
-    case 3:
-        buscarPorValorNominal(registros);
-        break;
-    case 4:
-        buscarPorTolerancia(registros);
-        break;
-    case 5:
-        buscarPorVoltaje(registros);
-        break;
-    case 6:
-        buscarPorEstado(registros);
-        break;
-    case 7:
-        std::cout<<"Volviendo al menú principal...";
-    default:
-        std::cout<<"Entrada inválida, volviendo al menú principal...";
-        break;
+        const std::string cantidadTexto = std::to_string(cantidad);
+        const std::string nombreArchivo = (std::filesystem::path(directorio) / ("rendimiento_" + cantidadTexto + ".txt")).string();
+        std::cerr << "Generando " << cantidad << " componentes en '" << nombreArchivo << "'...\n";
+        if (!generarRegistroRealista(nombreArchivo, cantidad, semilla)) return;
+
+        // 1. Carga
+        std::vector<componente> registros;
+        std::vector<errorDeCarga> errores;
+        auto medirCarga = [&](const char* metodo, auto cargar) {
+            registros.clear();
+            registros.shrink_to_fit();
+            auto inicio = std::chrono::steady_clock::now();
+            cargar();
+            const double segundos = segundosDesde(inicio);
+            linea({{"medicion", cadena("carga")}, {"cantidad", cantidadTexto}, {"metodo", cadena(metodo)},
+                   {"segundos", numero(segundos)}, {"registrosPorSegundo", numero(registros.size() / segundos)},
+                   {"cargados", std::to_string(registros.size())}});
+        };
+        std::cerr << "Midiendo la carga...\n";
+        medirCarga("cargarDesdeArchivo", [&]() {
+            try {
+                cargarDesdeArchivo(registros, nombreArchivo);
+            } catch (const std::exception& e) {
+                std::cerr << "cargarDesdeArchivo falló: " << e.what() << "\n";
+            }
+        });
+        medirCarga("cargarDesdeArchivoRapido", [&]() { cargarDesdeArchivoRapido(registros, nombreArchivo, errores); });
+        medirCarga("cargarDesdeArchivoParalelo", [&]() { cargarDesdeArchivoParalelo(registros, nombreArchivo, errores); });
+        if (registros.empty()) continue;
+
+        // 2. Búsqueda
+        std::cerr << "Midiendo las búsquedas...\n";
+        const tablaDeComponentes tabla = tablaDesdeRegistros(registros);
+        const size_t muestrasEnMemoria = static_cast<size_t>(std::clamp<uint64_t>(100000000 / cantidad, 11, 101));
+        const size_t muestrasEnArchivo = static_cast<size_t>(std::clamp<uint64_t>(20000000 / cantidad, 3, 21));
+        static const char* const campos[] = {"nombre", "tipo", "valor", "tolerancia", "voltaje", "estado"};
+        uint64_t estadoAzar = semilla;
+        for (const char* campo : campos)
+        {
+            const std::string nombreCampo = campo;
+            std::vector<std::string> valores;
+            for (size_t i = 0; i < muestrasEnMemoria; i++)
+            {
+                estadoAzar = estadoAzar * 6364136223846793005ull + 1442695040888963407ull;
+                const componente& c = registros[(estadoAzar >> 33) % registros.size()];
+                if (nombreCampo == "nombre") valores.push_back(c.nombreDelComponente);
+                else if (nombreCampo == "tipo") valores.push_back(c.tipoDeComponente);
+                else if (nombreCampo == "estado") valores.push_back(c.estado);
+                else valores.push_back(numero(nombreCampo == "valor" ? c.valorNominal : nombreCampo == "tolerancia" ? c.tolerancia : c.voltajeDeTrabajo));
+            }
+            auto medirBusqueda = [&](const char* metodo, size_t muestras, auto buscar) {
+                std::vector<double> microsegundos;
+                uint64_t coincidencias = 0;
+                for (size_t i = 0; i < muestras; i++)
+                {
+                    auto inicio = std::chrono::steady_clock::now();
+                    coincidencias += buscar(valores[i]);
+                    microsegundos.push_back(segundosDesde(inicio) * 1e6);
+                }
+                std::sort(microsegundos.begin(), microsegundos.end());
+                auto percentil = [&microsegundos](double p) {
+                    size_t rango = static_cast<size_t>(std::ceil(p * static_cast<double>(microsegundos.size())));
+                    return microsegundos[std::clamp<size_t>(rango, 1, microsegundos.size()) - 1];
+                };
+                linea({{"medicion", cadena("busqueda")}, {"cantidad", cantidadTexto}, {"metodo", cadena(metodo)},
+                       {"campo", cadena(campo)}, {"muestras", std::to_string(muestras)},
+                       {"p50Microsegundos", numero(percentil(0.50))}, {"p99Microsegundos", numero(percentil(0.99))},
+                       {"coincidenciasMedias", numero(static_cast<double>(coincidencias) / static_cast<double>(muestras))}});
+            };
+            auto criterioDe = [&nombreCampo](const std::string& valor) {
+                criterioDeBusqueda criterio;
+                interpretarCampo(nombreCampo, criterio.campo);
+                criterio.texto = valor;
+                convertirFlotante(valor, criterio.valor);
+                return criterio;
+            };
+            medirBusqueda("registros", muestrasEnMemoria, [&](const std::string& valor) {
+                const criterioDeBusqueda criterio = criterioDe(valor);
+                uint64_t encontrados = 0;
+                for (const componente& c : registros) encontrados += cumpleCriterio(c, criterio);
+                return encontrados;
+            });
+            if (tabla.size() == registros.size()) {
+                medirBusqueda("tabla", muestrasEnMemoria, [&](const std::string& valor) {
+                    consultaCompuesta consulta;
+                    consultaDeBusqueda(nombreCampo, valor, consulta);
+                    mascaraDeSeleccion mascara = evaluarEnTabla(tabla, nullptr, consulta, descarte);
+                    return recorrerSeleccion(mascara, [](size_t) { return true; });
+                });
+            }
+            medirBusqueda("archivo", muestrasEnArchivo, [&](const std::string& valor) {
+                consultaCompuesta consulta;
+                consultaDeBusqueda(nombreCampo, valor, consulta);
+                salidaDeResultados salida(formatoDeSalida::tsv);
+                salida.redirigir(descarte, descarte);
+                return buscarEnArchivoSinCargar(nombreArchivo, consulta.predicados.front(), salida);
+            });
+        }
+
+        // 3. Escritura
+        std::cerr << "Midiendo la escritura...\n";
+        const std::string archivoDeEscritura = (std::filesystem::path(directorio) / ("rendimiento_escritura_" + cantidadTexto + ".txt")).string();
+        auto medirEscritura = [&](const char* metodo, size_t limite, auto escribir) {
+            const size_t n = std::min(limite, registros.size());
+            std::error_code error;
+            std::filesystem::remove(archivoDeEscritura, error);
+            auto inicio = std::chrono::steady_clock::now();
+            escribir(n);
+            const double segundos = segundosDesde(inicio);
+            linea({{"medicion", cadena("escritura")}, {"cantidad", cantidadTexto}, {"metodo", cadena(metodo)},
+                   {"escritos", std::to_string(n)}, {"segundos", numero(segundos)}, {"registrosPorSegundo", numero(n / segundos)}});
+        };
+        medirEscritura("continuarConArchivo", 20000, [&](size_t n) {
+            for (size_t i = 0; i < n; i++) continuarConArchivo(registros[i], archivoDeEscritura);
+        });
+        medirEscritura("escritorSinSincronizar", 1000000, [&](size_t n) {
+            escritorDeRegistro escritor(archivoDeEscritura, politicaDeDurabilidad::sinSincronizar);
+            for (size_t i = 0; i < n; i++) escritor.agregar(registros[i]);
+            escritor.vaciar();
+        });
+        medirEscritura("escritorConFsyncPorLote", 1000000, [&](size_t n) {
+            escritorDeRegistro escritor(archivoDeEscritura, politicaDeDurabilidad::sincronizarPorLote);
+            for (size_t i = 0; i < n; i++) escritor.agregar(registros[i]);
+            escritor.vaciar();
+        });
+
+        std::error_code error;
+        for (const std::string& archivo : {nombreArchivo, archivoDeEscritura})
+        {
+            std::filesystem::remove(archivo, error);
+            std::filesystem::remove(rutaDeBloqueo(archivo), error);
+            descartarIndices(archivo);
+        }
+    }
+}
+
+/**
+ * @brief Muestra las opciones de línea de comandos disponibles
+ */
+void mostrarAyuda(){
+    std::cout << "Uso: registroDeComponentes [opción]\n";
+    std::cout << "Sin opciones se inicia el menú interactivo.\n\n";
+    std::cout << "  --comparar-cargadores [cantidad] [archivo]\n";
+    std::cout << "      Genera un archivo de prueba (10000000 componentes por defecto) y compara\n";
+    std::cout << "      cargarDesdeArchivo, cargarDesdeArchivoRapido y cargarDesdeArchivoParalelo\n";
+    std::cout << "      en registros por segundo.\n";
+    std::cout << "  --comparar-filtros [cantidad] [archivo]\n";
+    std::cout << "      Compara los filtros numéricos escalares sobre registros con los núcleos\n";
+    std::cout << "      vectoriales sobre la tabla columnar, y el filtro de tipo por subcadena con\n";
+    std::cout << "      el filtro por diccionario (1000000 componentes por defecto).\n";
+    std::cout << "  --comparar-asignaciones [cantidad] [archivo]\n";
+    std::cout << "      Cuenta las reservas de memoria y el tiempo de cargar y liberar un archivo\n";
+    std::cout << "      en std::vector<componente> y en la arena (1000000 componentes por defecto).\n";
+    std::cout << "  --comparar-escritura [cantidad] [archivo]\n";
+    std::cout << "      Compara continuarConArchivo con el escritor por lotes sin fsync, con fsync\n";
+    std::cout << "      por lote y con fsync por registro (100000 componentes por defecto).\n";
+    std::cout << "  --generar <archivo> <cantidad> [semilla]\n";
+    std::cout << "      Crea un registro de prueba determinista con tipos, valores, tolerancias,\n";
+    std::cout << "      voltajes y estados distribuidos como en un inventario real.\n";
+    std::cout << "  --medir-rendimiento [cantidades] [directorio]\n";
+    std::cout << "      Mide carga, latencia p50/p99 de búsqueda por campo y escritura sobre\n";
+    std::cout << "      registros generados (10000,1000000,10000000 por defecto) y escribe una\n";
+    std::cout << "      línea JSON por medición en la salida estándar.\n";
+    std::cout << "  --importar <origen.csv|origen.tsv|-> <registro>\n";
+    std::cout << "      Añade al registro los componentes de un archivo CSV o TSV (o de la entrada\n";
+    std::cout << "      estándar con '-'), una fila por componente: nombre, tipo, valor nominal,\n";
+    std::cout << "      tolerancia, voltaje, estado. Las filas inválidas se informan por línea.\n";
+    std::cout << "  --agregar <registro> <nombre> <tipo> <valor> <tolerancia> <voltaje> <estado>\n";
+    std::cout << "      Añade un componente al final de un registro de texto.\n";
+    std::cout << "  --buscar <archivo|-> <campo> <valor>\n";
+    std::cout << "      Búsqueda única sin cargar el archivo en memoria; muestra cada coincidencia\n";
+    std::cout << "      en cuanto se lee. Campos: nombre, tipo, valor, tolerancia, voltaje, estado.\n";
+    std::cout << "      Con '-' lee el registro desde la entrada estándar. 'valor' admite prefijos\n";
+    std::cout << "      y unidades igual que en --consultar (ej: valor 10uF).\n";
+    std::cout << "  --consultar <archivo> <criterio> [y|o <criterio>]...\n";
+    std::cout << "      Muestra los componentes que cumplen todos ('y') o alguno ('o') de los\n";
+    std::cout << "      criterios, de la forma <campo><operador><valor> con los operadores ~\n";
+    std::cout << "      (contiene), =, !=, <, <=, >, >=. Ej: tipo=Capacitor y voltaje>=25\n";
+    std::cout << "      'valor' admite prefijos SI (p n u µ m k M G) y unidades (Ω F H V A), y\n";
+    std::cout << "      compara en la unidad base: tipo=Capacitor y valor>=1nF y valor<=100nF\n";
+    std::cout << "  Opciones de salida de --buscar y --consultar:\n";
+    std::cout << "      --formato humano|tsv|jsonl   Formato de cada resultado (humano por defecto);\n";
+    std::cout << "                                   con tsv y jsonl los mensajes van a stderr.\n";
+    std::cout << "      --limite N                   Muestra como máximo N resultados y detiene la búsqueda.\n";
+    std::cout << "      --desplazamiento N           Omite los primeros N resultados.\n";
+    std::cout << "  --parecidos <archivo|directorio> <texto> [distancia máxima]\n";
+    std::cout << "      Muestra los componentes cuyo nombre contiene un fragmento más parecido al\n";
+    std::cout << "      texto (menos ediciones de un byte, sin distinguir mayúsculas), ordenados\n";
+    std::cout << "      por distancia. Admite las opciones de salida; --limite fija cuántos se\n";
+    std::cout << "      muestran (10 por defecto). Ej: --parecidos inventario.txt \"Resitor 1k\"\n";
+    std::cout << "  --eliminar <registro> <nombre>\n";
+    std::cout << "      Borra los componentes cuyo nombre es exactamente <nombre>.\n";
+    std::cout << "  --modificar <registro> <nombre> <campo> <valor>\n";
+    std::cout << "      Cambia un campo de los componentes cuyo nombre es exactamente <nombre>.\n";
+    std::cout << "      En texto, los borrados y modificaciones se añaden al final del registro, que\n";
+    std::cout << "      se compacta solo cuando los componentes borrados ocupan el 25% del archivo.\n";
+    std::cout << "  --compactar <registro>\n";
+    std::cout << "      Reescribe un registro de texto sin sus componentes borrados.\n";
+    std::cout << "  --particionar <directorio> [registro]\n";
+    std::cout << "      Crea un registro particionado: un directorio con un segmento por tipo de\n";
+    std::cout << "      componente y un manifiesto, opcionalmente con los componentes de <registro>.\n";
+    std::cout << "      --importar, --agregar, --buscar y --consultar aceptan el directorio: los\n";
+    std::cout << "      componentes nuevos van al segmento de su tipo, las consultas que fijan el\n";
+    std::cout << "      tipo solo leen sus segmentos y las demás recorren los segmentos en paralelo.\n";
+    std::cout << "  --servidor <socket> [registro]...\n";
+    std::cout << "      Carga los registros una vez y responde peticiones por un socket de dominio\n";
+    std::cout << "      Unix hasta recibir --detener (o SIGINT/SIGTERM). Los registros no listados\n";
+    std::cout << "      se cargan la primera vez que se piden.\n";
+    std::cout << "  --cliente <socket> <petición> [argumentos]...\n";
+    std::cout << "      Envía una petición al servidor: --buscar, --consultar (con sus opciones de\n";
+    std::cout << "      salida), --agregar, --estado o --detener. Ej:\n";
+    std::cout << "      --cliente /tmp/rc.sock --consultar inventario.txt tipo=Diodo --formato tsv\n";
+    std::cout << "  --reindexar <archivo>\n";
+    std::cout << "      Reconstruye los índices de tipos y estados (<archivo>.idx) y de nombres\n";
+    std::cout << "      (<archivo>.tri) de un registro de texto.\n";
+    std::cout << "  --stats (o --estadisticas), en cualquier posición\n";
+    std::cout << "      Al terminar la operación muestra en stderr su tiempo real y de CPU, el\n";
+    std::cout << "      tiempo de cada etapa (lectura, interpretación, filtrado, presentación y\n";
+    std::cout << "      escritura), los bytes leídos y escritos, los registros interpretados,\n";
+    std::cout << "      recorridos y coincidentes, y las reservas de memoria. Con --servidor se\n";
+    std::cout << "      muestran por petición. Sin más opciones, las activa en el menú.\n";
+    std::cout << "  --ayuda\n";
+    std::cout << "      Muestra este mensaje.\n";
+}
+
+/**
+ * @struct opcionesDeSalida
+ * @brief Formato y paginación pedidos en la línea de comandos para --buscar y --consultar
+ */
+struct opcionesDeSalida
+{
+    formatoDeSalida formato{formatoDeSalida::humano}; ///< --formato humano|tsv|jsonl
+    uint64_t limite{salidaDeResultados::SIN_LIMITE}; ///< --limite N
+    uint64_t desplazamiento{0}; ///< --desplazamiento N
+};
+
+/**
+ * @brief Quita de los argumentos las opciones de salida y las interpreta
+ * 
+ * @param argumentos Argumentos del comando; las opciones pueden ir en cualquier posición
+ * @param opciones Salida: opciones encontradas (las demás conservan su valor por defecto)
+ * @return std::string Vacía si son válidas; si no, el motivo
+ */
+std::string extraerOpcionesDeSalida(std::vector<std::string>& argumentos, opcionesDeSalida& opciones){
+    std::vector<std::string> restantes;
+    for (size_t i = 0; i < argumentos.size(); i++)
+    {
+        const std::string& argumento = argumentos[i];
+        if (argumento != "--formato" && argumento != "--limite" && argumento != "--desplazamiento") {
+            restantes.push_back(argumento);
+            continue;
+        }
+        if (i + 1 == argumentos.size()) return "falta el valor de " + argumento;
+        const std::string& valor = argumentos[++i];
+        if (argumento == "--formato") {
+            if (valor == "humano") opciones.formato = formatoDeSalida::humano;
+            else if (valor == "tsv") opciones.formato = formatoDeSalida::tsv;
+            else if (valor == "jsonl") opciones.formato = formatoDeSalida::jsonl;
+            else return "formato desconocido '" + valor + "' (humano, tsv o jsonl)";
+            continue;
+        }
+        uint64_t numero = 0;
+        auto [fin, error] = std::from_chars(valor.data(), valor.data() + valor.size(), numero);
+        if (error != std::errc() || fin != valor.data() + valor.size()) return "número inválido para " + argumento + ": " + valor;
+        if (argumento == "--limite" && numero == 0) return "--limite debe ser al menos 1";
+        if (argumento == "--limite") opciones.limite = numero;
+        else opciones.desplazamiento = numero;
+    }
+    argumentos.swap(restantes);
+    return "";
+}
+
+/**
+ * @brief Muestra en avisos() el total de una búsqueda paginada
+ * 
+ * @param salida Salida ya usada por la búsqueda (se vacía antes del mensaje)
+ * @param desplazamiento Coincidencias que se pidió omitir
+ */
+void mostrarTotalDeResultados(salidaDeResultados& salida, uint64_t desplazamiento){
+    salida.vaciar();
+    std::ostream& avisos = salida.avisos();
+    if (salida.escritas() == 0) {
+        if (salida.coincidencias() == 0) avisos << "No se encontró ningún componente.\n";
+        else avisos << "Ninguna de las " << salida.coincidencias() << " coincidencias está después de la posición " << desplazamiento << ".\n";
+    } else if (salida.limiteAlcanzado()) {
+        avisos << salida.escritas() << " componentes mostrados desde la posición " << desplazamiento
+               << "; la búsqueda se detuvo al alcanzar el límite.\n";
+    } else if (desplazamiento > 0) {
+        avisos << salida.escritas() << " componentes mostrados de " << salida.coincidencias() << " encontrados.\n";
+    } else {
+        avisos << salida.escritas() << " componentes encontrados.\n";
+    }
+}
+
+/**
+ * @brief Añade al final de un registro de texto un componente dado por sus seis campos
+ * 
+ * @param nombreArchivo Registro de texto (se crea si no existe) o registro particionado
+ * @param campos nombre, tipo, valor nominal, tolerancia, voltaje y estado
+ * @param mensajes Flujo para el resultado o el motivo del rechazo
+ * @return int Código de salida (0 si quedó escrito)
+ * 
+ * @details Valida con validarFilaImportada() y escribe con un escritorPorTipo
+ * sincronizado que también informa sus errores en 'mensajes', de modo que al responder el componente ya está en el disco
+ * (en el segmento de su tipo, si el registro está particionado) y en los
+ * índices que estuvieran al día.
+ */
+int agregarComponente(const std::string& nombreArchivo, std::vector<std::string> campos, std::ostream& mensajes){
+    componente x;
+    const std::string motivo = validarFilaImportada(campos, x);
+    if (!motivo.empty()) {
+        mensajes << "Componente rechazado: " << motivo << "\n";
+        return 1;
+    }
+    if (esArchivoBinario(nombreArchivo)) {
+        mensajes << "El archivo está en formato binario. Conviértelo a texto (opción 6) para continuar el registro\n";
+        return 1;
+    }
+    escritorPorTipo escritor(nombreArchivo, politicaDeDurabilidad::sincronizarPorLote, 4096, mensajes);
+    if (!escritor.abierto() || !escritor.agregar(x) || !escritor.vaciar()) {
+        mensajes << "No se pudo escribir en el archivo '" << nombreArchivo << "'.\n";
+        return 1;
+    }
+    mensajes << "Componente añadido a '" << nombreArchivo << "'.\n";
+    return 0;
+}
+
+/**
+ * @enum tipoDeTrama
+ * @brief Primer byte de cada trama del protocolo entre --cliente y --servidor
+ * 
+ * @details
+ * Una trama es un byte de tipo, la longitud de la carga en 4 bytes
+ * little-endian y la carga. El cliente envía una trama 'peticion' con los
+ * argumentos de la línea de comandos separados por '\0'; el servidor responde
+ * con tramas 'salida' y 'errores' en el orden en que se produjeron, y termina
+ * con una trama 'fin' cuya carga es el código de salida (un byte). Una misma
+ * conexión admite varias peticiones seguidas.
+ * 
+ * @see codificarTrama()
+ * @see extraerTrama()
+ */
+enum class tipoDeTrama : char
+{
+    peticion = 'P', ///< Cliente a servidor: argumentos separados por '\0'
+    salida = 'O',   ///< Servidor a cliente: bytes para la salida estándar
+    errores = 'E',  ///< Servidor a cliente: bytes para la salida de errores
+    fin = 'F'       ///< Servidor a cliente: fin de la respuesta y código de salida
+};
+
+const uint32_t CARGA_MAXIMA_DE_PETICION = 1u << 20; ///< Las peticiones mayores cierran la conexión
+
+/**
+ * @brief Codifica una trama del protocolo de tipoDeTrama
+ * 
+ * @param tipo Tipo de la trama
+ * @param carga Contenido (como máximo 4 GiB)
+ * @return std::string Bytes listos para enviar
+ */
+std::string codificarTrama(tipoDeTrama tipo, std::string_view carga){
+    std::string trama;
+    trama.reserve(5 + carga.size());
+    trama += static_cast<char>(tipo);
+    const uint32_t longitud = static_cast<uint32_t>(carga.size());
+    for (int i = 0; i < 4; i++) trama += static_cast<char>((longitud >> (8 * i)) & 0xFF);
+    trama.append(carga);
+    return trama;
+}
+
+/**
+ * @brief Extrae la primera trama completa de los bytes recibidos
+ * 
+ * @param pendiente Bytes recibidos y aún no procesados; se le quita la trama extraída
+ * @param tipo Salida: tipo de la trama
+ * @param carga Salida: contenido de la trama
+ * @return true si había una trama completa
+ */
+bool extraerTrama(std::string& pendiente, tipoDeTrama& tipo, std::string& carga){
+    if (pendiente.size() < 5) return false;
+    uint32_t longitud = 0;
+    for (int i = 0; i < 4; i++) longitud |= static_cast<uint32_t>(static_cast<unsigned char>(pendiente[1 + i])) << (8 * i);
+    if (pendiente.size() - 5 < longitud) return false;
+    tipo = static_cast<tipoDeTrama>(pendiente[0]);
+    carga.assign(pendiente, 5, longitud);
+    pendiente.erase(0, 5 + static_cast<size_t>(longitud));
+    return true;
+}
+
+/**
+ * @struct respuestaGuardada
+ * @brief Respuesta de una consulta que el servidor puede repetir sin evaluarla
+ */
+struct respuestaGuardada
+{
+    std::string salidaEstandar; ///< Resultados (y avisos en formato humano)
+    std::string errores;        ///< Avisos en formatos TSV y JSON
+};
+
+const size_t RESPUESTAS_GUARDADAS_POR_REGISTRO = 256; ///< Al superarse se olvidan todas
+const size_t TAMANO_MAXIMO_DE_RESPUESTA_GUARDADA = 64 * 1024; ///< Las mayores no se guardan
+
+/**
+ * @struct registroResidente
+ * @brief Un registro que el servidor mantiene en memoria
+ * 
+ * @details
+ * La cacheDeBusqueda (componentes en la arena, tabla columnar e índices
+ * numéricos) se pone al día en cada petición con actualizarCacheDeBusqueda():
+ * si el archivo no cambió no se lee, y si otro proceso le añadió componentes
+ * solo se interpreta lo nuevo. Mientras las filas no cambien, las respuestas
+ * a consultas ya hechas se repiten desde 'respuestas', indexadas por los
+ * argumentos exactos de la petición.
+ */
+struct registroResidente
+{
+    cacheDeBusqueda cache; ///< Componentes y estructuras derivadas
+    std::unordered_map<std::string, respuestaGuardada> respuestas; ///< Consultas ya respondidas
+};
+
+/**
+ * @struct servidorDeConsultas
+ * @brief Estado de ejecutarServidor(): los registros residentes y sus estadísticas
+ */
+struct servidorDeConsultas
+{
+    std::map<std::string, registroResidente> registros; ///< Registros residentes, por ruta
+    uint64_t peticiones{0}; ///< Peticiones atendidas
+    double segundosAtendiendo{0}; ///< Tiempo total dentro de atenderPeticion()
+    bool detener{false}; ///< Se pidió --detener
+};
+
+/**
+ * @brief Pone al día un registro residente, cargándolo la primera vez
+ * 
+ * @param servidor Estado del servidor
+ * @param nombreArchivo Ruta del registro
+ * @param avisos Flujo para los mensajes de carga
+ * @return registroResidente* El registro, o nullptr si no se pudo abrir
+ * 
+ * @post Si las filas cambiaron, el registro no tiene respuestas guardadas
+ * @post Su tabla y su indiceCanonico están al día: el servidor paga la
+ *       ordenación una vez y las consultas con unidades no recorren la tabla
+ */
+registroResidente* ponerAlDiaResidente(servidorDeConsultas& servidor, const std::string& nombreArchivo, std::ostream& avisos){
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(nombreArchivo, error)) {
+        avisos << "No se pudo abrir el archivo '" << nombreArchivo << "'.\n";
+        servidor.registros.erase(nombreArchivo);
+        return nullptr;
     }
+    registroResidente& residente = servidor.registros[nombreArchivo];
+    if (actualizarCacheDeBusqueda(residente.cache, nombreArchivo, avisos)) residente.respuestas.clear();
+    const tablaDeComponentes& tabla = tablaAlDia(residente.cache, avisos);
+    if (tabla.size() == residente.cache.registros.size()) indiceCanonicoDe(residente.cache.indices, tabla);
+    return &residente;
 }
 
 /**
- * @brief Solicita y valida la selección del menú principal del usuario
+ * @brief Atiende una petición del cliente sobre los registros residentes
  * 
- * @return int Opción válida seleccionada por el usuario (1-6)
+ * @param servidor Estado del servidor
+ * @param argumentos Argumentos de la petición, como en la línea de comandos
+ * @param salidaEstandar Recibe lo que el cliente escribirá en su salida estándar
+ * @param errores Recibe lo que el cliente escribirá en su salida de errores
+ * @return int Código de salida para el cliente
  * 
  * @details
- * Esta función implementa un bucle robusto de validación que:
- * 1. Muestra el menú principal mediante mostrarMenu()
- * 2. Solicita la entrada del usuario
- * 3. Valida que la entrada sea un número entero
- * 4. Verifica que esté en el rango válido (1-6)
- * 5. Continúa solicitando hasta recibir una entrada válida
- * 
- * El proceso de validación incluye:
- * - Manejo de errores de entrada con cin.fail()
- * - Limpieza del buffer de entrada con cin.ignore()
- * - Reinicio del estado de cin con cin.clear()
- * - Verificación de rango numérico
- * 
- * @post Garantiza que el valor retornado es siempre una opción válida del menú
- * @post No modifica ningún estado global del programa
- * 
- * @throw Nunca lanza excepciones (el manejo de errores es interno)
- * 
- * @note
- * - Las opciones válidas corresponden a las mostradas por mostrarMenu()
- * - El mensaje de error es informativo pero genérico
- * - Usa 10000 como límite arbitrario para ignore() (suficiente para limpieza)
- * 
- * @par Ejemplo de flujo:
- * @code
- * int opcion = eleccionMenuprincipal();
- * // Si usuario ingresa "a":
- * // Muestra: "Entrada inválida. Por favor, ingresa un número del 1 al 6."
- * // Si usuario ingresa "7":
- * // Muestra: "Opción fuera de rango. Ingresa un número entre 1 y 6."
- * // Cuando ingresa 3: retorna 3
- * @endcode
- * 
- * @see mostrarMenu() Para el menú que se presenta al usuario
- * @see std::cin.fail() Para el manejo de errores de entrada
- * @see std::cin.ignore() Para la limpieza del buffer de entrada
+ * Peticiones admitidas:
+ * - --buscar y --consultar, con las mismas opciones de salida que en la línea
+ *   de comandos. Se evalúan sobre la tabla columnar residente con
+ *   ejecutarConsulta(); --buscar <campo> <valor> se convierte con
+ *   consultaDeBusqueda(). Los registros particionados no se mantienen en
+ *   memoria: se consultan con consultarParticionado()
+ * - --agregar, con agregarComponente(); la siguiente consulta lee solo el
+ *   componente nuevo
+ * - --estado: registros residentes, peticiones atendidas y tiempo medio
+ * - --detener: termina el servidor tras responder
+ * 
+ * La comprobación de que el archivo no cambió (actualizarCacheDeBusqueda())
+ * se hace siempre, también cuando la respuesta está guardada.
+ * 
+ * @note La respuesta se acumula completa en memoria antes de enviarse; para
+ *       consultas con muchos resultados conviene usar --limite
  */
-int eleccionMenuprincipal(){
-    int eleccion{0};
-    while (true) {
-        mostrarMenu();
-        std::cin >> eleccion;
+int atenderPeticion(servidorDeConsultas& servidor, std::vector<std::string> argumentos, std::ostringstream& salidaEstandar, std::ostringstream& errores){
+    if (argumentos.empty()) {
+        errores << "Petición vacía.\n";
+        return 1;
+    }
+    const std::string comando = argumentos[0];
+    if (comando == "--estado") {
+        salidaEstandar << servidor.registros.size() << " registros residentes:\n";
+        for (const auto& [ruta, residente] : servidor.registros) {
+            salidaEstandar << "  " << ruta << ": " << residente.cache.registros.size() << " componentes, "
+                           << residente.respuestas.size() << " respuestas guardadas\n";
+        }
+        salidaEstandar << servidor.peticiones << " peticiones atendidas";
+        if (servidor.peticiones > 0) {
+            salidaEstandar << ", " << servidor.segundosAtendiendo * 1e6 / static_cast<double>(servidor.peticiones) << " µs de media";
+        }
+        salidaEstandar << ".\n";
+        return 0;
+    }
+    if (comando == "--detener") {
+        servidor.detener = true;
+        salidaEstandar << "Servidor detenido.\n";
+        return 0;
+    }
+    if (comando == "--agregar") {
+        if (argumentos.size() != 8) {
+            errores << "Uso: --agregar <registro> <nombre> <tipo> <valor> <tolerancia> <voltaje> <estado>\n";
+            return 1;
+        }
+        return agregarComponente(argumentos[1], std::vector<std::string>(argumentos.begin() + 2, argumentos.end()), salidaEstandar);
+    }
+    if (comando != "--buscar" && comando != "--consultar") {
+        errores << "Petición desconocida: " << comando << " (--buscar, --consultar, --agregar, --estado o --detener)\n";
+        return 1;
+    }
 
-        if (std::cin.fail()) {
-            std::cin.clear(); // limpiar el estado de error
-            std::cin.ignore(10000, '\n'); // limpiar el búfer de entrada
-            std::cout << "Entrada inválida. Por favor, ingresa un número del 1 al 6.\n";
-            continue;
+    std::string clave;
+    for (const std::string& argumento : argumentos) clave.append(argumento).push_back('\0');
+    opcionesDeSalida opciones;
+    std::string motivo = extraerOpcionesDeSalida(argumentos, opciones);
+    if (!motivo.empty()) {
+        errores << "Opción inválida: " << motivo << "\n";
+        return 1;
+    }
+    consultaCompuesta consulta;
+    if (comando == "--buscar") {
+        campoDeBusqueda campo;
+        if (argumentos.size() != 4 || !interpretarCampo(argumentos[2], campo)) {
+            errores << "Uso: --buscar <archivo> <nombre|tipo|valor|tolerancia|voltaje|estado> <valor> [opciones de salida]\n";
+            return 1;
+        }
+        motivo = consultaDeBusqueda(argumentos[2], argumentos[3], consulta);
+    } else {
+        if (argumentos.size() < 3) {
+            errores << "Uso: --consultar <archivo> <criterio> [y|o <criterio>]... [opciones de salida]\n";
+            return 1;
         }
+        std::string texto;
+        for (size_t i = 2; i < argumentos.size(); i++) texto += argumentos[i] + " ";
+        motivo = interpretarConsulta(texto, consulta);
+    }
+    if (!motivo.empty()) {
+        errores << "Consulta inválida: " << motivo << "\n";
+        return 1;
+    }
 
-        if (eleccion >= 1 && eleccion <= 6) break;
-        std::cout << "Opción fuera de rango. Ingresa un número entre 1 y 6.\n";
-        std::cin.ignore(10000, '\n');
+    const bool humano = opciones.formato == formatoDeSalida::humano;
+    if (esRegistroParticionado(argumentos[1])) {
+        salidaDeResultados salida(opciones.formato, opciones.limite, opciones.desplazamiento);
+        salida.redirigir(salidaEstandar, humano ? salidaEstandar : errores);
+        consultarParticionado(argumentos[1], consulta, salida);
+        mostrarTotalDeResultados(salida, opciones.desplazamiento);
+        return 0;
     }
-    return eleccion;
+    registroResidente* residente = ponerAlDiaResidente(servidor, argumentos[1], humano ? salidaEstandar : errores);
+    if (!residente) return 1;
+    auto guardada = residente->respuestas.find(clave);
+    if (guardada != residente->respuestas.end()) {
+        salidaEstandar << guardada->second.salidaEstandar;
+        errores << guardada->second.errores;
+        return 0;
+    }
+
+    std::ostringstream datos, mensajes;
+    {
+        salidaDeResultados salida(opciones.formato, opciones.limite, opciones.desplazamiento);
+        salida.redirigir(datos, humano ? datos : mensajes);
+        ejecutarConsulta(residente->cache, nullptr, consulta, salida);
+        mostrarTotalDeResultados(salida, opciones.desplazamiento);
+    }
+    respuestaGuardada respuesta{datos.str(), mensajes.str()};
+    salidaEstandar << respuesta.salidaEstandar;
+    errores << respuesta.errores;
+    if (respuesta.salidaEstandar.size() + respuesta.errores.size() <= TAMANO_MAXIMO_DE_RESPUESTA_GUARDADA) {
+        if (residente->respuestas.size() >= RESPUESTAS_GUARDADAS_POR_REGISTRO) residente->respuestas.clear();
+        residente->respuestas.emplace(std::move(clave), std::move(respuesta));
+    }
+    return 0;
 }
 
+#if defined(SISTEMA_POSIX)
+volatile std::sig_atomic_t senalDeDetencion = 0; ///< La pone a 1 SIGINT o SIGTERM durante ejecutarServidor()
+
 /**
- * @brief Maneja el proceso completo de registro de componentes en archivos
- * 
- * @param registros Referencia al vector donde se almacenan temporalmente los componentes
- * @param nombreArchivo Referencia al string que almacenará el nombre del archivo
- * @param sobrescribir Flag que determina el modo de operación:
- *                     - true: Sobrescribe archivos existentes
- *                     - false: Añade a archivos existentes
+ * @brief Manejador de SIGINT y SIGTERM del servidor: pide terminar el bucle de poll()
+ */
+void registrarSenalDeDetencion(int){
+    senalDeDetencion = 1;
+}
+
+/**
+ * @brief Prepara la dirección de un socket de dominio Unix
  * 
- * @details
- * Esta función coordina el flujo completo de registro de componentes:
- * 1. Solicita el nombre del archivo (debe incluir .txt)
- * 2. Valida la existencia del archivo según el modo:
- *    - Modo sobrescritura: Pide confirmación si el archivo existe
- *    - Modo continuación: Verifica que el archivo exista
- * 3. Limpia el vector de registros temporal
- * 4. Ciclo de registro de componentes:
- *    - Usa registroDeComponentes() para capturar datos
- *    - Guarda usando guardarEnArchivo() o continuarConArchivo()
- *    - Permite registrar múltiples componentes
+ * @param rutaDelSocket Ruta del socket en el sistema de archivos
+ * @param direccion Salida: dirección para bind() o connect()
+ * @return false si la ruta no cabe en sun_path
+ */
+bool direccionDeSocket(const std::string& rutaDelSocket, sockaddr_un& direccion){
+    direccion = sockaddr_un();
+    direccion.sun_family = AF_UNIX;
+    if (rutaDelSocket.empty() || rutaDelSocket.size() >= sizeof(direccion.sun_path)) {
+        std::cout << "Ruta de socket inválida o demasiado larga: '" << rutaDelSocket << "'\n";
+        return false;
+    }
+    std::memcpy(direccion.sun_path, rutaDelSocket.c_str(), rutaDelSocket.size() + 1);
+    return true;
+}
+
+/**
+ * @brief Conecta con un socket de dominio Unix
  * 
- * @post El archivo especificado contendrá los componentes registrados
- * @post El vector 'registros' queda vacío al finalizar
- * @post Muestra mensajes de estado/error durante el proceso
+ * @return int Descriptor conectado, o -1 si no hay nadie escuchando
+ */
+int conectarASocket(const sockaddr_un& direccion){
+    int descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (descriptor < 0) return -1;
+    if (::connect(descriptor, reinterpret_cast<const sockaddr*>(&direccion), sizeof(direccion)) != 0) {
+        ::close(descriptor);
+        return -1;
+    }
+    return descriptor;
+}
+
+/**
+ * @brief Envía lo que el socket admita sin bloquear y lo quita del búfer de salida
  * 
- * @warning
- * - En modo sobrescritura, los datos existentes se perderán sin confirmación
- * - El nombre de archivo debe incluir la extensión .txt explícitamente
+ * @param descriptor Socket en modo O_NONBLOCK
+ * @param porEnviar Bytes pendientes del cliente; al volver contiene los que no cupieron
+ * @return false si el cliente cerró la conexión o write() falló
+ */
+bool enviarSinBloquear(int descriptor, std::string& porEnviar){
+    size_t enviados = 0;
+    while (enviados < porEnviar.size()) {
+        ssize_t escritos = ::write(descriptor, porEnviar.data() + enviados, porEnviar.size() - enviados);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        enviados += static_cast<size_t>(escritos);
+    }
+    porEnviar.erase(0, enviados);
+    return true;
+}
+#endif
+
+/**
+ * @brief Mantiene registros en memoria y responde peticiones por un socket de dominio Unix
  * 
- * @throw Ninguno (los errores se manejan con mensajes y retornos tempranos)
+ * @param rutaDelSocket Ruta donde se crea el socket (solo accesible para el usuario)
+ * @param nombresDeArchivo Registros que se cargan al arrancar; los demás se
+ *                         cargan la primera vez que se piden
+ * @return int Código de salida (0 al detenerse con --detener, SIGINT o SIGTERM)
  * 
- * @par Ejemplo 1 (Modo sobrescritura):
- * @code
- * vector<componente> reg;
- * string archivo;
- * iniciarRegistro(reg, archivo, true);
- * // Si archivo existe: pregunta antes de sobrescribir
- * // Si no existe: crea nuevo archivo
- * @endcode
+ * @details
+ * Cada ejecución de --buscar o --consultar vuelve a proyectar e interpretar
+ * el registro. El servidor lo interpreta una sola vez y lo conserva como
+ * registroResidente, de modo que una consulta nueva solo evalúa la tabla
+ * columnar residente y una repetida, mientras el archivo no cambie, devuelve
+ * la respuesta guardada.
+ * 
+ * Atiende a varios clientes con poll() en un único hilo: cada petición se
+ * resuelve completa (atenderPeticion()) antes de pasar a la siguiente, así que
+ * las cachés no necesitan sincronización. Los sockets de los clientes son
+ * O_NONBLOCK y cada uno tiene su búfer de salida: la respuesta se envía hasta
+ * donde el socket la admite y el resto espera a POLLOUT, de modo que un
+ * cliente que lee despacio no detiene a los demás. Mientras un cliente tiene
+ * respuesta pendiente no se leen más peticiones suyas. Los demás procesos pueden seguir
+ * escribiendo los registros; el servidor ve sus cambios en la siguiente
+ * petición.
+ * 
+ * Si ya existe un socket en esa ruta y alguien responde en él, no arranca; si
+ * nadie responde, lo considera abandonado y lo reemplaza.
+ * 
+ * Con --stats, las estadísticas de cada petición se muestran en su stderr
+ * (ver mostrarEstadisticas()); al cliente solo llega la respuesta.
  * 
- * @par Ejemplo 2 (Modo continuación):
- * @code
- * vector<componente> reg;
- * string archivo;
- * iniciarRegistro(reg, archivo, false);
- * // Si archivo no existe: muestra error y aborta
- * // Si existe: añade nuevos componentes al final
+ * @par Ejemplo de uso:
+ * @code{.sh}
+ * ./registroDeComponentes --servidor /tmp/componentes.sock inventario.txt &
+ * ./registroDeComponentes --cliente /tmp/componentes.sock --consultar inventario.txt tipo=Diodo --formato tsv
+ * ./registroDeComponentes --cliente /tmp/componentes.sock --detener
  * @endcode
  * 
- * @note
- * - Usa funciones auxiliares para operaciones específicas
- * - El ciclo continúa hasta que el usuario elija salir
- * - Siempre limpia el vector antes de comenzar
- * 
- * @see registroDeComponentes() Para el ingreso de datos
- * @see guardarEnArchivo() Para guardado en modo sobrescritura
- * @see continuarConArchivo() Para guardado en modo añadir
+ * @see ejecutarCliente()
+ * @see tipoDeTrama Para el protocolo
  */
-void iniciarRegistro(std::vector<componente>& registros, std::string& nombreArchivo, bool sobrescribir) {
-    std::cin.ignore();
-    std::cout << "Ingresa el nombre del archivo (agrega .txt al final): \n";
-    std::getline(std::cin, nombreArchivo);
+int ejecutarServidor(const std::string& rutaDelSocket, const std::vector<std::string>& nombresDeArchivo){
+#if defined(SISTEMA_POSIX)
+    sockaddr_un direccion;
+    if (!direccionDeSocket(rutaDelSocket, direccion)) return 1;
+    int existente = conectarASocket(direccion);
+    if (existente >= 0) {
+        ::close(existente);
+        std::cout << "Ya hay un servidor escuchando en '" << rutaDelSocket << "'.\n";
+        return 1;
+    }
+    ::unlink(rutaDelSocket.c_str());
 
-    std::ifstream test(nombreArchivo);
-    if (sobrescribir && test.is_open()) {
-        int seleccion{0};
-        std::cout << "El archivo ya existe y será sobrescrito\n";
-        std::cout << "¿Continuar?\nSi(1) No(2)\n";
-        std::cin >> seleccion;
-        std::cin.ignore();
-        if (seleccion != 1) return;
+    servidorDeConsultas servidor;
+    for (const std::string& nombreArchivo : nombresDeArchivo)
+    {
+        if (!ponerAlDiaResidente(servidor, nombreArchivo, std::cout)) return 1;
     }
 
-    if (!sobrescribir && !test.is_open()) {
-        std::cout << "El archivo no existe. No se puede continuar\n";
-        return;
+    int escucha = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (escucha < 0 || ::bind(escucha, reinterpret_cast<const sockaddr*>(&direccion), sizeof(direccion)) != 0
+        || ::chmod(rutaDelSocket.c_str(), 0600) != 0 || ::listen(escucha, 16) != 0) {
+        std::cout << "No se pudo escuchar en '" << rutaDelSocket << "': " << std::strerror(errno) << "\n";
+        if (escucha >= 0) ::close(escucha);
+        return 1;
     }
+    senalDeDetencion = 0;
+    std::signal(SIGINT, registrarSenalDeDetencion);
+    std::signal(SIGTERM, registrarSenalDeDetencion);
+    std::signal(SIGPIPE, SIG_IGN);
+    std::cout << "Servidor escuchando en '" << rutaDelSocket << "' con " << servidor.registros.size()
+              << " registros residentes. Detenerlo con --cliente " << rutaDelSocket << " --detener.\n";
+    std::cout.flush();
 
-    registros.clear();
-    int continuar = 1;
-    while (continuar == 1) {
-        registroDeComponentes(registros);
-        if (sobrescribir) {
-            guardarEnArchivo(registros.back(), nombreArchivo);
+    std::vector<pollfd> descriptores{{escucha, POLLIN, 0}};
+    std::vector<std::string> pendientes{""}; ///< Bytes recibidos de cada cliente (paralelo a 'descriptores')
+    std::vector<std::string> porEnviar{""}; ///< Respuestas que el socket de cada cliente aún no admitió
+    while (!servidor.detener && !senalDeDetencion) {
+        if (::poll(descriptores.data(), descriptores.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            std::cout << "Error en poll(): " << std::strerror(errno) << "\n";
+            break;
+        }
+        if (descriptores[0].revents & POLLIN) {
+            int cliente = ::accept(escucha, nullptr, nullptr);
+            if (cliente >= 0 && ::fcntl(cliente, F_SETFL, ::fcntl(cliente, F_GETFL) | O_NONBLOCK) == 0) {
+                descriptores.push_back({cliente, POLLIN, 0});
+                pendientes.emplace_back();
+                porEnviar.emplace_back();
+            } else if (cliente >= 0) {
+                ::close(cliente);
+            }
+        }
+        for (size_t i = 1; i < descriptores.size() && !servidor.detener; i++)
+        {
+            if (descriptores[i].revents == 0) continue;
+            bool cerrar = true;
+            char bloque[4096];
+            ssize_t leidos = 0;
+            if (descriptores[i].events & POLLOUT) {
+                cerrar = !enviarSinBloquear(descriptores[i].fd, porEnviar[i]);
+            } else if ((leidos = ::read(descriptores[i].fd, bloque, sizeof(bloque))) > 0) {
+                cerrar = false;
+                pendientes[i].append(bloque, static_cast<size_t>(leidos));
+                tipoDeTrama tipo;
+                std::string carga;
+                while (!cerrar && extraerTrama(pendientes[i], tipo, carga)) {
+                    if (tipo != tipoDeTrama::peticion) {
+                        cerrar = true;
+                        break;
+                    }
+                    std::vector<std::string> argumentos;
+                    for (size_t inicio = 0; inicio < carga.size();)
+                    {
+                        size_t fin = carga.find('\0', inicio);
+                        if (fin == std::string::npos) fin = carga.size();
+                        argumentos.emplace_back(carga, inicio, fin - inicio);
+                        inicio = fin + 1;
+                    }
+                    std::ostringstream salidaEstandar, errores;
+                    const std::string operacion = argumentos.empty() ? std::string("petición vacía") : argumentos[0];
+                    if (estadisticasActivas) iniciarEstadisticas();
+                    auto inicio = std::chrono::steady_clock::now();
+                    const int codigo = atenderPeticion(servidor, std::move(argumentos), salidaEstandar, errores);
+                    servidor.segundosAtendiendo += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+                    servidor.peticiones++;
+                    if (estadisticasActivas) mostrarEstadisticas(std::cerr, operacion);
+
+                    std::string respuesta;
+                    if (!salidaEstandar.str().empty()) respuesta += codificarTrama(tipoDeTrama::salida, salidaEstandar.str());
+                    if (!errores.str().empty()) respuesta += codificarTrama(tipoDeTrama::errores, errores.str());
+                    respuesta += codificarTrama(tipoDeTrama::fin, std::string(1, static_cast<char>(codigo)));
+                    porEnviar[i] += respuesta;
+                }
+                if (pendientes[i].size() > CARGA_MAXIMA_DE_PETICION + 5) cerrar = true;
+                if (!cerrar) cerrar = !enviarSinBloquear(descriptores[i].fd, porEnviar[i]);
+            } else if (leidos < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) {
+                cerrar = false;
+            }
+            if (cerrar) {
+                ::close(descriptores[i].fd);
+                descriptores.erase(descriptores.begin() + static_cast<std::ptrdiff_t>(i));
+                pendientes.erase(pendientes.begin() + static_cast<std::ptrdiff_t>(i));
+                porEnviar.erase(porEnviar.begin() + static_cast<std::ptrdiff_t>(i));
+                i--;
+            } else {
+                descriptores[i].events = porEnviar[i].empty() ? POLLIN : POLLOUT;
+            }
+        }
+    }
+
+    for (const pollfd& descriptor : descriptores) ::close(descriptor.fd);
+    ::unlink(rutaDelSocket.c_str());
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    std::cout << "Servidor detenido tras " << servidor.peticiones << " peticiones.\n";
+    return 0;
+#else
+    (void)rutaDelSocket;
+    (void)nombresDeArchivo;
+    std::cout << "El servidor necesita sockets de dominio Unix, que no están disponibles en este sistema.\n";
+    return 1;
+#endif
+}
+
+/**
+ * @brief Envía una petición a un servidor de ejecutarServidor() y muestra su respuesta
+ * 
+ * @param rutaDelSocket Ruta del socket del servidor
+ * @param argumentos Petición, con la misma sintaxis que la línea de comandos
+ *                   (ver atenderPeticion())
+ * @return int Código de salida que devolvió el servidor, o 1 si no se pudo conectar
+ * 
+ * @details El registro (segundo argumento de --buscar, --consultar y
+ * --agregar) se envía como ruta absoluta, porque el servidor la resolvería
+ * desde su propio directorio de trabajo. Escribe cada trama de la respuesta
+ * en la salida estándar o en la de errores según su tipo, en el orden en que
+ * llegan.
+ */
+int ejecutarCliente(const std::string& rutaDelSocket, const std::vector<std::string>& argumentos){
+#if defined(SISTEMA_POSIX)
+    sockaddr_un direccion;
+    if (!direccionDeSocket(rutaDelSocket, direccion)) return 1;
+    int descriptor = conectarASocket(direccion);
+    if (descriptor < 0) {
+        std::cout << "No hay ningún servidor escuchando en '" << rutaDelSocket << "'. Inícialo con --servidor.\n";
+        return 1;
+    }
+    std::vector<std::string> peticion = argumentos;
+    if (peticion.size() >= 2 && (peticion[0] == "--buscar" || peticion[0] == "--consultar" || peticion[0] == "--agregar")) {
+        std::error_code error;
+        const std::filesystem::path absoluta = std::filesystem::absolute(peticion[1], error);
+        if (!error) peticion[1] = absoluta.lexically_normal().string();
+    }
+    std::string carga;
+    for (size_t i = 0; i < peticion.size(); i++)
+    {
+        if (i > 0) carga += '\0';
+        carga += peticion[i];
+    }
+    if (carga.size() > CARGA_MAXIMA_DE_PETICION || !escribirCompleto(descriptor, codificarTrama(tipoDeTrama::peticion, carga))) {
+        std::cout << "No se pudo enviar la petición al servidor.\n";
+        ::close(descriptor);
+        return 1;
+    }
+
+    std::string pendiente;
+    char bloque[64 * 1024];
+    while (true) {
+        tipoDeTrama tipo;
+        std::string contenido;
+        while (extraerTrama(pendiente, tipo, contenido)) {
+            if (tipo == tipoDeTrama::fin) {
+                ::close(descriptor);
+                return contenido.empty() ? 1 : static_cast<unsigned char>(contenido[0]);
+            }
+            escribirCompleto(tipo == tipoDeTrama::errores ? STDERR_FILENO : STDOUT_FILENO, contenido);
+        }
+        ssize_t leidos = ::read(descriptor, bloque, sizeof(bloque));
+        if (leidos < 0 && errno == EINTR) continue;
+        if (leidos <= 0) break;
+        pendiente.append(bloque, static_cast<size_t>(leidos));
+    }
+    ::close(descriptor);
+    std::cout << "El servidor cerró la conexión sin terminar la respuesta.\n";
+    return 1;
+#else
+    (void)rutaDelSocket;
+    (void)argumentos;
+    std::cout << "El cliente necesita sockets de dominio Unix, que no están disponibles en este sistema.\n";
+    return 1;
+#endif
+}
+
+/**
+ * @brief Ejecuta una operación no interactiva indicada por línea de comandos
+ * 
+ * @param argumentos Argumentos del programa sin el nombre del ejecutable
+ * @return int Código de salida (0 en éxito, 1 si la opción es inválida)
+ * 
+ * @see mostrarAyuda() Para la lista de opciones
+ */
+int ejecutarLineaDeComandos(std::vector<std::string> argumentos){
+    const std::string comando = argumentos[0];
+    if (comando == "--comparar-cargadores") {
+        uint64_t cantidad = 10000000;
+        std::string nombreArchivo = "comparacion_cargadores.txt";
+        try {
+            if (argumentos.size() > 1) cantidad = std::stoull(argumentos[1]);
+        } catch (const std::exception&) {
+            std::cout << "Cantidad inválida: " << argumentos[1] << "\n";
+            return 1;
+        }
+        if (argumentos.size() > 2) nombreArchivo = argumentos[2];
+        compararCargadores(cantidad, nombreArchivo);
+        return 0;
+    }
+    if (comando == "--comparar-filtros") {
+        uint64_t cantidad = 1000000;
+        std::string nombreArchivo = "comparacion_filtros.txt";
+        try {
+            if (argumentos.size() > 1) cantidad = std::stoull(argumentos[1]);
+        } catch (const std::exception&) {
+            std::cout << "Cantidad inválida: " << argumentos[1] << "\n";
+            return 1;
+        }
+        if (argumentos.size() > 2) nombreArchivo = argumentos[2];
+        compararFiltros(cantidad, nombreArchivo);
+        return 0;
+    }
+    if (comando == "--comparar-asignaciones") {
+        uint64_t cantidad = 1000000;
+        std::string nombreArchivo = "comparacion_asignaciones.txt";
+        try {
+            if (argumentos.size() > 1) cantidad = std::stoull(argumentos[1]);
+        } catch (const std::exception&) {
+            std::cout << "Cantidad inválida: " << argumentos[1] << "\n";
+            return 1;
+        }
+        if (argumentos.size() > 2) nombreArchivo = argumentos[2];
+        compararAsignaciones(cantidad, nombreArchivo);
+        return 0;
+    }
+    if (comando == "--comparar-escritura") {
+        uint64_t cantidad = 100000;
+        std::string nombreArchivo = "comparacion_escritura.txt";
+        try {
+            if (argumentos.size() > 1) cantidad = std::stoull(argumentos[1]);
+        } catch (const std::exception&) {
+            std::cout << "Cantidad inválida: " << argumentos[1] << "\n";
+            return 1;
+        }
+        if (argumentos.size() > 2) nombreArchivo = argumentos[2];
+        compararEscritura(cantidad, nombreArchivo);
+        return 0;
+    }
+    if (comando == "--generar") {
+        uint64_t cantidad = 0;
+        uint64_t semilla = 1;
+        try {
+            if (argumentos.size() != 3 && argumentos.size() != 4) throw std::invalid_argument("");
+            cantidad = std::stoull(argumentos[2]);
+            if (argumentos.size() == 4) semilla = std::stoull(argumentos[3]);
+        } catch (const std::exception&) {
+            std::cout << "Uso: --generar <archivo> <cantidad> [semilla]\n";
+            return 1;
+        }
+        if (!generarRegistroRealista(argumentos[1], cantidad, semilla)) return 1;
+        std::cout << cantidad << " componentes generados en '" << argumentos[1] << "'.\n";
+        return 0;
+    }
+    if (comando == "--medir-rendimiento") {
+        std::vector<uint64_t> cantidades;
+        std::string lista = argumentos.size() > 1 ? argumentos[1] : "10000,1000000,10000000";
+        try {
+            for (size_t inicio = 0; inicio <= lista.size();)
+            {
+                size_t fin = std::min(lista.find(',', inicio), lista.size());
+                cantidades.push_back(std::stoull(lista.substr(inicio, fin - inicio)));
+                if (cantidades.back() == 0) throw std::invalid_argument("");
+                inicio = fin + 1;
+            }
+        } catch (const std::exception&) {
+            std::cout << "Cantidades inválidas: " << lista << " (ej: 10000,1000000)\n";
+            return 1;
+        }
+        medirRendimiento(cantidades, argumentos.size() > 2 ? argumentos[2] : ".");
+        return 0;
+    }
+    if (comando == "--agregar") {
+        if (argumentos.size() != 8) {
+            std::cout << "Uso: --agregar <registro> <nombre> <tipo> <valor> <tolerancia> <voltaje> <estado>\n";
+            return 1;
+        }
+        return agregarComponente(argumentos[1], std::vector<std::string>(argumentos.begin() + 2, argumentos.end()), std::cout);
+    }
+    if (comando == "--particionar") {
+        if (argumentos.size() != 2 && argumentos.size() != 3) {
+            std::cout << "Uso: --particionar <directorio> [registro]\n";
+            return 1;
+        }
+        return particionarRegistro(argumentos[1], argumentos.size() == 3 ? argumentos[2] : "") ? 0 : 1;
+    }
+    if (comando == "--servidor") {
+        if (argumentos.size() < 2) {
+            std::cout << "Uso: --servidor <socket> [registro]...\n";
+            return 1;
+        }
+        return ejecutarServidor(argumentos[1], std::vector<std::string>(argumentos.begin() + 2, argumentos.end()));
+    }
+    if (comando == "--cliente") {
+        if (argumentos.size() < 3) {
+            std::cout << "Uso: --cliente <socket> <petición> [argumentos]...\n";
+            return 1;
+        }
+        return ejecutarCliente(argumentos[1], std::vector<std::string>(argumentos.begin() + 2, argumentos.end()));
+    }
+    if (comando == "--importar") {
+        if (argumentos.size() != 3) {
+            std::cout << "Uso: --importar <origen.csv|origen.tsv|-> <registro>\n";
+            return 1;
+        }
+        return importarComponentes(argumentos[1], argumentos[2]) ? 0 : 1;
+    }
+    opcionesDeSalida opciones;
+    if (comando == "--buscar" || comando == "--consultar" || comando == "--parecidos") {
+        std::string motivo = extraerOpcionesDeSalida(argumentos, opciones);
+        if (!motivo.empty()) {
+            std::cout << "Opción inválida: " << motivo << "\n";
+            return 1;
+        }
+    }
+    if (comando == "--buscar") {
+        campoDeBusqueda campo;
+        if (argumentos.size() != 4 || !interpretarCampo(argumentos[2], campo)) {
+            std::cout << "Uso: --buscar <archivo|-> <nombre|tipo|valor|tolerancia|voltaje|estado> <valor> [opciones de salida]\n";
+            return 1;
+        }
+        consultaCompuesta consulta;
+        std::string motivo = consultaDeBusqueda(argumentos[2], argumentos[3], consulta);
+        if (!motivo.empty()) {
+            std::cout << "Valor inválido: " << motivo << "\n";
+            return 1;
+        }
+        salidaDeResultados salida(opciones.formato, opciones.limite, opciones.desplazamiento);
+        if (esRegistroParticionado(argumentos[1])) {
+            consultarParticionado(argumentos[1], consulta, salida);
         } else {
-            continuarConArchivo(registros.back(), nombreArchivo);
+            buscarEnArchivoSinCargar(argumentos[1], consulta.predicados.front(), salida);
         }
-        std::cout << "Componente guardado correctamente.\n";
-        std::cout << "¿Deseas ingresar otro componente? (1 = Sí, 2 = No): ";
-        std::cin >> continuar;
-        std::cin.ignore();
+        mostrarTotalDeResultados(salida, opciones.desplazamiento);
+        return 0;
     }
-    std::cout << "Archivo guardado correctamente.\n";
+    if (comando == "--consultar") {
+        if (argumentos.size() < 3) {
+            std::cout << "Uso: --consultar <archivo> <criterio> [y|o <criterio>]... [opciones de salida]\n";
+            return 1;
+        }
+        std::string texto;
+        for (size_t i = 2; i < argumentos.size(); i++) texto += argumentos[i] + " ";
+        consultaCompuesta consulta;
+        std::string motivo = interpretarConsulta(texto, consulta);
+        if (!motivo.empty()) {
+            std::cout << "Consulta inválida: " << motivo << "\n";
+            return 1;
+        }
+        if (esRegistroParticionado(argumentos[1])) {
+            salidaDeResultados salida(opciones.formato, opciones.limite, opciones.desplazamiento);
+            consultarParticionado(argumentos[1], consulta, salida);
+            mostrarTotalDeResultados(salida, opciones.desplazamiento);
+            return 0;
+        }
+        registroMapeado mapa(argumentos[1]);
+        if (!mapa.abierto()) return 1;
+        cacheDeBusqueda cache;
+        salidaDeResultados salida(opciones.formato, opciones.limite, opciones.desplazamiento);
+        const bool proyectado = mapa.tamano() >= UMBRAL_MAPEO;
+        if (!proyectado) actualizarCacheDeBusqueda(cache, argumentos[1], salida.avisos());
+        ejecutarConsulta(cache, proyectado ? &mapa : nullptr, consulta, salida);
+        mostrarTotalDeResultados(salida, opciones.desplazamiento);
+        return 0;
+    }
+    if (comando == "--parecidos") {
+        unsigned long long distancia = 0;
+        if (argumentos.size() == 4) {
+            try {
+                distancia = std::stoull(argumentos[3]);
+            } catch (...) {
+                argumentos.clear();
+            }
+        }
+        if (argumentos.size() != 3 && argumentos.size() != 4) {
+            std::cout << "Uso: --parecidos <archivo|directorio> <texto> [distancia máxima] [opciones de salida]\n";
+            return 1;
+        }
+        const std::string& texto = argumentos[2];
+        if (texto.empty() || texto.size() > LARGO_MAXIMO_APROXIMADO) {
+            std::cout << "El texto debe tener entre 1 y " << LARGO_MAXIMO_APROXIMADO << " bytes.\n";
+            return 1;
+        }
+        if (argumentos.size() == 3) distancia = distanciaAproximadaPorDefecto(texto.size());
+        distancia = std::min<unsigned long long>(distancia, LARGO_MAXIMO_APROXIMADO);
+        salidaDeResultados salida(opciones.formato, opciones.limite, opciones.desplazamiento);
+        const uint64_t cantidad = opciones.limite == salidaDeResultados::SIN_LIMITE
+            ? opciones.desplazamiento + CANTIDAD_DE_PARECIDOS : salida.restantes();
+
+        // Las vistas apuntan a las proyecciones, que deben seguir abiertas hasta mostrarlas
+        std::vector<std::unique_ptr<registroMapeado>> proyecciones;
+        if (esRegistroParticionado(argumentos[1])) {
+            std::vector<segmentoDeTipo> segmentos;
+            if (!leerManifiesto(argumentos[1], segmentos)) {
+                std::cout << "El manifiesto de '" << argumentos[1] << "' no es válido.\n";
+                return 1;
+            }
+            for (const segmentoDeTipo& segmento : segmentos) {
+                proyecciones.push_back(std::make_unique<registroMapeado>(segmento.archivo));
+            }
+        } else {
+            proyecciones.push_back(std::make_unique<registroMapeado>(argumentos[1]));
+            if (!proyecciones.back()->abierto()) return 1;
+        }
+        seleccionDeParecidos<vistaComponente> seleccion(texto, static_cast<unsigned>(distancia), cantidad);
+        for (const auto& proyeccion : proyecciones) buscarNombresParecidos(*proyeccion, seleccion);
+        const auto parecidos = seleccion.resultados();
+        mostrarNombresParecidos(parecidos, salida);
+        salida.avisos() << (parecidos.size() > opciones.desplazamiento ? parecidos.size() - opciones.desplazamiento : 0)
+                        << " componentes con el nombre a distancia " << distancia << " o menos de \"" << texto << "\".\n";
+        return 0;
+    }
+    if (comando == "--eliminar" || comando == "--modificar") {
+        const bool eliminar = comando == "--eliminar";
+        if (argumentos.size() != (eliminar ? 3u : 5u)) {
+            std::cout << (eliminar ? "Uso: --eliminar <registro> <nombre>\n" : "Uso: --modificar <registro> <nombre> <campo> <valor>\n");
+            return 1;
+        }
+        campoDeBusqueda campo{};
+        if (!eliminar && !interpretarCampo(argumentos[3], campo)) {
+            std::cout << "Campo desconocido: " << argumentos[3] << "\n";
+            return 1;
+        }
+        const std::vector<componenteUbicado> encontrados = localizarPorNombre(argumentos[1], argumentos[2]);
+        if (encontrados.empty()) {
+            std::cout << "No se encontró ningún componente con ese nombre.\n";
+            return 1;
+        }
+        if (eliminar) {
+            if (!editarComponentes(argumentos[1], encontrados, {})) return 1;
+            std::cout << encontrados.size() << " componentes eliminados.\n";
+            return 0;
+        }
+        std::vector<componente> nuevos;
+        for (const componenteUbicado& c : encontrados) {
+            componente& nuevo = nuevos.emplace_back(c.datos);
+            const std::string motivo = asignarCampo(nuevo, campo, argumentos[4]);
+            if (!motivo.empty()) {
+                std::cout << "Valor rechazado: " << motivo << "\n";
+                return 1;
+            }
+        }
+        if (!editarComponentes(argumentos[1], encontrados, nuevos)) return 1;
+        std::cout << encontrados.size() << " componentes modificados.\n";
+        return 0;
+    }
+    if (comando == "--compactar") {
+        if (argumentos.size() != 2) {
+            std::cout << "Uso: --compactar <registro>\n";
+            return 1;
+        }
+        return compactarRegistro(argumentos[1]) ? 0 : 1;
+    }
+    if (comando == "--reindexar") {
+        if (argumentos.size() != 2) {
+            std::cout << "Uso: --reindexar <archivo>\n";
+            return 1;
+        }
+        indiceSecundario indice;
+        if (!reconstruirIndiceSecundario(argumentos[1], indice)) return 1;
+        std::cout << "Índice '" << rutaDeIndice(argumentos[1]) << "' reconstruido: " << indice.porTipo.size()
+                  << " tipos y " << indice.porEstado.size() << " estados distintos.\n";
+        indiceDeTrigramas trigramas;
+        if (!reconstruirIndiceDeTrigramas(argumentos[1], trigramas)) return 1;
+        std::cout << "Índice '" << rutaDeTrigramas(argumentos[1]) << "' reconstruido: " << trigramas.listas.size()
+                  << " trigramas distintos.\n";
+        return 0;
+    }
+    if (comando == "--ayuda" || comando == "-h") {
+        mostrarAyuda();
+        return 0;
+    }
+    std::cout << "Opción desconocida: " << comando << "\n";
+    mostrarAyuda();
+    return 1;
 }
 
 /**
  * @brief Punto de entrada principal del sistema de gestión de componentes electrónicos
  * 
+ * @param argc Número de argumentos de línea de comandos
+ * @param argv Argumentos; si hay alguno se ejecuta ejecutarLineaDeComandos() en lugar del menú.
+ *             --stats (o --estadisticas) se quita de ellos en cualquier posición y
+ *             activa las estadísticas de la operación (ver mostrarEstadisticas())
  * @return int Código de salida del programa (0 para terminación exitosa)
  * 
  * @details
@@ -1259,8 +10064,11 @@ void iniciarRegistro(std::vector<componente>& registros, std::string& nombreArch
  * - (2) Continuar registro (añade a archivo existente)
  * - (3) Visualización de archivos existentes
  * - (4) Vaciar contenido de archivos
- * - (5) Búsqueda multicriterio de componentes
- * - (6) Salida del sistema
+ * - (5) Búsqueda multicriterio de componentes (texto o binario)
+ * - (6) Conversión entre formato de texto y binario
+ * - (7) Borrado o modificación de un componente (lápidas y compactación)
+ * - (8) Activar o desactivar las estadísticas (ver mostrarEstadisticas())
+ * - (9) Salida del sistema
  * 
  * @note
  * - Todos los nombres de archivo deben incluir explícitamente la extensión .txt
@@ -1276,7 +10084,10 @@ void iniciarRegistro(std::vector<componente>& registros, std::string& nombreArch
  * (3) Ver registros de un archivo existente
  * (4) Eliminar el contenido de un archivo
  * (5) Buscar un componente en un archivo
- * (6) Salir
+ * (6) Convertir un archivo entre texto y binario
+ * (7) Eliminar o modificar un componente
+ * (8) Activar o desactivar las estadísticas
+ * (9) Salir
  * ============================
  * > 1
  * Ingresa el nombre del archivo...
@@ -1286,15 +10097,35 @@ void iniciarRegistro(std::vector<componente>& registros, std::string& nombreArch
  * @see iniciarRegistro() Para las operaciones de registro
  * @see mostrarArchivoExistente() Para visualización de archivos
  * @see eliminarContenidoArchivo() Para vaciado de archivos
- * @see buscarPorParametro() Para el subsistema de búsqueda
+ * @see buscarEnArchivo() Para el subsistema de búsqueda
+ * @see editarComponente() Para borrar o modificar componentes
+ * @see ejecutarLineaDeComandos() Para las operaciones no interactivas
  */
-int main(){
+int main(int argc, char* argv[]){
+    std::vector<std::string> argumentos;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argumento = argv[i];
+        if (argumento == "--stats" || argumento == "--estadisticas") estadisticasActivas = true;
+        else argumentos.push_back(argumento);
+    }
+    if (!argumentos.empty()) {
+        if (estadisticasActivas) iniciarEstadisticas();
+        const int codigo = ejecutarLineaDeComandos(argumentos);
+        // El servidor ya las muestra por petición (ver ejecutarServidor())
+        if (estadisticasActivas && argumentos[0] != "--servidor") mostrarEstadisticas(std::cerr, argumentos[0]);
+        return codigo;
+    }
+
     std::vector<componente> registros;
+    cacheDeBusqueda busquedas;
     std::string nombreArchivo;
     while (true)
     {
         int eleccion = eleccionMenuprincipal();
         int continuar{1};
+        const bool medir = estadisticasActivas && eleccion >= 1 && eleccion <= 7;
+        if (medir) iniciarEstadisticas();
         switch (eleccion)
         {
         case 1: {
@@ -1319,22 +10150,29 @@ int main(){
             break;
         case 5:
             std::cin.ignore();
-            int opcion;
             std::cout<<"Ingresa el nombre del archivo con en el que deseas buscar tu componente (agrega .txt al final): \n";
             std::getline(std::cin, nombreArchivo);
-            cargarDesdeArchivo(registros, nombreArchivo);
-            menuParametro();
-            std::cin>>opcion;
-            std::cin.ignore();
-            buscarPorParametro(opcion, registros);
+            buscarEnArchivo(busquedas, nombreArchivo);
             break;
         case 6:
+            convertirFormato();
+            break;
+        case 7:
+            editarComponente();
+            break;
+        case 8:
+            estadisticasActivas = !estadisticasActivas;
+            std::cout << (estadisticasActivas ? "Estadísticas activadas: se mostrarán al terminar cada operación.\n"
+                                              : "Estadísticas desactivadas.\n");
+            break;
+        case 9:
             std::cout<<"Vuelva pronto \n";
             return 0;
         default:
             std::cout<<"Error, opción no válida. \n";
             break;
         }
+        if (medir) mostrarEstadisticas(std::cerr, "opción " + std::to_string(eleccion));
     }
     return 0;
 }
\ No newline at end of file